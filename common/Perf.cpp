@@ -11,7 +11,10 @@
 #endif
 
 #include <array>
+#include <atomic>
 #include <cstring>
+#include <map>
+#include <mutex>
 
 #ifdef __linux__
 #include <atomic>
@@ -178,38 +181,121 @@ namespace Perf
 #endif
 
 #if (defined(__linux__) && (defined(ProfileWithPerf) || defined(ProfileWithPerfJitDump))) || defined(ENABLE_VTUNE)
+#define HAS_REGISTER_METHOD 1
+#else
+#define HAS_REGISTER_METHOD 0
+#endif
+
+	struct CodeMapEntry
+	{
+		uptr end;
+		const Group* group;
+		u32 pc;
+		bool has_pc;
+		std::string symbol;
+	};
+
+	static std::atomic_bool s_code_map_enabled{false};
+	static std::mutex s_code_map_mutex;
+	static std::map<uptr, CodeMapEntry> s_code_map;
+
+	static void AddToCodeMap(const void* ptr, size_t size, const Group* group, u32 pc, bool has_pc, std::string symbol)
+	{
+		if (size == 0)
+			return;
+
+		const uptr start = reinterpret_cast<uptr>(ptr);
+		const uptr end = start + size;
+
+		std::unique_lock lock(s_code_map_mutex);
+
+		// Code caches get reused after flushes, so drop anything the new code overlaps.
+		auto it = s_code_map.upper_bound(start);
+		if (it != s_code_map.begin() && std::prev(it)->second.end > start)
+			--it;
+		while (it != s_code_map.end() && it->first < end)
+			it = s_code_map.erase(it);
+
+		s_code_map.emplace(start, CodeMapEntry{end, group, pc, has_pc, std::move(symbol)});
+	}
+
+	void SetCodeMapEnabled(bool enabled)
+	{
+		std::unique_lock lock(s_code_map_mutex);
+		s_code_map_enabled.store(enabled, std::memory_order_release);
+		if (!enabled)
+			s_code_map.clear();
+	}
+
+	bool LookupCode(const void* ptr, CodeInfo* info)
+	{
+		const uptr addr = reinterpret_cast<uptr>(ptr);
+
+		std::unique_lock lock(s_code_map_mutex);
+		auto it = s_code_map.upper_bound(addr);
+		if (it == s_code_map.begin())
+			return false;
+
+		--it;
+		if (addr >= it->second.end)
+			return false;
+
+		info->group = it->second.group;
+		info->start = reinterpret_cast<const void*>(it->first);
+		info->size = static_cast<size_t>(it->second.end - it->first);
+		info->pc = it->second.pc;
+		info->has_pc = it->second.has_pc;
+		info->symbol = it->second.symbol;
+		return true;
+	}
+
 	void Group::Register(const void* ptr, size_t size, const char* symbol)
 	{
+		if (s_code_map_enabled.load(std::memory_order_acquire))
+			AddToCodeMap(ptr, size, this, 0, false, symbol);
+
+#if HAS_REGISTER_METHOD
 		char full_symbol[128];
 		if (HasPrefix())
 			std::snprintf(full_symbol, std::size(full_symbol), "%s_%s", m_prefix, symbol);
 		else
 			StringUtil::Strlcpy(full_symbol, symbol, std::size(full_symbol));
 		RegisterMethod(ptr, size, full_symbol);
+#endif
 	}
 
 	void Group::RegisterPC(const void* ptr, size_t size, u32 pc)
 	{
+		if (s_code_map_enabled.load(std::memory_order_acquire))
+			AddToCodeMap(ptr, size, this, pc, true, std::string());
+
+#if HAS_REGISTER_METHOD
 		char full_symbol[128];
 		if (HasPrefix())
 			std::snprintf(full_symbol, std::size(full_symbol), "%s_%08X", m_prefix, pc);
 		else
 			std::snprintf(full_symbol, std::size(full_symbol), "%08X", pc);
 		RegisterMethod(ptr, size, full_symbol);
+#endif
 	}
 
 	void Group::RegisterKey(const void* ptr, size_t size, const char* prefix, u64 key)
 	{
+		const bool code_map = s_code_map_enabled.load(std::memory_order_acquire);
+		if (!code_map && !HAS_REGISTER_METHOD)
+			return;
+
 		char full_symbol[128];
 		if (HasPrefix())
 			std::snprintf(full_symbol, std::size(full_symbol), "%s_%s%016" PRIX64, m_prefix, prefix, key);
 		else
 			std::snprintf(full_symbol, std::size(full_symbol), "%s%016" PRIX64, prefix, key);
+
+		if (code_map)
+			AddToCodeMap(ptr, size, this, 0, false, full_symbol);
+
+#if HAS_REGISTER_METHOD
 		RegisterMethod(ptr, size, full_symbol);
-	}
-#else
-	void Group::Register(const void* ptr, size_t size, const char* symbol) {}
-	void Group::RegisterPC(const void* ptr, size_t size, u32 pc) {}
-	void Group::RegisterKey(const void* ptr, size_t size, const char* prefix, u64 key) {}
 #endif
+	}
 } // namespace Perf
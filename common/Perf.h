@@ -5,6 +5,7 @@
 
 #include <vector>
 #include <cstdio>
+#include <string>
 #include "common/Pcsx2Types.h"
 
 namespace Perf
@@ -16,6 +17,7 @@ namespace Perf
 	public:
 		constexpr Group(const char* prefix) : m_prefix(prefix) {}
 		bool HasPrefix() const { return (m_prefix && m_prefix[0]); }
+		const char* GetPrefix() const { return m_prefix; }
 
 		void Register(const void* ptr, size_t size, const char* symbol);
 		void RegisterPC(const void* ptr, size_t size, u32 pc);
@@ -28,4 +30,22 @@ namespace Perf
 	extern Group vu0;
 	extern Group vu1;
 	extern Group vif;
+
+	/// Host code registered through a group, as recorded in the in-process code map.
+	struct CodeInfo
+	{
+		const Group* group;
+		const void* start;
+		size_t size;
+		u32 pc; // guest PC, only valid if has_pc is set
+		bool has_pc;
+		std::string symbol; // for Register()/RegisterKey() entries
+	};
+
+	/// Starts or stops recording registrations into the in-process code map, used by the sampling
+	/// profiler to attribute host addresses to guest blocks. Disabling clears the map.
+	void SetCodeMapEnabled(bool enabled);
+
+	/// Looks up the registration covering the specified host address.
+	bool LookupCode(const void* ptr, CodeInfo* info);
 } // namespace Perf
@@ -1,9 +1,11 @@
 // SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
 // SPDX-License-Identifier: GPL-3.0+
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <csignal>
+#include <limits>
 #include <cstdlib>
 #include <condition_variable>
 #include <mutex>
@@ -25,6 +27,7 @@
 #include "common/ProgressCallback.h"
 #include "common/SettingsWrapper.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 
 #include "pcsx2/PrecompiledHeader.h"
 
@@ -48,6 +51,14 @@
 
 #include "svnrev.h"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
 // Down here because X11 has a lot of defines that can conflict
 #if defined(__linux__)
 #include <X11/Xlib.h>
@@ -63,6 +74,12 @@ namespace GSRunner
 	static void SettingsOverride();
 	static bool ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& params);
 	static void DumpStats();
+	static void WriteStatsFile();
+
+	static int RunBatch(int argc, char* argv[]);
+	static std::vector<std::string> GetBatchDumpList();
+	static std::optional<int> RunWorkerProcess(const std::vector<std::string>& args, bool* crashed);
+	static bool WriteBatchReport(const std::string& path);
 
 	static bool CreatePlatformWindow();
 	static void DestroyPlatformWindow();
@@ -78,9 +95,18 @@ static MemorySettingsInterface s_settings_interface;
 
 static std::string s_output_prefix;
 static s32 s_loop_count = 1;
+static u32 s_frame_range_start = 0;
+static u32 s_frame_range_end = std::numeric_limits<u32>::max();
 static std::optional<bool> s_use_window;
 static bool s_no_console = false;
 
+// Batch mode, replays a list of dumps in worker processes and aggregates their statistics.
+static std::string s_batch_source;
+static std::string s_batch_report;
+static std::string s_batch_dumpdir;
+static u32 s_batch_jobs = 0;
+static std::string s_stats_file;
+
 // Owned by the GS thread.
 static u32 s_dump_frame_number = 0;
 static u32 s_loop_number = s_loop_count;
@@ -267,8 +293,39 @@ void Host::ReleaseRenderWindow()
 {
 }
 
+static void UpdatePerfStats(bool count)
+{
+	static constexpr auto update_stat = [](GSPerfMon::counter_t counter, u64& dst, double& last, bool count) {
+		// perfmon resets every 30 frames to zero
+		const double val = g_perfmon.GetCounter(counter);
+		if (count)
+			dst += static_cast<u64>((val < last) ? val : (val - last));
+		last = val;
+	};
+
+	update_stat(GSPerfMon::Draw, s_total_internal_draws, s_last_internal_draws, count);
+	update_stat(GSPerfMon::DrawCalls, s_total_draws, s_last_draws, count);
+	update_stat(GSPerfMon::RenderPasses, s_total_render_passes, s_last_render_passes, count);
+	update_stat(GSPerfMon::Barriers, s_total_barriers, s_last_barriers, count);
+	update_stat(GSPerfMon::TextureCopies, s_total_copies, s_last_copies, count);
+	update_stat(GSPerfMon::TextureUploads, s_total_uploads, s_last_uploads, count);
+	update_stat(GSPerfMon::Readbacks, s_total_readbacks, s_last_readbacks, count);
+	update_stat(GSPerfMon::DepthCopiesROV, s_total_depth_copies_rov, s_last_depth_copies_rov, count);
+	update_stat(GSPerfMon::DrawCallsROV, s_total_draws_rov, s_last_draws_rov, count);
+	update_stat(GSPerfMon::BarriersROV, s_total_barriers_rov, s_last_barriers_rov, count);
+}
+
 void Host::BeginPresentFrame()
 {
+	// frames before the requested range are only replayed to reach it, but keep the counter baselines
+	// moving so their work isn't counted against the first frame in range
+	if (s_dump_frame_number < s_frame_range_start)
+	{
+		if (GSIsHardwareRenderer())
+			UpdatePerfStats(false);
+		return;
+	}
+
 	if (s_loop_number == 0 && !s_output_prefix.empty())
 	{
 		// when we wrap around, don't race other files
@@ -284,23 +341,7 @@ void Host::BeginPresentFrame()
 		const u32 last_draws = s_total_internal_draws;
 		const u32 last_uploads = s_total_uploads;
 
-		static constexpr auto update_stat = [](GSPerfMon::counter_t counter, u64& dst, double& last) {
-			// perfmon resets every 30 frames to zero
-			const double val = g_perfmon.GetCounter(counter);
-			dst += static_cast<u64>((val < last) ? val : (val - last));
-			last = val;
-		};
-
-		update_stat(GSPerfMon::Draw, s_total_internal_draws, s_last_internal_draws);
-		update_stat(GSPerfMon::DrawCalls, s_total_draws, s_last_draws);
-		update_stat(GSPerfMon::RenderPasses, s_total_render_passes, s_last_render_passes);
-		update_stat(GSPerfMon::Barriers, s_total_barriers, s_last_barriers);
-		update_stat(GSPerfMon::TextureCopies, s_total_copies, s_last_copies);
-		update_stat(GSPerfMon::TextureUploads, s_total_uploads, s_last_uploads);
-		update_stat(GSPerfMon::Readbacks, s_total_readbacks, s_last_readbacks);
-		update_stat(GSPerfMon::DepthCopiesROV, s_total_depth_copies_rov, s_last_depth_copies_rov);
-		update_stat(GSPerfMon::DrawCallsROV, s_total_draws_rov, s_last_draws_rov);
-		update_stat(GSPerfMon::BarriersROV, s_total_barriers_rov, s_last_barriers_rov);
+		UpdatePerfStats(true);
 
 		const bool idle_frame = s_total_frames && (last_draws == s_total_internal_draws && last_uploads == s_total_uploads);
 
@@ -480,6 +521,16 @@ const char* InputManager::ConvertHostKeyboardCodeToIcon(u32 code)
 BEGIN_HOTKEY_LIST(g_host_hotkeys)
 END_HOTKEY_LIST()
 
+static std::string_view GetDumpTitle(std::string_view path)
+{
+	// strip off all extensions
+	std::string_view title(Path::GetFileTitle(path));
+	if (StringUtil::EndsWithNoCase(title, ".gs"))
+		title = Path::GetFileTitle(title);
+
+	return StringUtil::StripWhitespace(title);
+}
+
 static void PrintCommandLineVersion()
 {
 	std::fprintf(stderr, "PCSX2 GS Runner Version %s\n", GIT_REV);
@@ -504,6 +555,8 @@ static void PrintCommandLineHelp(const char* progname)
 		"and only those frames that are multiples of BF (intersection of -dumprange and -dumprangef used).\n"
 		"Defaults to 0,-1,1 (all frames). Only used if -dump is used.\n");
 	std::fprintf(stderr, "  -loop <count>: Loops dump playback N times. Defaults to 1. 0 will loop infinitely.\n");
+	std::fprintf(stderr, "  -frames <start>[-<end>]: Only replays frames start to end (inclusive). An index is cached "
+		"next to the dump so later runs can skip ahead.\n");
 	std::fprintf(stderr, "  -renderer <renderer>: Sets the graphics renderer. Defaults to Auto.\n");
 	std::fprintf(stderr, "  -swthreads <threads>: Sets the number of threads for the software renderer.\n");
 	std::fprintf(stderr, "  -window: Forces a window to be displayed.\n");
@@ -511,6 +564,11 @@ static void PrintCommandLineHelp(const char* progname)
 	std::fprintf(stderr, "  -logfile <filename>: Writes emu log to filename.\n");
 	std::fprintf(stderr, "  -noshadercache: Disables the shader cache (useful for parallel runs).\n");
 	std::fprintf(stderr, "  -perf: Enable frame timing performance stats.\n");
+	std::fprintf(stderr, "  -batch <dir|manifest>: Replays every dump in a directory, or listed in a manifest (one path\n"
+						 "    per line), each in its own worker process. -dumpdir becomes the root for per-dump directories.\n");
+	std::fprintf(stderr, "  -jobs <count>: Number of worker processes used in batch mode. Defaults to the CPU count.\n");
+	std::fprintf(stderr, "  -report <filename>: Writes batch results to filename, as CSV if it ends in .csv, otherwise JSON.\n");
+	std::fprintf(stderr, "  -statsfile <filename>: Writes the hardware statistics of the run to filename.\n");
 	std::fprintf(stderr, "  --: Signals that no more arguments will follow and the remaining\n"
 						 "    parameters make up the filename. Use when the filename contains\n"
 						 "    spaces or starts with a dash.\n");
@@ -528,6 +586,7 @@ void GSRunner::InitializeConsole()
 bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& params)
 {
 	std::string dumpdir; // Save from argument -dumpdir for creating sub-directories
+	bool has_logfile = false;
 	bool no_more_args = false;
 	for (int i = 1; i < argc; i++)
 	{
@@ -657,6 +716,25 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 				Console.WriteLn("Looping dump playback %d times.", s_loop_count);
 				continue;
 			}
+			else if (CHECK_ARG_PARAM("-frames"))
+			{
+				const std::string_view str(argv[++i]);
+				const std::string_view::size_type sep = str.find('-');
+				const std::optional<u32> start = StringUtil::FromChars<u32>(str.substr(0, sep));
+				const std::optional<u32> end = (sep == std::string_view::npos) ?
+					std::optional<u32>(std::numeric_limits<u32>::max()) :
+					StringUtil::FromChars<u32>(str.substr(sep + 1));
+				if (!start.has_value() || !end.has_value() || end.value() < start.value())
+				{
+					Console.Error("Invalid frame range: %s", argv[i]);
+					return false;
+				}
+
+				s_frame_range_start = start.value();
+				s_frame_range_end = end.value();
+				Console.WriteLn("Replaying frames %u to %u.", s_frame_range_start, s_frame_range_end);
+				continue;
+			}
 			else if (CHECK_ARG_PARAM("-renderer"))
 			{
 				const char* rname = argv[++i];
@@ -775,6 +853,7 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 					VMManager::Internal::SetFileLogPath(logfile);
 					s_settings_interface.SetBoolValue("Logging", "EnableFileLogging", true);
 					s_settings_interface.SetBoolValue("Logging", "EnableTimestamps", false);
+					has_logfile = true;
 				}
 
 				continue;
@@ -803,6 +882,26 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 				s_perf_enable = true;
 				continue;
 			}
+			else if (CHECK_ARG_PARAM("-batch"))
+			{
+				s_batch_source = StringUtil::StripWhitespace(argv[++i]);
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-jobs"))
+			{
+				s_batch_jobs = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-report"))
+			{
+				s_batch_report = StringUtil::StripWhitespace(argv[++i]);
+				continue;
+			}
+			else if (CHECK_ARG_PARAM("-statsfile"))
+			{
+				s_stats_file = StringUtil::StripWhitespace(argv[++i]);
+				continue;
+			}
 			else if (CHECK_ARG("-debugdevice"))
 			{
 				Console.WriteLn("Enable debug device");
@@ -829,6 +928,24 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 		params.filename += argv[i];
 	}
 
+	if (!s_batch_source.empty())
+	{
+		if (!params.filename.empty())
+		{
+			Console.Error("A dump filename can't be used together with -batch.");
+			return false;
+		}
+
+		if (has_logfile)
+		{
+			Console.Error("-logfile can't be used with -batch, each dump logs to its dump directory instead.");
+			return false;
+		}
+
+		s_batch_dumpdir = std::move(dumpdir);
+		return true;
+	}
+
 	if (params.filename.empty())
 	{
 		Console.Error("No dump filename provided.");
@@ -856,12 +973,7 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 	// set up the frame dump directory
 	if (!s_output_prefix.empty())
 	{
-		// strip off all extensions
-		std::string_view title(Path::GetFileTitle(params.filename));
-		if (StringUtil::EndsWithNoCase(title, ".gs"))
-			title = Path::GetFileTitle(title);
-
-		s_output_prefix = Path::Combine(s_output_prefix, StringUtil::StripWhitespace(title));
+		s_output_prefix = Path::Combine(s_output_prefix, GetDumpTitle(params.filename));
 		Console.WriteLn(fmt::format("Saving dumps as {}_frameN.png", s_output_prefix));
 	}
 
@@ -935,6 +1047,421 @@ void GSRunner::DumpStats()
 	Console.WriteLn("============================================");
 }
 
+static constexpr std::array<const char*, 12> s_stat_names = {{"frames", "drawn_frames", "internal_draws", "draws",
+	"render_passes", "barriers", "copies", "uploads", "readbacks", "depth_copies_rov", "draws_rov", "barriers_rov"}};
+using StatValues = std::array<u64, s_stat_names.size()>;
+
+static StatValues GetStatValues()
+{
+	return {{s_total_frames, s_total_drawn_frames, s_total_internal_draws, s_total_draws, s_total_render_passes,
+		s_total_barriers, s_total_copies, s_total_uploads, s_total_readbacks, s_total_depth_copies_rov,
+		s_total_draws_rov, s_total_barriers_rov}};
+}
+
+void GSRunner::WriteStatsFile()
+{
+	std::atomic_thread_fence(std::memory_order_acquire);
+
+	const StatValues values = GetStatValues();
+	std::string contents;
+	for (size_t i = 0; i < values.size(); i++)
+		fmt::format_to(std::back_inserter(contents), "{}={}\n", s_stat_names[i], values[i]);
+
+	if (!FileSystem::WriteStringToFile(s_stats_file.c_str(), contents))
+		Console.ErrorFmt("Failed to write statistics to {}.", s_stats_file);
+}
+
+static bool ReadStatsFile(const std::string& path, StatValues* values)
+{
+	const std::optional<std::string> contents = FileSystem::ReadFileToString(path.c_str());
+	if (!contents.has_value())
+		return false;
+
+	for (const std::string_view line : StringUtil::SplitString(contents.value(), '\n'))
+	{
+		const std::string_view::size_type pos = line.find('=');
+		if (pos == std::string_view::npos)
+			continue;
+
+		const std::string_view key = line.substr(0, pos);
+		for (size_t i = 0; i < s_stat_names.size(); i++)
+		{
+			if (key == s_stat_names[i])
+				(*values)[i] = StringUtil::FromChars<u64>(line.substr(pos + 1)).value_or(0);
+		}
+	}
+
+	return true;
+}
+
+namespace
+{
+	struct BatchResult
+	{
+		std::string path;
+		std::optional<int> exit_code;
+		bool crashed = false;
+		bool has_stats = false;
+		double seconds = 0.0;
+		StatValues stats = {};
+	};
+} // namespace
+
+static std::vector<BatchResult> s_batch_results;
+
+static const char* GetBatchResultStatus(const BatchResult& result)
+{
+	if (result.crashed)
+		return "crashed";
+	else if (!result.exit_code.has_value())
+		return "not started";
+	else if (result.exit_code.value() != EXIT_SUCCESS || !result.has_stats)
+		return "failed";
+	else
+		return "ok";
+}
+
+std::vector<std::string> GSRunner::GetBatchDumpList()
+{
+	std::vector<std::string> dumps;
+	if (FileSystem::DirectoryExists(s_batch_source.c_str()))
+	{
+		FileSystem::FindResultsArray files;
+		FileSystem::FindFiles(s_batch_source.c_str(), "*", FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_SORT_BY_NAME, &files);
+		for (FILESYSTEM_FIND_DATA& fd : files)
+		{
+			if (VMManager::IsGSDumpFileName(fd.FileName))
+				dumps.push_back(std::move(fd.FileName));
+		}
+	}
+	else
+	{
+		// Manifest, one dump per line, relative to the manifest's directory.
+		const std::optional<std::string> manifest = FileSystem::ReadFileToString(s_batch_source.c_str());
+		if (!manifest.has_value())
+		{
+			Console.ErrorFmt("Failed to read batch manifest {}.", s_batch_source);
+			return dumps;
+		}
+
+		for (std::string_view line : StringUtil::SplitString(manifest.value(), '\n'))
+		{
+			line = StringUtil::StripWhitespace(line);
+			if (line.empty() || line[0] == '#')
+				continue;
+
+			std::string path = Path::IsAbsolute(line) ? std::string(line) : Path::Combine(Path::GetDirectory(s_batch_source), line);
+			if (!VMManager::IsGSDumpFileName(path))
+			{
+				Console.WarningFmt("Skipping {}, not a GS dump.", path);
+				continue;
+			}
+
+			dumps.push_back(std::move(path));
+		}
+	}
+
+	return dumps;
+}
+
+std::optional<int> GSRunner::RunWorkerProcess(const std::vector<std::string>& args, bool* crashed)
+{
+#ifdef _WIN32
+	// Quote every argument, following the rules CommandLineToArgvW() uses to split them again.
+	std::wstring cmdline;
+	for (const std::string& arg : args)
+	{
+		if (!cmdline.empty())
+			cmdline += L' ';
+
+		cmdline += L'"';
+		size_t backslashes = 0;
+		for (const wchar_t ch : StringUtil::UTF8StringToWideString(arg))
+		{
+			if (ch == L'\\')
+			{
+				backslashes++;
+				continue;
+			}
+
+			cmdline.append((ch == L'"') ? (backslashes * 2 + 1) : backslashes, L'\\');
+			cmdline += ch;
+			backslashes = 0;
+		}
+		cmdline.append(backslashes * 2, L'\\');
+		cmdline += L'"';
+	}
+
+	STARTUPINFOW si = {};
+	si.cb = sizeof(si);
+	PROCESS_INFORMATION pi = {};
+	if (!CreateProcessW(nullptr, cmdline.data(), nullptr, nullptr, FALSE, CREATE_NO_WINDOW, nullptr, nullptr, &si, &pi))
+	{
+		Console.ErrorFmt("CreateProcessW() failed: {}", GetLastError());
+		return std::nullopt;
+	}
+
+	WaitForSingleObject(pi.hProcess, INFINITE);
+
+	DWORD exit_code = EXIT_FAILURE;
+	GetExitCodeProcess(pi.hProcess, &exit_code);
+	CloseHandle(pi.hThread);
+	CloseHandle(pi.hProcess);
+
+	// Unhandled exceptions terminate the process with an NTSTATUS error code.
+	if ((exit_code & 0xC0000000u) == 0xC0000000u)
+	{
+		*crashed = true;
+		return std::nullopt;
+	}
+
+	return static_cast<int>(exit_code);
+#else
+	std::vector<char*> argv;
+	argv.reserve(args.size() + 1);
+	for (const std::string& arg : args)
+		argv.push_back(const_cast<char*>(arg.c_str()));
+	argv.push_back(nullptr);
+
+	// Workers log to their dump directory, keep their console output out of ours.
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+	posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+	posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+	pid_t pid;
+	const int res = posix_spawn(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+	posix_spawn_file_actions_destroy(&actions);
+	if (res != 0)
+	{
+		Console.ErrorFmt("posix_spawn() failed: {}", res);
+		return std::nullopt;
+	}
+
+	int status;
+	while (waitpid(pid, &status, 0) < 0)
+	{
+		if (errno != EINTR)
+			return std::nullopt;
+	}
+
+	if (WIFSIGNALED(status))
+	{
+		*crashed = true;
+		return std::nullopt;
+	}
+
+	return WEXITSTATUS(status);
+#endif
+}
+
+static std::string EscapeJSONString(std::string_view str)
+{
+	std::string ret;
+	ret.reserve(str.size());
+	for (const char ch : str)
+	{
+		if (ch == '"' || ch == '\\')
+			ret += '\\';
+		else if (static_cast<unsigned char>(ch) < 0x20)
+		{
+			fmt::format_to(std::back_inserter(ret), "\\u{:04x}", static_cast<unsigned>(ch));
+			continue;
+		}
+
+		ret += ch;
+	}
+
+	return ret;
+}
+
+bool GSRunner::WriteBatchReport(const std::string& path)
+{
+	StatValues totals = {};
+	u32 num_ok = 0;
+	u32 num_failed = 0;
+	u32 num_crashed = 0;
+	for (const BatchResult& result : s_batch_results)
+	{
+		for (size_t i = 0; i < totals.size(); i++)
+			totals[i] += result.stats[i];
+
+		num_crashed += result.crashed;
+		num_ok += (std::strcmp(GetBatchResultStatus(result), "ok") == 0);
+	}
+	num_failed = static_cast<u32>(s_batch_results.size()) - num_ok - num_crashed;
+
+	Console.WriteLnFmt("@BATCH@ {} dumps, {} ok, {} failed, {} crashed", s_batch_results.size(), num_ok, num_failed, num_crashed);
+	for (size_t i = 0; i < totals.size(); i++)
+		Console.WriteLnFmt("@BATCH@ Total {}: {}", s_stat_names[i], totals[i]);
+
+	const bool all_ok = (num_ok == s_batch_results.size());
+	if (path.empty())
+		return all_ok;
+
+	std::string report;
+	if (StringUtil::EndsWithNoCase(path, ".csv"))
+	{
+		report += "name,status,exit_code,seconds";
+		for (const char* name : s_stat_names)
+			fmt::format_to(std::back_inserter(report), ",{}", name);
+		report += '\n';
+
+		for (const BatchResult& result : s_batch_results)
+		{
+			std::string name(Path::GetFileName(result.path));
+			StringUtil::ReplaceAll(&name, "\"", "\"\"");
+			fmt::format_to(std::back_inserter(report), "\"{}\",{},{},{:.3f}", name, GetBatchResultStatus(result),
+				result.exit_code.value_or(-1), result.seconds);
+			for (const u64 value : result.stats)
+				fmt::format_to(std::back_inserter(report), ",{}", value);
+			report += '\n';
+		}
+
+		fmt::format_to(std::back_inserter(report), "\"TOTAL\",{}/{},,", num_ok, s_batch_results.size());
+		for (const u64 value : totals)
+			fmt::format_to(std::back_inserter(report), ",{}", value);
+		report += '\n';
+	}
+	else
+	{
+		report += "{\n\t\"dumps\": [\n";
+		for (size_t i = 0; i < s_batch_results.size(); i++)
+		{
+			const BatchResult& result = s_batch_results[i];
+			fmt::format_to(std::back_inserter(report), "\t\t{{\"name\": \"{}\", \"status\": \"{}\", \"exit_code\": {}, \"seconds\": {:.3f}",
+				EscapeJSONString(Path::GetFileName(result.path)), GetBatchResultStatus(result),
+				result.exit_code.value_or(-1), result.seconds);
+			for (size_t j = 0; j < result.stats.size(); j++)
+				fmt::format_to(std::back_inserter(report), ", \"{}\": {}", s_stat_names[j], result.stats[j]);
+			report += (i == (s_batch_results.size() - 1)) ? "}\n" : "},\n";
+		}
+
+		fmt::format_to(std::back_inserter(report), "\t],\n\t\"totals\": {{\"dumps\": {}, \"ok\": {}, \"failed\": {}, \"crashed\": {}",
+			s_batch_results.size(), num_ok, num_failed, num_crashed);
+		for (size_t i = 0; i < totals.size(); i++)
+			fmt::format_to(std::back_inserter(report), ", \"{}\": {}", s_stat_names[i], totals[i]);
+		report += "}\n}\n";
+	}
+
+	if (!FileSystem::WriteStringToFile(path.c_str(), report))
+	{
+		Console.ErrorFmt("Failed to write batch report to {}.", path);
+		return false;
+	}
+
+	Console.WriteLnFmt("Wrote batch report to {}.", path);
+	return all_ok;
+}
+
+int GSRunner::RunBatch(int argc, char* argv[])
+{
+	const std::vector<std::string> dumps = GetBatchDumpList();
+	if (dumps.empty())
+	{
+		Console.ErrorFmt("No GS dumps found in {}.", s_batch_source);
+		return EXIT_FAILURE;
+	}
+
+	// Workers get the same settings as us, minus the parameters we rewrite per dump.
+	std::vector<std::string> base_args;
+	base_args.push_back(FileSystem::GetProgramPath());
+	bool has_noshadercache = false;
+	for (int i = 1; i < argc; i++)
+	{
+		if (!std::strcmp(argv[i], "--"))
+			break;
+
+		static constexpr const char* batch_params[] = {"-batch", "-jobs", "-report", "-statsfile", "-dumpdir", "-logfile"};
+		if (std::any_of(std::begin(batch_params), std::end(batch_params), [arg = argv[i]](const char* param) {
+				return !std::strcmp(arg, param);
+			}))
+		{
+			i++;
+			continue;
+		}
+
+		has_noshadercache |= !std::strcmp(argv[i], "-noshadercache");
+		base_args.emplace_back(argv[i]);
+	}
+
+	const u32 num_jobs = std::clamp<u32>((s_batch_jobs > 0) ? s_batch_jobs : std::thread::hardware_concurrency(),
+		1, static_cast<u32>(dumps.size()));
+
+	// disable shader cache for parallel runs, otherwise it'll have sharing violations
+	if (num_jobs > 1 && !has_noshadercache)
+		base_args.emplace_back("-noshadercache");
+
+	// run surfaceless, we don't want tons of windows popping up
+	if (!s_use_window.has_value())
+		base_args.emplace_back("-surfaceless");
+
+	// disable output console entirely
+#ifdef _WIN32
+	SetEnvironmentVariableW(L"PCSX2_NOCONSOLE", L"1");
+#else
+	setenv("PCSX2_NOCONSOLE", "1", 1);
+#endif
+
+	Console.WriteLnFmt("Replaying {} dumps with {} worker processes.", dumps.size(), num_jobs);
+
+	Common::Timer timer;
+	s_batch_results.resize(dumps.size());
+	std::atomic<size_t> next_dump{0};
+	std::atomic<size_t> completed_dumps{0};
+	std::vector<std::thread> workers;
+	workers.reserve(num_jobs);
+	for (u32 i = 0; i < num_jobs; i++)
+	{
+		workers.emplace_back([&dumps, &base_args, &next_dump, &completed_dumps]() {
+			for (;;)
+			{
+				const size_t index = next_dump.fetch_add(1, std::memory_order_relaxed);
+				if (index >= dumps.size())
+					break;
+
+				BatchResult& result = s_batch_results[index];
+				result.path = dumps[index];
+
+				std::vector<std::string> args = base_args;
+				std::string stats_path;
+				if (!s_batch_dumpdir.empty())
+				{
+					const std::string dir = Path::Combine(s_batch_dumpdir, GetDumpTitle(result.path));
+					if (!FileSystem::DirectoryExists(dir.c_str()))
+						FileSystem::CreateDirectoryPath(dir.c_str(), false);
+
+					args.insert(args.end(), {"-dumpdir", dir, "-logfile", Path::Combine(dir, "emulog.txt")});
+					stats_path = Path::Combine(dir, "stats.txt");
+				}
+				else
+				{
+					stats_path = Path::Combine(EmuFolders::Cache, fmt::format("gsrunner_stats_{}.txt", index));
+				}
+
+				args.insert(args.end(), {"-statsfile", stats_path, "--", result.path});
+
+				Common::Timer dump_timer;
+				result.exit_code = RunWorkerProcess(args, &result.crashed);
+				result.seconds = dump_timer.GetTimeSeconds();
+				result.has_stats = ReadStatsFile(stats_path, &result.stats);
+				if (s_batch_dumpdir.empty())
+					FileSystem::DeleteFilePath(stats_path.c_str());
+
+				Console.WriteLnFmt("[{}/{}] {}: {} ({:.2f}s)", completed_dumps.fetch_add(1, std::memory_order_relaxed) + 1,
+					dumps.size(), Path::GetFileName(result.path), GetBatchResultStatus(result), result.seconds);
+			}
+		});
+	}
+
+	for (std::thread& worker : workers)
+		worker.join();
+
+	Console.WriteLnFmt("Batch completed in {:.2f} seconds.", timer.GetTimeSeconds());
+	return WriteBatchReport(s_batch_report) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 #ifdef _WIN32
 // We can't handle unicode in filenames if we don't use wmain on Win32.
 #define main real_main
@@ -954,6 +1481,8 @@ static void CPUThreadMain(VMBootParameters* params, std::atomic<int>* ret)
 		{
 			// run until end
 			GSDumpReplayer::SetLoopCount(s_loop_count);
+			if (s_frame_range_start > 0 || s_frame_range_end != std::numeric_limits<u32>::max())
+				GSDumpReplayer::SetFrameRange(s_frame_range_start, s_frame_range_end);
 			VMManager::SetState(VMState::Running);
 			if (s_perf_enable)
 			{
@@ -964,6 +1493,8 @@ static void CPUThreadMain(VMBootParameters* params, std::atomic<int>* ret)
 				VMManager::Execute();
 			VMManager::Shutdown(false);
 			GSRunner::DumpStats();
+			if (!s_stats_file.empty())
+				GSRunner::WriteStatsFile();
 			ret->store(EXIT_SUCCESS);
 		}
 	}
@@ -987,6 +1518,10 @@ int main(int argc, char* argv[])
 	if (!GSRunner::ParseCommandLineArgs(argc, argv, params))
 		return EXIT_FAILURE;
 
+	// Batch mode fans the dumps out to worker processes, and never starts a VM itself.
+	if (!s_batch_source.empty())
+		return GSRunner::RunBatch(argc, argv);
+
 	if (s_use_window.value_or(true) && !GSRunner::CreatePlatformWindow())
 	{
 		Console.Error("Failed to create window.");
@@ -3,14 +3,56 @@
 
 #include "CDVD/CDVDcommon.h"
 #include "CDVD/IsoHasher.h"
+#include "Config.h"
 #include "Host.h"
 
+#include "common/Console.h"
 #include "common/Error.h"
-#include "common/MD5Digest.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+#include "common/Threading.h"
 
 #include "fmt/format.h"
 
 #include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <type_traits>
+
+namespace
+{
+	struct CheckpointHeader
+	{
+		u32 signature;
+		u32 version;
+		u64 image_size;
+		u64 image_mtime;
+		u32 path_length;
+		u32 num_tracks;
+		u32 track_index; // tracks before this one are complete, and their hashes follow the path
+		u32 sectors_done;
+		MD5Digest md5;
+	};
+} // namespace
+
+static constexpr u32 CHECKPOINT_SIGNATURE = 0x4B484349; // ICHK
+static constexpr u32 CHECKPOINT_VERSION = 1;
+static constexpr u32 HASH_STRING_LENGTH = 32;
+
+// Sectors are read in batches, which are hashed on another thread while the next batch is read.
+static constexpr u32 BATCH_SECTORS = 256;
+static constexpr u32 NUM_BATCHES = 4;
+
+// How often a checkpoint is written while hashing, 64MB for DVDs.
+static constexpr u32 CHECKPOINT_INTERVAL_SECTORS = 32768;
+
+static_assert(std::is_trivially_copyable_v<MD5Digest>);
+
+static std::string GetCheckpointFilename()
+{
+	return Path::Combine(EmuFolders::Cache, "isohasher.checkpoint");
+}
 
 IsoHasher::IsoHasher() = default;
 
@@ -38,6 +80,14 @@ bool IsoHasher::Open(std::string iso_path, Error* error)
 {
 	Close();
 
+	FILESYSTEM_STAT_DATA sd;
+	if (FileSystem::StatFile(iso_path.c_str(), &sd))
+	{
+		m_image_size = static_cast<u64>(sd.Size);
+		m_image_mtime = static_cast<u64>(sd.ModificationTime);
+	}
+	m_path = iso_path;
+
 	m_is_locked = cdvdLock(error);
 	if (!m_is_locked)
 		return false;
@@ -101,6 +151,7 @@ bool IsoHasher::Open(std::string iso_path, Error* error)
 		m_tracks.push_back(std::move(strack));
 	}
 
+	LoadCheckpoint();
 	return true;
 }
 
@@ -117,6 +168,8 @@ void IsoHasher::Close()
 
 	DoCDVDclose();
 	m_tracks.clear();
+	m_path.clear();
+	m_resume_sectors = 0;
 	m_is_cd = false;
 	m_is_open = false;
 }
@@ -137,50 +190,141 @@ void IsoHasher::ComputeHashes(ProgressCallback* callback)
 		}
 
 		callback->PushState();
-		const bool result = ComputeTrackHash(track, callback);
+		const bool result = ComputeTrackHash(index, callback);
 		callback->PopState();
 
 		if (!result)
-			break;
+			return;
+
+		if ((index + 1) < GetTrackCount())
+			SaveCheckpoint(index + 1, 0, MD5Digest());
 
 		callback->SetProgressValue(index + 1);
 		callback->IncrementProgressValue();
 	}
 
+	DeleteCheckpoint();
 	callback->SetProgressValue(GetTrackCount());
 }
 
-bool IsoHasher::ComputeTrackHash(Track& track, ProgressCallback* callback)
+bool IsoHasher::ComputeTrackHash(u32 index, ProgressCallback* callback)
 {
+	Track& track = m_tracks[index];
+
 	// use 2048 byte reads for DVDs, otherwise 2352 raw.
 	const int read_mode = m_is_cd ? CDVD_MODE_2352 : CDVD_MODE_2048;
 	const u32 sector_size = m_is_cd ? 2352 : 2048;
-	std::vector<u8> sector_buffer(sector_size);
 
-	const u32 update_interval = std::max<u32>(track.sectors / 100u, 1u);
 	callback->SetStatusText(
 		fmt::format(TRANSLATE_FS("CDVD", "Calculating checksum for track {}..."), track.number).c_str());
 	callback->SetProgressRange(track.sectors);
 
 	MD5Digest md5;
-	for (u32 i = 0; i < track.sectors; i++)
+	u32 start_sector = 0;
+	if (m_resume_sectors > 0 && m_resume_track == index && m_resume_sectors < track.sectors)
+	{
+		Console.WriteLn(fmt::format("(IsoHasher) Resuming track {} at sector {}", track.number, m_resume_sectors));
+		md5 = m_resume_md5;
+		start_sector = m_resume_sectors;
+	}
+	m_resume_sectors = 0;
+
+	// Sectors are read through CDVD on this thread, with the file reader decompressing ahead of
+	// us on its own thread, while the MD5 for the previous batches is computed on the hash thread.
+	std::array<std::vector<u8>, NUM_BATCHES> batches;
+	std::array<u32, NUM_BATCHES> batch_sectors = {};
+	for (std::vector<u8>& batch : batches)
+		batch.resize(BATCH_SECTORS * sector_size);
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	u32 batches_read = 0;
+	u32 batches_hashed = 0;
+	bool reading_done = false;
+
+	Threading::Thread hash_thread;
+	hash_thread.Start([&]() {
+		Threading::SetNameOfCurrentThread("ISO Hasher");
+
+		u32 sectors_hashed = start_sector;
+		u32 last_checkpoint = start_sector;
+		std::unique_lock lock(mutex);
+		for (;;)
+		{
+			cv.wait(lock, [&]() { return (batches_hashed != batches_read || reading_done); });
+			if (batches_hashed == batches_read)
+				break;
+
+			const u32 slot = batches_hashed % NUM_BATCHES;
+			lock.unlock();
+
+			md5.Update(batches[slot].data(), batch_sectors[slot] * sector_size);
+			sectors_hashed += batch_sectors[slot];
+			if ((sectors_hashed - last_checkpoint) >= CHECKPOINT_INTERVAL_SECTORS && sectors_hashed < track.sectors)
+			{
+				SaveCheckpoint(index, sectors_hashed, md5);
+				last_checkpoint = sectors_hashed;
+			}
+
+			lock.lock();
+			batches_hashed++;
+			cv.notify_one();
+		}
+
+		// interrupted, keep what we have
+		if (sectors_hashed != last_checkpoint && sectors_hashed < track.sectors)
+			SaveCheckpoint(index, sectors_hashed, md5);
+	});
+
+	bool result = true;
+	for (u32 sector = start_sector; sector < track.sectors && result;)
 	{
 		if (callback->IsCancelled())
-			return false;
+		{
+			result = false;
+			break;
+		}
 
-		const u32 lsn = track.start_lsn + i;
-		if (DoCDVDreadSector(sector_buffer.data(), lsn, read_mode) != 0)
+		std::unique_lock lock(mutex);
+		cv.wait(lock, [&]() { return ((batches_read - batches_hashed) < NUM_BATCHES); });
+		const u32 slot = batches_read % NUM_BATCHES;
+		lock.unlock();
+
+		const u32 count = std::min(BATCH_SECTORS, track.sectors - sector);
+		for (u32 i = 0; i < count; i++)
 		{
-			callback->DisplayFormattedModalError("Read error at LSN %u", lsn);
-			return false;
+			const u32 lsn = track.start_lsn + sector + i;
+			if (DoCDVDreadSector(batches[slot].data() + i * sector_size, lsn, read_mode) != 0)
+			{
+				callback->DisplayFormattedModalError("Read error at LSN %u", lsn);
+				result = false;
+				break;
+			}
 		}
 
-		md5.Update(sector_buffer.data(), sector_size);
+		if (!result)
+			break;
 
-		if ((i % update_interval) == 0)
-			callback->SetProgressValue(i);
+		lock.lock();
+		batch_sectors[slot] = count;
+		batches_read++;
+		cv.notify_one();
+		lock.unlock();
+
+		sector += count;
+		callback->SetProgressValue(sector);
 	}
 
+	{
+		std::unique_lock lock(mutex);
+		reading_done = true;
+		cv.notify_one();
+	}
+	hash_thread.Join();
+
+	if (!result)
+		return false;
+
 	u8 digest[16];
 	md5.Final(digest);
 	track.hash =
@@ -191,3 +335,78 @@ bool IsoHasher::ComputeTrackHash(Track& track, ProgressCallback* callback)
 	callback->SetProgressValue(track.sectors);
 	return true;
 }
+
+void IsoHasher::LoadCheckpoint()
+{
+	auto fp = FileSystem::OpenManagedCFile(GetCheckpointFilename().c_str(), "rb");
+	if (!fp)
+		return;
+
+	CheckpointHeader header;
+	std::string path;
+	if (std::fread(&header, sizeof(header), 1, fp.get()) != 1 || header.signature != CHECKPOINT_SIGNATURE ||
+		header.version != CHECKPOINT_VERSION || header.image_size != m_image_size ||
+		header.image_mtime != m_image_mtime || header.path_length != m_path.size() ||
+		header.num_tracks != m_tracks.size() || header.track_index >= header.num_tracks)
+	{
+		return;
+	}
+
+	path.resize(header.path_length);
+	if (std::fread(path.data(), path.size(), 1, fp.get()) != 1 || path != m_path)
+		return;
+
+	std::vector<std::string> hashes(header.track_index);
+	for (std::string& hash : hashes)
+	{
+		hash.resize(HASH_STRING_LENGTH);
+		if (std::fread(hash.data(), hash.size(), 1, fp.get()) != 1)
+			return;
+	}
+
+	for (u32 i = 0; i < header.track_index; i++)
+		m_tracks[i].hash = std::move(hashes[i]);
+
+	m_resume_md5 = header.md5;
+	m_resume_track = header.track_index;
+	m_resume_sectors = header.sectors_done;
+
+	Console.WriteLn(fmt::format("(IsoHasher) Found checkpoint for '{}' at track {}", m_path, header.track_index));
+}
+
+void IsoHasher::SaveCheckpoint(u32 track_index, u32 sectors_done, const MD5Digest& md5)
+{
+	CheckpointHeader header = {};
+	header.signature = CHECKPOINT_SIGNATURE;
+	header.version = CHECKPOINT_VERSION;
+	header.image_size = m_image_size;
+	header.image_mtime = m_image_mtime;
+	header.path_length = static_cast<u32>(m_path.size());
+	header.num_tracks = static_cast<u32>(m_tracks.size());
+	header.track_index = track_index;
+	header.sectors_done = sectors_done;
+	header.md5 = md5;
+
+	Error error;
+	const std::string filename(GetCheckpointFilename());
+	auto fp = FileSystem::OpenManagedCFile(filename.c_str(), "wb", &error);
+	bool result = (fp && std::fwrite(&header, sizeof(header), 1, fp.get()) == 1 &&
+				   std::fwrite(m_path.data(), m_path.size(), 1, fp.get()) == 1);
+	for (u32 i = 0; i < track_index && result; i++)
+		result = (m_tracks[i].hash.size() == HASH_STRING_LENGTH &&
+				  std::fwrite(m_tracks[i].hash.data(), HASH_STRING_LENGTH, 1, fp.get()) == 1);
+
+	if (!result)
+	{
+		Console.Error(fmt::format("(IsoHasher) Failed to write checkpoint '{}': {}", filename, error.GetDescription()));
+		fp.reset();
+		FileSystem::DeleteFilePath(filename.c_str());
+	}
+}
+
+void IsoHasher::DeleteCheckpoint()
+{
+	const std::string filename(GetCheckpointFilename());
+	if (FileSystem::FileExists(filename.c_str()))
+		FileSystem::DeleteFilePath(filename.c_str());
+}
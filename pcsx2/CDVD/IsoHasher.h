@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "common/MD5Digest.h"
 #include "common/Pcsx2Defs.h"
 #include "common/ProgressCallback.h"
 
@@ -44,9 +45,23 @@ public:
 	void ComputeHashes(ProgressCallback* callback = ProgressCallback::NullProgressCallback);
 
 private:
-	bool ComputeTrackHash(Track& track, ProgressCallback* callback);
+	bool ComputeTrackHash(u32 index, ProgressCallback* callback);
+
+	// Interrupted verifications are checkpointed to the cache directory, and picked back up
+	// when the same image (path, size and modification time) is opened again.
+	void LoadCheckpoint();
+	void SaveCheckpoint(u32 track_index, u32 sectors_done, const MD5Digest& md5);
+	void DeleteCheckpoint();
 
 	std::vector<Track> m_tracks;
+	std::string m_path;
+	u64 m_image_size = 0;
+	u64 m_image_mtime = 0;
+
+	MD5Digest m_resume_md5;
+	u32 m_resume_track = 0;
+	u32 m_resume_sectors = 0;
+
 	bool m_is_locked = false;
 	bool m_is_open = false;
 	bool m_is_cd = false;
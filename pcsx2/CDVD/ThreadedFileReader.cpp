@@ -4,12 +4,14 @@
 #include "ThreadedFileReader.h"
 #include "Host.h"
 
+#include "common/Console.h"
 #include "common/Error.h"
 #include "common/HostSys.h"
 #include "common/Path.h"
 #include "common/ProgressCallback.h"
 #include "common/SmallString.h"
 #include "common/Threading.h"
+#include "common/Timer.h"
 
 #include <cstring>
 
@@ -114,13 +116,13 @@ void ThreadedFileReader::Loop()
 					if (buf->offset + bufsize != chunk.offset || chunk.length + bufsize > buf->cap)
 					{
 						buffersFilled++;
-						if (buffersFilled >= 2)
+						if (buffersFilled >= static_cast<int>(m_readahead.load(std::memory_order_relaxed)))
 							break;
 						buf = GetBlockPtr(chunk);
 					}
 					else
 					{
-						int amt = ReadChunk(static_cast<char*>(buf->ptr) + bufsize, chunk.chunkID);
+						int amt = ReadChunkTimed(static_cast<char*>(buf->ptr) + bufsize, chunk.chunkID);
 						if (amt <= 0)
 							break;
 						buf->size.store(bufsize + amt, std::memory_order_release);
@@ -143,42 +145,78 @@ void ThreadedFileReader::Loop()
 
 ThreadedFileReader::Buffer* ThreadedFileReader::GetBlockPtr(const Chunk& block)
 {
-	for (int i = 0; i < static_cast<int>(std::size(m_buffer)); i++)
+	if (Buffer* buf = FindBlock(block))
+		return buf;
+
+	Buffer& buf = ClaimBuffer(block);
+	int size = ReadChunkTimed(buf.ptr, block.chunkID);
+	if (size > 0)
+	{
+		buf.offset = block.offset;
+		buf.lastUse.store(++m_bufferClock, std::memory_order_relaxed);
+		buf.size.store(size, std::memory_order_release);
+		return &buf;
+	}
+	return nullptr;
+}
+
+ThreadedFileReader::Buffer* ThreadedFileReader::FindBlock(const Chunk& block)
+{
+	for (Buffer& buf : m_buffer)
 	{
-		u32 size = m_buffer[i].size.load(std::memory_order_relaxed);
-		u64 offset = m_buffer[i].offset;
+		u32 size = buf.size.load(std::memory_order_relaxed);
+		u64 offset = buf.offset;
 		if (size && offset <= block.offset && offset + size >= block.offset + block.length)
 		{
-			m_nextBuffer = (i + 1) % std::size(m_buffer);
-			return m_buffer + i;
+			buf.lastUse.store(++m_bufferClock, std::memory_order_relaxed);
+			return &buf;
 		}
 	}
+	return nullptr;
+}
 
-	Buffer& buf = m_buffer[m_nextBuffer];
+ThreadedFileReader::Buffer& ThreadedFileReader::ClaimBuffer(const Chunk& block)
+{
+	Buffer* lru = &m_buffer[0];
+	for (Buffer& buf : m_buffer)
 	{
-		// This can be called from both the read thread threads in ReadSync
-		// Calls from ReadSync are done with the lock already held to keep the read thread out
-		// Therefore we should only lock on the read thread
-		std::unique_lock<std::mutex> lock(m_mtx, std::defer_lock);
-		if (std::this_thread::get_id() == m_readThread.get_id())
-			lock.lock();
-		u32 size = std::max(block.length, MINIMUM_SIZE);
-		if (buf.cap < size)
-		{
-			buf.ptr = realloc(buf.ptr, size);
-			buf.cap = size;
-		}
-		buf.size.store(0, std::memory_order_relaxed);
+		if (buf.lastUse.load(std::memory_order_relaxed) < lru->lastUse.load(std::memory_order_relaxed))
+			lru = &buf;
 	}
-	int size = ReadChunk(buf.ptr, block.chunkID);
-	if (size > 0)
+
+	Buffer& buf = *lru;
+	// This can be called from both the read thread threads in ReadSync
+	// Calls from ReadSync are done with the lock already held to keep the read thread out
+	// Therefore we should only lock on the read thread
+	std::unique_lock<std::mutex> lock(m_mtx, std::defer_lock);
+	if (std::this_thread::get_id() == m_readThread.get_id())
+		lock.lock();
+	u32 size = std::max(block.length, MINIMUM_SIZE);
+	if (buf.cap < size)
 	{
-		buf.offset = block.offset;
-		buf.size.store(size, std::memory_order_release);
-		m_nextBuffer = (m_nextBuffer + 1) % std::size(m_buffer);
-		return &buf;
+		buf.ptr = realloc(buf.ptr, size);
+		buf.cap = size;
 	}
-	return nullptr;
+	buf.size.store(0, std::memory_order_relaxed);
+	return buf;
+}
+
+void ThreadedFileReader::InsertBlock(const Chunk& block, const void* data, u32 size)
+{
+	Buffer& buf = ClaimBuffer(block);
+	std::memcpy(buf.ptr, data, size);
+	buf.offset = block.offset;
+	buf.lastUse.store(++m_bufferClock, std::memory_order_relaxed);
+	buf.size.store(size, std::memory_order_release);
+}
+
+int ThreadedFileReader::ReadChunkTimed(void* dst, s64 chunkID)
+{
+	const Common::Timer::Value start = Common::Timer::GetCurrentValue();
+	const int size = ReadChunk(dst, chunkID);
+	m_statReadTime.fetch_add(Common::Timer::GetCurrentValue() - start, std::memory_order_relaxed);
+	m_statChunksRead.fetch_add(1, std::memory_order_relaxed);
+	return size;
 }
 
 bool ThreadedFileReader::Decompress(void* target, u64 begin, u32 size)
@@ -192,9 +230,10 @@ bool ThreadedFileReader::Decompress(void* target, u64 begin, u32 size)
 			return false;
 
 		Chunk chunk = ChunkForOffset(off);
-		if (m_internalBlockSize || chunk.offset != off || chunk.length > remaining)
+		Buffer* cached = FindBlock(chunk);
+		if (cached || m_internalBlockSize || chunk.offset != off || chunk.length > remaining)
 		{
-			Buffer* buf = GetBlockPtr(chunk);
+			Buffer* buf = cached ? cached : GetBlockPtr(chunk);
 			if (!buf)
 				return false;
 			u32 bufoff = off - buf->offset;
@@ -208,9 +247,12 @@ bool ThreadedFileReader::Decompress(void* target, u64 begin, u32 size)
 		}
 		else
 		{
-			int amt = ReadChunk(write, chunk.chunkID);
+			// Whole chunks are decompressed straight into the destination, and copied into the cache afterwards so
+			// reading them again doesn't decompress them again
+			int amt = ReadChunkTimed(write, chunk.chunkID);
 			if (amt < static_cast<int>(chunk.length))
 				return false;
+			InsertBlock(chunk, write, chunk.length);
 			write += chunk.length;
 			remaining -= chunk.length;
 			off += chunk.length;
@@ -222,33 +264,87 @@ bool ThreadedFileReader::Decompress(void* target, u64 begin, u32 size)
 
 bool ThreadedFileReader::TryCachedRead(void*& buffer, u64& offset, u32& size, const std::lock_guard<std::mutex>&)
 {
-	// Run through twice so that if m_buffer[1] contains the first half and m_buffer[0] contains the second half it still works
+	// Buffers aren't kept in order, so keep going over them for as long as they continue the read
 	m_amtRead = 0;
 	u64 end = 0;
-	bool allDone = false;
-	for (int i = 0; i < static_cast<int>(std::size(m_buffer) * 2); i++)
+	bool progress = true;
+	while (size > 0 && progress)
 	{
-		Buffer& buf = m_buffer[i % std::size(m_buffer)];
-		u32 bufsize = buf.size.load(std::memory_order_acquire);
-		if (!bufsize)
-			continue;
-		if (buf.offset <= offset && buf.offset + bufsize > offset)
+		progress = false;
+		for (Buffer& buf : m_buffer)
 		{
+			u32 bufsize = buf.size.load(std::memory_order_acquire);
+			if (!bufsize || buf.offset > offset || buf.offset + bufsize <= offset)
+				continue;
+
 			u32 off = offset - buf.offset;
 			u32 cpysize = std::min(size, bufsize - off);
 			size_t read = CopyBlocks(buffer, static_cast<char*>(buf.ptr) + off, cpysize);
+			buf.lastUse.store(++m_bufferClock, std::memory_order_relaxed);
 			m_amtRead += read;
 			size -= cpysize;
 			offset += cpysize;
 			buffer = static_cast<char*>(buffer) + read;
+			progress = true;
 			if (size == 0)
+			{
 				end = buf.offset + bufsize;
+				break;
+			}
 		}
-		// Do buffers contain the current and next block?
-		if (end > 0 && buf.offset == end)
-			allDone = true;
 	}
-	return allDone;
+
+	return (size == 0 && IsReadaheadCached(end));
+}
+
+bool ThreadedFileReader::IsReadaheadCached(u64 end) const
+{
+	// The buffer the read ended in counts towards the depth
+	const u32 depth = m_readahead.load(std::memory_order_relaxed);
+	for (u32 i = 1; i < depth; i++)
+	{
+		const Buffer* next = nullptr;
+		for (const Buffer& buf : m_buffer)
+		{
+			if (buf.size.load(std::memory_order_acquire) && buf.offset == end)
+			{
+				next = &buf;
+				break;
+			}
+		}
+
+		if (!next)
+			return false;
+
+		end = next->offset + next->size.load(std::memory_order_acquire);
+	}
+
+	return true;
+}
+
+void ThreadedFileReader::UpdateReadahead(u64 offset, u32 size)
+{
+	// Reads which pick up where the last one ended are most likely streaming, so read further ahead for them
+	if (offset == m_lastReadEnd)
+		m_readahead.store(std::min(m_readahead.load(std::memory_order_relaxed) * 2, MAX_READAHEAD), std::memory_order_relaxed);
+	else
+		m_readahead.store(MIN_READAHEAD, std::memory_order_relaxed);
+
+	m_lastReadEnd = offset + size;
+}
+
+void ThreadedFileReader::ReportCacheStats()
+{
+	const u32 hits = m_statHits.exchange(0, std::memory_order_relaxed);
+	const u32 misses = m_statMisses.exchange(0, std::memory_order_relaxed);
+	const u32 chunks = m_statChunksRead.exchange(0, std::memory_order_relaxed);
+	const double read_ms = Common::Timer::ConvertValueToMilliseconds(m_statReadTime.exchange(0, std::memory_order_relaxed));
+	if ((hits + misses) == 0)
+		return;
+
+	Console.WriteLn("ThreadedFileReader: %u of %u reads served from cache (%.1f%%), %u chunks decompressed in %.2f ms (%.1f us average).",
+		hits, hits + misses, static_cast<double>(hits) * 100.0 / static_cast<double>(hits + misses), chunks, read_ms,
+		chunks ? (read_ms * 1000.0 / chunks) : 0.0);
 }
 
 bool ThreadedFileReader::Precache(ProgressCallback* progress, Error* error)
@@ -296,7 +392,10 @@ int ThreadedFileReader::ReadSync(void* pBuffer, u32 sector, u32 count)
 	u32 size = count * blocksize;
 	{
 		std::lock_guard<std::mutex> l(m_mtx);
-		if (TryCachedRead(pBuffer, offset, size, l))
+		UpdateReadahead(offset, size);
+		const bool readahead_cached = TryCachedRead(pBuffer, offset, size, l);
+		(size ? m_statMisses : m_statHits).fetch_add(1, std::memory_order_relaxed);
+		if (readahead_cached)
 			return m_amtRead;
 
 		if (size > 0 && !m_running)
@@ -350,7 +449,10 @@ void ThreadedFileReader::BeginRead(void* pBuffer, u32 sector, u32 count)
 	u32 size = count * blocksize;
 	{
 		std::lock_guard<std::mutex> l(m_mtx);
-		if (TryCachedRead(pBuffer, offset, size, l))
+		UpdateReadahead(offset, size);
+		const bool readahead_cached = TryCachedRead(pBuffer, offset, size, l);
+		(size ? m_statMisses : m_statHits).fetch_add(1, std::memory_order_relaxed);
+		if (readahead_cached)
 			return;
 		if (size == 0)
 		{
@@ -393,8 +495,14 @@ void ThreadedFileReader::CancelRead(void)
 void ThreadedFileReader::Close(void)
 {
 	CancelAndWaitUntilStopped();
+	ReportCacheStats();
 	for (auto& buf : m_buffer)
+	{
 		buf.size.store(0, std::memory_order_relaxed);
+		buf.lastUse.store(0, std::memory_order_relaxed);
+	}
+	m_readahead.store(MIN_READAHEAD, std::memory_order_relaxed);
+	m_lastReadEnd = 0;
 	Close2();
 }
 
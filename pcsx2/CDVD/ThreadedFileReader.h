@@ -71,10 +71,28 @@ private:
 		u64 offset = 0;
 		std::atomic<u32> size{0};
 		u32 cap = 0;
+		/// Value of `m_bufferClock` when last used, for LRU replacement
+		std::atomic<u64> lastUse{0};
 	};
-	/// 2 buffers for readahead (current block, next block)
-	Buffer m_buffer[2];
-	u32 m_nextBuffer = 0;
+	/// Number of decompressed buffers kept around, each holds at least one chunk (and at least 128KB)
+	static constexpr u32 NUM_BUFFERS = 32;
+	/// Readahead depth in buffers for random access, and the limit it grows to for sequential reads
+	static constexpr u32 MIN_READAHEAD = 2;
+	static constexpr u32 MAX_READAHEAD = NUM_BUFFERS / 2;
+	/// LRU cache of decompressed chunks, also used for readahead
+	Buffer m_buffer[NUM_BUFFERS];
+	std::atomic<u64> m_bufferClock{0};
+	/// Number of buffers to keep decompressed ahead of the last read
+	/// Doubled for every read which continues where the previous one ended, reset on seeks
+	std::atomic<u32> m_readahead{MIN_READAHEAD};
+	/// End offset of the last read, to detect sequential reads
+	u64 m_lastReadEnd = 0;
+
+	/// Cache statistics, reported on close
+	std::atomic<u32> m_statHits{0};
+	std::atomic<u32> m_statMisses{0};
+	std::atomic<u32> m_statChunksRead{0};
+	std::atomic<u64> m_statReadTime{0};
 
 	std::thread m_readThread;
 	std::mutex m_mtx;
@@ -97,6 +115,20 @@ private:
 
 	/// Load the given block into one of the `m_buffer` buffers if necessary and return a pointer to its contents if successful
 	Buffer* GetBlockPtr(const Chunk& block);
+	/// Return the buffer containing the given block and mark it as used, or null if it isn't cached
+	Buffer* FindBlock(const Chunk& block);
+	/// Empty the least recently used buffer and make it big enough for the given block
+	Buffer& ClaimBuffer(const Chunk& block);
+	/// Copy a block that was decompressed somewhere else into the cache
+	void InsertBlock(const Chunk& block, const void* data, u32 size);
+	/// ReadChunk, but keeps track of the time spent decompressing
+	int ReadChunkTimed(void* dst, s64 chunkID);
+	/// Updates the readahead depth for a read at the given offset
+	void UpdateReadahead(u64 offset, u32 size);
+	/// Returns true if the buffers already cover the readahead depth past `end`
+	bool IsReadaheadCached(u64 end) const;
+	/// Logs and resets the cache statistics
+	void ReportCacheStats();
 	/// Decompress from offset to size into
 	bool Decompress(void* ptr, u64 offset, u32 size);
 	/// Cancel any inflight read and wait until the thread is no longer doing anything
@@ -608,11 +608,11 @@ struct Pcsx2Config
 	{
 		BITFIELD32()
 		bool
-			Enabled : 1, // universal toggle for the profiler.
-			RecBlocks_EE : 1, // Enables per-block profiling for the EE recompiler [unimplemented]
-			RecBlocks_IOP : 1, // Enables per-block profiling for the IOP recompiler [unimplemented]
-			RecBlocks_VU0 : 1, // Enables per-block profiling for the VU0 recompiler [unimplemented]
-			RecBlocks_VU1 : 1; // Enables per-block profiling for the VU1 recompiler [unimplemented]
+			Enabled : 1, // samples recompiled code while the VM is running, see SamplingProfiler.
+			RecBlocks_EE : 1, // Attributes samples to individual EE recompiler blocks
+			RecBlocks_IOP : 1, // Attributes samples to individual IOP recompiler blocks
+			RecBlocks_VU0 : 1, // Attributes samples to individual VU0 recompiler blocks
+			RecBlocks_VU1 : 1; // Attributes samples to individual VU1 recompiler blocks
 		BITFIELD_END
 
 		// Default is Disabled, with all recs enabled underneath.
@@ -656,6 +656,10 @@ struct Pcsx2Config
 			EnableFastmem : 1;
 		bool
 			PauseOnTLBMiss : 1;
+		bool
+			EnableEEBlockProfile : 1;
+		bool
+			EnableVUProgramProfile : 1;
 		BITFIELD_END
 
 		RecompilerOptions();
@@ -877,6 +881,8 @@ struct Pcsx2Config
 		s16 MoveHandlerFunctionId = -1;
 		int SkipDrawStart = 0;
 		int SkipDrawEnd = 0;
+		u16 HashCacheVRAMBudget = 0; // MB, zero for no limit.
+		u16 HashCacheHostBudget = 0; // MB of compressed host memory for evicted hash cache textures, zero disables.
 
 		GSHWAutoFlushLevel UserHacks_AutoFlush = GSHWAutoFlushLevel::Disabled;
 		GSHalfPixelOffset UserHacks_HalfPixelOffset = GSHalfPixelOffset::Off;
@@ -1335,6 +1341,10 @@ struct Pcsx2Config
 		SavestateCompressionMethod CompressionType = SavestateCompressionMethod::Zstandard;
 		SavestateCompressionLevel CompressionRatio = SavestateCompressionLevel::Medium;
 
+		bool RewindEnabled = false; // captures in-memory delta states while running, see Rewind.
+		u32 RewindFrequency = 10; // frames between rewind snapshots
+		u32 RewindBufferSize = 256; // memory budget for rewind snapshots, in megabytes
+
 		bool operator==(const SavestateOptions& right) const;
 		bool operator!=(const SavestateOptions& right) const;
 	};
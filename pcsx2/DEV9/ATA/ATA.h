@@ -8,9 +8,12 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <unordered_map>
+#include <vector>
 
 #include "common/RedtapeWindows.h"
 #include "common/Path.h"
+#include "common/Timer.h"
 
 #include "DEV9/SimpleQueue.h"
 
@@ -32,6 +35,9 @@ private:
 	u64 HddSparseStart;
 	std::unique_ptr<u8[]> hddSparseBlock;
 	bool hddSparseBlockValid = false;
+	//Sparse blocks known to be holes, so they don't need to be probed again
+	//Only accessed when the IO thread owns the image
+	std::vector<bool> hddSparseHoles;
 
 #ifdef _WIN32
 	HANDLE hddNativeHandle = INVALID_HANDLE_VALUE;
@@ -128,6 +134,9 @@ private:
 	std::atomic_bool ioClose{false};
 	bool ioWrite;
 	bool ioRead;
+	//Owned by whichever thread is writing
+	bool ioWriteDirty = false; //Written since last flush
+	u64 ioWritePos = UINT64_MAX; //Known file position after the last write
 	void (ATA::*waitingCmd)() = nullptr;
 	//Write Buffer(s)
 
@@ -140,6 +149,37 @@ private:
 	u8* readBuffer = nullptr;
 	//Read Buffer
 
+	//Read Cache
+	//Reads are done in whole blocks, which doubles as read-ahead for sequential access
+	//Only accessed on the EE thread, queued writes are applied as they are queued
+	static constexpr u32 ReadCacheBlockSectors = 256;
+	static constexpr u32 ReadCacheBlockSize = ReadCacheBlockSectors * 512;
+	static constexpr u32 ReadCacheBlocks = 128;
+	struct ReadCacheBlock
+	{
+		u64 index;
+		u64 lastUse;
+		std::unique_ptr<u8[]> data;
+	};
+	std::vector<ReadCacheBlock> readCache;
+	std::unordered_map<u64, u32> readCacheLookup;
+	u64 readCacheCounter = 0;
+	//Read Cache
+
+	//Stats, logged on close
+	u64 statReads = 0;
+	u64 statReadSectors = 0;
+	u64 statReadCacheHits = 0;
+	u64 statReadCacheMisses = 0;
+	Common::Timer::Value statReadTime = 0;
+	Common::Timer::Value statReadTimeMax = 0;
+	u64 statWrites = 0; //IO thread
+	u64 statWriteFlushes = 0;
+	u64 statSparseProbes = 0;
+	u64 statSparseProbesSkipped = 0;
+	Common::Timer::Value statWriteTime = 0;
+	//Stats
+
 	//PIO Buffer
 	int pioPtr;
 	int pioEnd;
@@ -212,6 +252,11 @@ private:
 	void IO_Thread();
 	void IO_Read();
 	bool IO_Write();
+	void IO_ReadCached();
+	u8* IO_ReadCacheGetBlock(u64 index);
+	void HDD_ReadCacheWrite(u64 byteOffset, const u8* data, u32 length);
+	void HDD_ReadCacheClear();
+	void HDD_LogStats();
 	bool IO_SparseZero(u64 byteOffset, u64 byteSize);
 	void IO_SparseCacheUpdateLocation(u64 Offset);
 	void IO_SparseCacheLoad();
@@ -106,6 +106,8 @@ int ATA::Open(const std::string& hddPath)
 		ioRead = false;
 		ioWrite = false;
 	}
+	ioWriteDirty = false;
+	ioWritePos = UINT64_MAX;
 
 	ioThread = std::thread(&ATA::IO_Thread, this);
 	ioRunning = true;
@@ -244,6 +246,7 @@ void ATA::InitSparseSupport(const std::string& hddPath)
 #endif
 	hddSparseBlock = std::make_unique<u8[]>(hddSparseBlockSize);
 	hddSparseBlockValid = false;
+	hddSparseHoles.assign((hddImageSize + hddSparseBlockSize - 1) / hddSparseBlockSize, false);
 }
 
 void ATA::Close()
@@ -281,12 +284,16 @@ void ATA::Close()
 		hddSparseBlock = nullptr;
 		hddSparseBlockValid = false;
 	}
+	hddSparseHoles = {};
 	if (hddImage)
 	{
 		std::fclose(hddImage);
 		hddImage = nullptr;
 	}
 
+	HDD_ReadCacheClear();
+	HDD_LogStats();
+
 	delete[] readBuffer;
 	readBuffer = nullptr;
 }
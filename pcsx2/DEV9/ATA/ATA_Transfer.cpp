@@ -75,6 +75,7 @@ void ATA::IO_Read()
 		pxAssert(false);
 		abort();
 	}
+	ioWritePos = UINT64_MAX;
 	{
 		std::lock_guard ioSignallock(ioMutex);
 		ioRead = false;
@@ -86,13 +87,29 @@ bool ATA::IO_Write()
 	WriteQueueEntry entry;
 	if (!writeQueue.Dequeue(&entry))
 	{
+		// Flush once the queue is drained, rather than after every write.
+		if (ioWriteDirty)
+		{
+			if (std::fflush(hddImage) != 0)
+			{
+				Console.Error("DEV9: ATA: File write error");
+				pxAssert(false);
+				abort();
+			}
+			ioWriteDirty = false;
+			statWriteFlushes++;
+		}
+
 		std::lock_guard ioSignallock(ioMutex);
 		ioWrite = false;
 		return false;
 	}
 
+	const Common::Timer::Value startTime = Common::Timer::GetCurrentValue();
+
+	// Seeking discards the stream buffer, so skip it for back to back writes.
 	const u64 imagePos = entry.sector * 512;
-	if (FileSystem::FSeek64(hddImage, imagePos, SEEK_SET) != 0)
+	if (imagePos != ioWritePos && FileSystem::FSeek64(hddImage, imagePos, SEEK_SET) != 0)
 	{
 		Console.Error("DEV9: ATA: File seek error");
 		pxAssert(false);
@@ -155,9 +172,10 @@ bool ATA::IO_Write()
 				// Update cache.
 				if (hddSparseBlockValid)
 					memcpy(&hddSparseBlock[(imagePos + written) - HddSparseStart], &entry.data[written], writeSize);
+				if (hddSparse)
+					hddSparseHoles[HddSparseStart / hddSparseBlockSize] = false;
 
-				if (std::fwrite(&entry.data[written], writeSize, 1, hddImage) != 1 ||
-					std::fflush(hddImage) != 0)
+				if (std::fwrite(&entry.data[written], writeSize, 1, hddImage) != 1)
 				{
 					Console.Error("DEV9: ATA: File write error");
 					pxAssert(false);
@@ -170,7 +188,7 @@ bool ATA::IO_Write()
 	}
 	else
 	{
-		if (std::fwrite(entry.data, entry.length, 1, hddImage) != 1 || std::fflush(hddImage) != 0)
+		if (std::fwrite(entry.data, entry.length, 1, hddImage) != 1)
 		{
 			Console.Error("DEV9: ATA: File write error");
 			pxAssert(false);
@@ -178,9 +196,157 @@ bool ATA::IO_Write()
 		}
 	}
 	delete[] entry.data;
+
+	ioWriteDirty = true;
+	ioWritePos = imagePos + entry.length;
+	statWrites++;
+	statWriteTime += Common::Timer::GetCurrentValue() - startTime;
 	return true;
 }
 
+void ATA::IO_ReadCached()
+{
+	const s64 lba = HDD_GetLBA();
+
+	if (lba == -1)
+	{
+		Console.Error("DEV9: ATA: Invalid LBA");
+		pxAssert(false);
+		abort();
+	}
+
+	const Common::Timer::Value startTime = Common::Timer::GetCurrentValue();
+
+	u64 pos = static_cast<u64>(lba) * 512;
+	const u64 end = pos + static_cast<u64>(nsector) * 512;
+	u8* dest = readBuffer;
+	while (pos < end)
+	{
+		const u32 offset = static_cast<u32>(pos % ReadCacheBlockSize);
+		const u32 size = static_cast<u32>(std::min<u64>(ReadCacheBlockSize - offset, end - pos));
+		memcpy(dest, IO_ReadCacheGetBlock(pos / ReadCacheBlockSize) + offset, size);
+		dest += size;
+		pos += size;
+	}
+
+	const Common::Timer::Value time = Common::Timer::GetCurrentValue() - startTime;
+	statReads++;
+	statReadSectors += nsector;
+	statReadTime += time;
+	statReadTimeMax = std::max(statReadTimeMax, time);
+}
+
+// Requires the IO thread to be idle, as misses write out the queue.
+u8* ATA::IO_ReadCacheGetBlock(u64 index)
+{
+	const auto it = readCacheLookup.find(index);
+	if (it != readCacheLookup.end())
+	{
+		ReadCacheBlock& block = readCache[it->second];
+		block.lastUse = ++readCacheCounter;
+		statReadCacheHits++;
+		return block.data.get();
+	}
+	statReadCacheMisses++;
+
+	// Queued writes are already in cached blocks, but might not have reached the file yet.
+	while (IO_Write())
+		;
+
+	u32 slot;
+	if (readCache.size() < ReadCacheBlocks)
+	{
+		slot = static_cast<u32>(readCache.size());
+		readCache.push_back({0, 0, std::make_unique<u8[]>(ReadCacheBlockSize)});
+	}
+	else
+	{
+		// Evict least recently used.
+		slot = 0;
+		for (u32 i = 1; i < ReadCacheBlocks; i++)
+		{
+			if (readCache[i].lastUse < readCache[slot].lastUse)
+				slot = i;
+		}
+		readCacheLookup.erase(readCache[slot].index);
+	}
+
+	ReadCacheBlock& block = readCache[slot];
+	const u64 pos = index * ReadCacheBlockSize;
+	pxAssert(pos < hddImageSize);
+	const u64 readSize = std::min<u64>(ReadCacheBlockSize, hddImageSize - pos);
+	if (FileSystem::FSeek64(hddImage, pos, SEEK_SET) != 0 ||
+		std::fread(block.data.get(), readSize, 1, hddImage) != 1)
+	{
+		Console.Error("DEV9: ATA: File read error");
+		pxAssert(false);
+		abort();
+	}
+	// Zero data beyond end of file.
+	memset(&block.data[readSize], 0, ReadCacheBlockSize - readSize);
+	ioWritePos = UINT64_MAX;
+
+	block.index = index;
+	block.lastUse = ++readCacheCounter;
+	readCacheLookup[index] = slot;
+	return block.data.get();
+}
+
+// Applies a queued write to any cached blocks it overlaps.
+void ATA::HDD_ReadCacheWrite(u64 byteOffset, const u8* data, u32 length)
+{
+	const u64 end = byteOffset + length;
+	for (u64 index = byteOffset / ReadCacheBlockSize; index * ReadCacheBlockSize < end; index++)
+	{
+		const auto it = readCacheLookup.find(index);
+		if (it == readCacheLookup.end())
+			continue;
+
+		const u64 blockStart = index * ReadCacheBlockSize;
+		const u64 start = std::max(byteOffset, blockStart);
+		const u64 stop = std::min(end, blockStart + ReadCacheBlockSize);
+		memcpy(&readCache[it->second].data[start - blockStart], &data[start - byteOffset], stop - start);
+	}
+}
+
+void ATA::HDD_ReadCacheClear()
+{
+	readCache.clear();
+	readCacheLookup.clear();
+	readCacheCounter = 0;
+}
+
+void ATA::HDD_LogStats()
+{
+	if (statReads != 0)
+	{
+		DevCon.WriteLnFmt("DEV9: ATA: {} reads ({} sectors), {} cache hits, {} misses, {:.1f}us average, {:.1f}us max",
+			statReads, statReadSectors, statReadCacheHits, statReadCacheMisses,
+			Common::Timer::ConvertValueToNanoseconds(statReadTime) / 1000.0 / static_cast<double>(statReads),
+			Common::Timer::ConvertValueToNanoseconds(statReadTimeMax) / 1000.0);
+	}
+	if (statWrites != 0)
+	{
+		DevCon.WriteLnFmt("DEV9: ATA: {} writes, {} flushes, {:.1f}us average",
+			statWrites, statWriteFlushes,
+			Common::Timer::ConvertValueToNanoseconds(statWriteTime) / 1000.0 / static_cast<double>(statWrites));
+	}
+	if (statSparseProbes != 0 || statSparseProbesSkipped != 0)
+		DevCon.WriteLnFmt("DEV9: ATA: {} sparse block probes, {} skipped as known holes", statSparseProbes, statSparseProbesSkipped);
+
+	statReads = 0;
+	statReadSectors = 0;
+	statReadCacheHits = 0;
+	statReadCacheMisses = 0;
+	statReadTime = 0;
+	statReadTimeMax = 0;
+	statWrites = 0;
+	statWriteFlushes = 0;
+	statSparseProbes = 0;
+	statSparseProbesSkipped = 0;
+	statWriteTime = 0;
+}
+
 void ATA::IO_SparseCacheLoad()
 {
 	// Reads are bounds checked, but for the sectors read only.
@@ -195,6 +361,16 @@ void ATA::IO_SparseCacheLoad()
 		memset(&hddSparseBlock[readSize], 0, hddSparseBlockSize - readSize);
 	}
 
+	const u64 blockIndex = HddSparseStart / hddSparseBlockSize;
+	if (hddSparseHoles[blockIndex])
+	{
+		memset(hddSparseBlock.get(), 0, hddSparseBlockSize);
+		hddSparseBlockValid = true;
+		statSparseProbesSkipped++;
+		return;
+	}
+	statSparseProbes++;
+
 	// Flush so that we know what is allocated.
 	std::fflush(hddImage);
 
@@ -219,6 +395,7 @@ void ATA::IO_SparseCacheLoad()
 		// We are sparse.
 		memset(hddSparseBlock.get(), 0, hddSparseBlockSize);
 		hddSparseBlockValid = true;
+		hddSparseHoles[blockIndex] = true;
 #if defined(PCSX2_DEBUG) || defined(PCSX2_DEVBUILD)
 		ATA::IO_SparseCacheAssertFileZeros(readSize);
 #endif
@@ -237,6 +414,7 @@ void ATA::IO_SparseCacheLoad()
 			// We are sparse.
 			memset(hddSparseBlock.get(), 0, hddSparseBlockSize);
 			hddSparseBlockValid = true;
+			hddSparseHoles[blockIndex] = true;
 #if defined(PCSX2_DEBUG) || defined(PCSX2_DEVBUILD)
 			ATA::IO_SparseCacheAssertFileZeros(readSize);
 #endif
@@ -332,8 +510,7 @@ bool ATA::IO_SparseZero(u64 byteOffset, u64 byteSize)
 #endif
 
 		//No, do normal write
-		if (std::fwrite((char*)&hddSparseBlock[byteOffset - HddSparseStart], byteSize, 1, hddImage) != 1 ||
-			std::fflush(hddImage) != 0)
+		if (std::fwrite((char*)&hddSparseBlock[byteOffset - HddSparseStart], byteSize, 1, hddImage) != 1)
 		{
 			Console.Error("DEV9: ATA: File write error");
 			pxAssert(false);
@@ -349,36 +526,51 @@ bool ATA::IO_SparseZero(u64 byteOffset, u64 byteSize)
 #endif
 
 	//Yes, try sparse write
+	const u64 blockIndex = HddSparseStart / hddSparseBlockSize;
+	if (!hddSparseHoles[blockIndex])
+	{
+		//Buffered writes to the block must land before the hole is punched
+		if (std::fflush(hddImage) != 0)
+		{
+			Console.Error("DEV9: ATA: File write error");
+			pxAssert(false);
+			abort();
+		}
+
 #ifdef _WIN32
-	FILE_ZERO_DATA_INFORMATION sparseRange;
-	sparseRange.FileOffset.QuadPart = HddSparseStart;
-	sparseRange.BeyondFinalZero.QuadPart = HddSparseStart + hddSparseBlockSize;
-	DWORD dwTemp;
-	const BOOL ret = DeviceIoControl(hddNativeHandle, FSCTL_SET_ZERO_DATA, &sparseRange, sizeof(sparseRange), nullptr, 0, &dwTemp, nullptr);
+		FILE_ZERO_DATA_INFORMATION sparseRange;
+		sparseRange.FileOffset.QuadPart = HddSparseStart;
+		sparseRange.BeyondFinalZero.QuadPart = HddSparseStart + hddSparseBlockSize;
+		DWORD dwTemp;
+		const BOOL ret = DeviceIoControl(hddNativeHandle, FSCTL_SET_ZERO_DATA, &sparseRange, sizeof(sparseRange), nullptr, 0, &dwTemp, nullptr);
 
-	if (ret == FALSE)
-		return false;
+		if (ret == FALSE)
+			return false;
 
 #elif defined(__linux__)
-	const int ret = fallocate(hddNativeHandle, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, HddSparseStart, hddSparseBlockSize);
+		const int ret = fallocate(hddNativeHandle, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, HddSparseStart, hddSparseBlockSize);
 
-	if (ret == -1)
-		return false;
+		if (ret == -1)
+			return false;
 
 #elif defined(__APPLE__)
-	fpunchhole_t sparseRange{0};
-	sparseRange.fp_offset = HddSparseStart;
-	sparseRange.fp_length = hddSparseBlockSize;
+		fpunchhole_t sparseRange{0};
+		sparseRange.fp_offset = HddSparseStart;
+		sparseRange.fp_length = hddSparseBlockSize;
 
-	const int ret = fcntl(hddNativeHandle, F_PUNCHHOLE, &sparseRange);
+		const int ret = fcntl(hddNativeHandle, F_PUNCHHOLE, &sparseRange);
 
-	if (ret == -1)
-		return false;
+		if (ret == -1)
+			return false;
 
 #else
-	Console.Error("DEV9: ATA: Hole punching not supported on current OS");
-	return false;
+		Console.Error("DEV9: ATA: Hole punching not supported on current OS");
+		return false;
 #endif
+
+		hddSparseHoles[blockIndex] = true;
+	}
+
 	if (FileSystem::FSeek64(hddImage, byteOffset + byteSize, SEEK_SET) != 0)
 	{
 		Console.Error("DEV9: ATA: File seek error");
@@ -460,7 +652,7 @@ void ATA::HDD_ReadSync(void (ATA::*drqCMD)())
 		readBufferLen = nsector * 512;
 	}
 
-	IO_Read();
+	IO_ReadCached();
 
 	if (ioWritePaused)
 	{
@@ -47,6 +47,8 @@ void ATA::DRQCmdDMADataFromHost()
 }
 void ATA::PostCmdDMADataFromHost()
 {
+	HDD_ReadCacheWrite(currentWriteSectors * 512, currentWrite, currentWriteLength);
+
 	WriteQueueEntry entry{0};
 	entry.data = currentWrite;
 	entry.length = currentWriteLength;
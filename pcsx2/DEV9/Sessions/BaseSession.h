@@ -3,6 +3,10 @@
 
 #pragma once
 
+#ifdef _WIN32
+#include <winsock2.h>
+#endif
+
 #include "DEV9/PacketReader/IP/IP_Packet.h"
 #include <functional>
 #include <optional>
@@ -50,6 +54,14 @@ namespace Sessions
 		void AddConnectionClosedHandler(ConnectionClosedEventHandler handler);
 
 		virtual std::optional<ReceivedPayload> Recv() = 0;
+		// Returns the socket Recv() reads from, if reading it is all Recv() currently does
+		// The adapter then only calls Recv() once the socket is readable, or on its periodic sweep
+		// Sessions with other pending work (queued packets, connects, pings) return nothing
+#ifdef _WIN32
+		virtual std::optional<SOCKET> GetRecvSocket() { return std::nullopt; }
+#elif defined(__POSIX__)
+		virtual std::optional<int> GetRecvSocket() { return std::nullopt; }
+#endif
 		virtual bool Send(PacketReader::IP::IP_Payload* payload) = 0;
 		virtual void Reset() = 0;
 
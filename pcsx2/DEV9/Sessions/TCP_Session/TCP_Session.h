@@ -78,6 +78,11 @@ namespace Sessions
 		TCP_Session(ConnectionKey parKey, PacketReader::IP::IP_Address parAdapterIP);
 
 		virtual std::optional<ReceivedPayload> Recv();
+#ifdef _WIN32
+		virtual std::optional<SOCKET> GetRecvSocket();
+#elif defined(__POSIX__)
+		virtual std::optional<int> GetRecvSocket();
+#endif
 		virtual bool Send(PacketReader::IP::IP_Payload* payload);
 		virtual void Reset();
 
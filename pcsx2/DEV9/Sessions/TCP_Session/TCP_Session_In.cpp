@@ -183,6 +183,27 @@ namespace Sessions
 		return std::nullopt;
 	}
 
+#ifdef _WIN32
+	std::optional<SOCKET> TCP_Session::GetRecvSocket()
+#elif defined(__POSIX__)
+	std::optional<int> TCP_Session::GetRecvSocket()
+#endif
+	{
+		// Packets queued by the send thread, and the connect/close states, need Recv() to be called
+		// A false negative from IsQueueEmpty() only costs an extra call
+		if (!_recvBuff.IsQueueEmpty())
+			return std::nullopt;
+
+		switch (state)
+		{
+			case TCP_State::Connected:
+			case TCP_State::Closing_ClosedByPS2:
+				return client;
+			default:
+				return std::nullopt;
+		}
+	}
+
 	std::optional<ReceivedPayload> TCP_Session::ConnectTCPComplete(bool success)
 	{
 		if (success)
@@ -73,6 +73,17 @@ namespace Sessions
 		open.store(true);
 	}
 
+#ifdef _WIN32
+	std::optional<SOCKET> UDP_FixedPort::GetRecvSocket()
+#elif defined(__POSIX__)
+	std::optional<int> UDP_FixedPort::GetRecvSocket()
+#endif
+	{
+		if (!open.load())
+			return std::nullopt;
+		return client;
+	}
+
 	std::optional<ReceivedPayload> UDP_FixedPort::Recv()
 	{
 		if (!open.load())
@@ -60,6 +60,18 @@ namespace Sessions
 	{
 	}
 
+#ifdef _WIN32
+	std::optional<SOCKET> UDP_Session::GetRecvSocket()
+#elif defined(__POSIX__)
+	std::optional<int> UDP_Session::GetRecvSocket()
+#endif
+	{
+		// Fixed port sessions are fed by their UDP_FixedPort, but still need to check for idle
+		if (isFixedPort || !open.load())
+			return std::nullopt;
+		return client;
+	}
+
 	std::optional<ReceivedPayload> UDP_Session::Recv()
 	{
 		if (!open.load())
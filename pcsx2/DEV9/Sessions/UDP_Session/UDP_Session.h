@@ -47,6 +47,11 @@ namespace Sessions
 #endif
 
 		virtual std::optional<ReceivedPayload> Recv();
+#ifdef _WIN32
+		virtual std::optional<SOCKET> GetRecvSocket();
+#elif defined(__POSIX__)
+		virtual std::optional<int> GetRecvSocket();
+#endif
 		virtual bool WillRecive(PacketReader::IP::IP_Address parDestIP);
 		virtual bool Send(PacketReader::IP::IP_Payload* payload);
 		virtual void Reset();
@@ -66,6 +66,23 @@ public:
 		return keys;
 	}
 
+	//Clears entries, then fills it with all key/value pairs
+	//Reusing the vector avoids allocating on every call
+	void GetEntries(std::vector<std::pair<Key, T>>* entries)
+	{
+#ifdef NO_SHARED_MUTEX
+		std::unique_lock readLock(accessMutex);
+#else
+		std::shared_lock readLock(accessMutex);
+#endif
+
+		entries->clear();
+		entries->reserve(map.size());
+
+		for (auto iter = map.begin(); iter != map.end(); ++iter)
+			entries->emplace_back(iter->first, iter->second);
+	}
+
 	//Does not error or insert if no key is found
 	bool TryGetValue(Key key, T* value)
 	{
@@ -42,6 +42,11 @@ using namespace PacketReader::IP::ICMP;
 using namespace PacketReader::IP::TCP;
 using namespace PacketReader::IP::UDP;
 
+using namespace std::chrono_literals;
+
+//How often recv() calls every session, even those whose socket isn't readable
+static constexpr std::chrono::steady_clock::duration RECV_SWEEP_INTERVAL = 1s;
+
 std::vector<AdapterEntry> SocketAdapter::GetAdapters()
 {
 	std::vector<AdapterEntry> nic;
@@ -218,33 +223,7 @@ bool SocketAdapter::recv(NetPacket* pkt)
 	if (!vRecBuffer.Dequeue(&bFrame))
 	{
 		std::lock_guard deletelock(deleteSendSentry);
-		std::vector<ConnectionKey> keys = connections.GetKeys();
-		for (size_t i = 0; i < keys.size(); i++)
-		{
-			const ConnectionKey key = keys[i];
-
-			BaseSession* session;
-			if (!connections.TryGetValue(key, &session))
-				continue;
-
-			std::optional<ReceivedPayload> pl = session->Recv();
-
-			if (pl.has_value())
-			{
-				IP_Packet* ipPkt = new IP_Packet(pl->payload.release());
-				ipPkt->destinationIP = session->sourceIP;
-				ipPkt->sourceIP = pl->sourceIP;
-
-				EthernetFrame frame(ipPkt);
-				frame.sourceMAC = internalMAC;
-				frame.destinationMAC = ps2MAC;
-				frame.protocol = static_cast<u16>(EtherType::IPv4);
-
-				frame.WritePacket(pkt);
-				InspectRecv(pkt);
-				return true;
-			}
-		}
+		return RecvFromSessions(pkt);
 	}
 	else
 	{
@@ -254,6 +233,103 @@ bool SocketAdapter::recv(NetPacket* pkt)
 		delete bFrame;
 		return true;
 	}
+}
+
+bool SocketAdapter::RecvFromSessions(NetPacket* pkt)
+{
+	const Common::Timer::Value startTime = Common::Timer::GetCurrentValue();
+	ScopedGuard timing([&]() { statRecvTime += Common::Timer::GetCurrentValue() - startTime; });
+	statRecvPasses++;
+
+	connections.GetEntries(&recvSessions);
+	const size_t count = recvSessions.size();
+	if (count == 0)
+		return false;
+
+	//Sessions which only read a socket are skipped unless poll says it is readable
+	//Every so often all sessions are called anyway, as Recv() also times out idle connections
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	const bool sweep = (now - lastRecvSweep) >= RECV_SWEEP_INTERVAL;
+	if (sweep)
+		lastRecvSweep = now;
+
+	recvPollFds.clear();
+	recvPollIndices.resize(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		const auto socket = recvSessions[i].second->GetRecvSocket();
+		if (sweep || !socket.has_value())
+		{
+			recvPollIndices[i] = -1;
+			continue;
+		}
+
+		recvPollIndices[i] = static_cast<int>(recvPollFds.size());
+		auto& pfd = recvPollFds.emplace_back();
+		pfd.fd = socket.value();
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+	}
+
+	if (recvPollFds.size() != 0)
+	{
+#ifdef _WIN32
+		const int ret = WSAPoll(recvPollFds.data(), static_cast<ULONG>(recvPollFds.size()), 0);
+#elif defined(__POSIX__)
+		const int ret = poll(recvPollFds.data(), static_cast<nfds_t>(recvPollFds.size()), 0);
+#endif
+		//If polling fails, try every session like a sweep would
+		if (ret < 0)
+		{
+			for (auto& pfd : recvPollFds)
+				pfd.revents = POLLIN;
+		}
+	}
+
+	if (recvCursor >= count)
+		recvCursor = 0;
+
+	for (size_t n = 0; n < count; n++)
+	{
+		const size_t i = (recvCursor + n) % count;
+		const int pollIndex = recvPollIndices[i];
+		if (pollIndex >= 0 && recvPollFds[pollIndex].revents == 0)
+		{
+			statSessionsSkipped++;
+			continue;
+		}
+
+		//An earlier Recv() may have closed the session
+		const ConnectionKey key = recvSessions[i].first;
+
+		BaseSession* session;
+		if (!connections.TryGetValue(key, &session))
+			continue;
+
+		statSessionsPolled++;
+		std::optional<ReceivedPayload> pl = session->Recv();
+
+		if (pl.has_value())
+		{
+			IP_Packet* ipPkt = new IP_Packet(pl->payload.release());
+			ipPkt->destinationIP = session->sourceIP;
+			ipPkt->sourceIP = pl->sourceIP;
+
+			EthernetFrame frame(ipPkt);
+			frame.sourceMAC = internalMAC;
+			frame.destinationMAC = ps2MAC;
+			frame.protocol = static_cast<u16>(EtherType::IPv4);
+
+			frame.WritePacket(pkt);
+			InspectRecv(pkt);
+
+			statPacketsRecv++;
+			statBytesRecv += pkt->size;
+			//Start after this session next time
+			recvCursor = i + 1;
+			return true;
+		}
+	}
 	return false;
 }
 
@@ -614,13 +690,21 @@ SocketAdapter::~SocketAdapter()
 	deleteQueueSendThread.clear();
 	deleteQueueRecvThread.clear();
 
+	if (statRecvPasses != 0)
+	{
+		DevCon.WriteLnFmt("DEV9: Socket: Received {} packets ({} bytes) in {} passes, {:.2f}us per pass",
+			statPacketsRecv, statBytesRecv, statRecvPasses,
+			Common::Timer::ConvertValueToNanoseconds(statRecvTime) / 1000.0 / static_cast<double>(statRecvPasses));
+		DevCon.WriteLnFmt("DEV9: Socket: Called Recv() on {} sessions, skipped {} with no data",
+			statSessionsPolled, statSessionsSkipped);
+	}
+
 	//Clear out vRecBuffer
 	while (!vRecBuffer.IsQueueEmpty())
 	{
 		EthernetFrame* retPay;
 		if (!vRecBuffer.Dequeue(&retPay))
 		{
-			using namespace std::chrono_literals;
 			std::this_thread::sleep_for(1ms);
 			continue;
 		}
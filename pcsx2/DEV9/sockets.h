@@ -2,9 +2,17 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #pragma once
+#include <chrono>
 #include <mutex>
+#include <utility>
 #include <vector>
 
+#ifdef __POSIX__
+#include <poll.h>
+#endif
+
+#include "common/Timer.h"
+
 #include "net.h"
 
 #include "PacketReader/IP/IP_Packet.h"
@@ -36,6 +44,27 @@ class SocketAdapter : public NetAdapter
 	std::mutex deleteSendSentry;
 	std::mutex deleteRecvSentry;
 
+	//Scratch state for recv(), reused to avoid allocating on every call
+	std::vector<std::pair<Sessions::ConnectionKey, Sessions::BaseSession*>> recvSessions;
+#ifdef _WIN32
+	std::vector<WSAPOLLFD> recvPollFds;
+#elif defined(__POSIX__)
+	std::vector<pollfd> recvPollFds;
+#endif
+	//Index into recvPollFds for each entry in recvSessions, or -1 if Recv() must always be called
+	std::vector<int> recvPollIndices;
+	//Where the next recv() starts looking, so busy sessions can't starve the rest
+	size_t recvCursor = 0;
+	std::chrono::steady_clock::time_point lastRecvSweep;
+
+	//Statistics, logged on close
+	u64 statRecvPasses = 0;
+	u64 statSessionsPolled = 0;
+	u64 statSessionsSkipped = 0;
+	u64 statPacketsRecv = 0;
+	u64 statBytesRecv = 0;
+	Common::Timer::Value statRecvTime = 0;
+
 public:
 	SocketAdapter();
 	virtual bool blocks();
@@ -52,6 +81,8 @@ public:
 	static AdapterOptions GetAdapterOptions();
 
 private:
+	bool RecvFromSessions(NetPacket* pkt);
+
 	bool SendIP(PacketReader::IP::IP_Packet* ipPkt);
 	bool SendICMP(Sessions::ConnectionKey Key, PacketReader::IP::IP_Packet* ipPkt);
 	bool SendIGMP(Sessions::ConnectionKey Key, PacketReader::IP::IP_Packet* ipPkt);
@@ -0,0 +1,502 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "DebugTools/SamplingProfiler.h"
+#include "DebugTools/SymbolGuardian.h"
+#include "Config.h"
+
+#include "common/Console.h"
+#include "common/Error.h"
+#include "common/FileSystem.h"
+#include "common/Perf.h"
+#include "common/Threading.h"
+#include "common/Timer.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include "common/RedtapeWindows.h"
+#else
+#include <csignal>
+#include <pthread.h>
+#include <ucontext.h>
+#endif
+
+namespace SamplingProfiler
+{
+	namespace
+	{
+		static constexpr u32 RING_SIZE = 256;
+
+		struct ThreadState
+		{
+			u32 name_index;
+#ifdef _WIN32
+			HANDLE handle;
+#else
+			pthread_t handle;
+#endif
+
+			// Written by the signal handler (or the sampler on Windows), drained by the sampler thread.
+			std::array<std::atomic<uptr>, RING_SIZE> ring;
+			std::atomic<u32> head{0};
+			u32 tail = 0;
+		};
+
+		struct SampleKey
+		{
+			u32 thread;
+			const Perf::Group* group; // nullptr for host code
+			u32 pc;
+			bool has_pc;
+			std::string symbol;
+
+			auto operator<=>(const SampleKey&) const = default;
+		};
+	} // namespace
+
+	static void SamplerThread(u32 interval_us);
+	static void DrainSamples(ThreadState* state);
+	static bool IsGroupDetailed(const Perf::Group* group);
+	static std::string GetFunctionName(const Perf::Group* group, u32 pc, bool with_offset);
+	static const char* GetGroupName(const Perf::Group* group);
+
+	static std::mutex s_mutex;
+	static std::vector<std::unique_ptr<ThreadState>> s_threads;
+	static std::vector<std::string> s_thread_names;
+	static thread_local ThreadState* s_current_thread = nullptr;
+
+	static std::thread s_sampler_thread;
+	static std::atomic_bool s_sampler_exit{false};
+	static bool s_active = false;
+	static u32 s_interval_us = DEFAULT_INTERVAL_US;
+	static Pcsx2Config::ProfilerOptions s_options;
+
+	// Aggregated samples, only touched by the sampler thread while active.
+	static std::map<SampleKey, u64> s_samples;
+	static u64 s_total_samples = 0;
+	static u64 s_dropped_samples = 0;
+	static Common::Timer::Value s_start_time = 0;
+	static Common::Timer::Value s_stop_time = 0;
+
+#ifndef _WIN32
+	static struct sigaction s_old_sigprof;
+
+	static void SignalHandler(int sig, siginfo_t* info, void* ctx)
+	{
+		ThreadState* const state = s_current_thread;
+		if (!state)
+			return;
+
+#if defined(__APPLE__) && defined(ARCH_X86)
+		const uptr pc = static_cast<uptr>(static_cast<ucontext_t*>(ctx)->uc_mcontext->__ss.__rip);
+#elif defined(__APPLE__) && defined(ARCH_ARM64)
+		const uptr pc = static_cast<uptr>(static_cast<ucontext_t*>(ctx)->uc_mcontext->__ss.__pc);
+#elif defined(__FreeBSD__) && defined(ARCH_X86)
+		const uptr pc = static_cast<uptr>(static_cast<ucontext_t*>(ctx)->uc_mcontext.mc_rip);
+#elif defined(ARCH_X86)
+		const uptr pc = static_cast<uptr>(static_cast<ucontext_t*>(ctx)->uc_mcontext.gregs[REG_RIP]);
+#elif defined(ARCH_ARM64)
+		const uptr pc = static_cast<uptr>(static_cast<ucontext_t*>(ctx)->uc_mcontext.pc);
+#else
+		const uptr pc = 0;
+#endif
+
+		const u32 head = state->head.load(std::memory_order_relaxed);
+		state->ring[head % RING_SIZE].store(pc, std::memory_order_relaxed);
+		state->head.store(head + 1, std::memory_order_release);
+	}
+#endif
+} // namespace SamplingProfiler
+
+void SamplingProfiler::RegisterCurrentThread(const char* name)
+{
+	std::unique_lock lock(s_mutex);
+	if (s_current_thread)
+		return;
+
+	std::unique_ptr<ThreadState> state = std::make_unique<ThreadState>();
+	const auto name_it = std::find(s_thread_names.begin(), s_thread_names.end(), name);
+	state->name_index = static_cast<u32>(name_it - s_thread_names.begin());
+	if (name_it == s_thread_names.end())
+		s_thread_names.emplace_back(name);
+
+#ifdef _WIN32
+	state->handle = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_QUERY_INFORMATION, FALSE, GetCurrentThreadId());
+	if (!state->handle)
+	{
+		Console.Error("SamplingProfiler: OpenThread() failed for %s: %u", name, GetLastError());
+		return;
+	}
+#else
+	state->handle = pthread_self();
+#endif
+
+	s_current_thread = state.get();
+	s_threads.push_back(std::move(state));
+}
+
+void SamplingProfiler::UnregisterCurrentThread()
+{
+	// Clear the pointer before taking the lock, so a signal which arrives now won't touch the state.
+	ThreadState* const state = s_current_thread;
+	if (!state)
+		return;
+
+	s_current_thread = nullptr;
+	std::atomic_signal_fence(std::memory_order_seq_cst);
+
+	std::unique_lock lock(s_mutex);
+	if (s_active)
+		DrainSamples(state);
+
+#ifdef _WIN32
+	CloseHandle(state->handle);
+#endif
+
+	s_threads.erase(std::find_if(s_threads.begin(), s_threads.end(), [state](const auto& it) { return it.get() == state; }));
+}
+
+bool SamplingProfiler::Start(u32 interval_us)
+{
+	if (s_active)
+		Stop();
+
+#ifndef _WIN32
+	struct sigaction sa = {};
+	sa.sa_sigaction = SignalHandler;
+	sa.sa_flags = SA_SIGINFO | SA_RESTART;
+	sigemptyset(&sa.sa_mask);
+	if (sigaction(SIGPROF, &sa, &s_old_sigprof) != 0)
+	{
+		Console.Error("SamplingProfiler: Failed to install SIGPROF handler.");
+		return false;
+	}
+#endif
+
+	s_options = EmuConfig.Profiler;
+	s_interval_us = std::max<u32>(interval_us, 100);
+	s_samples.clear();
+	s_total_samples = 0;
+	s_dropped_samples = 0;
+	s_start_time = Common::Timer::GetCurrentValue();
+	s_stop_time = s_start_time;
+
+	Perf::SetCodeMapEnabled(true);
+
+	{
+		std::unique_lock lock(s_mutex);
+		for (const std::unique_ptr<ThreadState>& state : s_threads)
+			state->tail = state->head.load(std::memory_order_acquire);
+		s_active = true;
+	}
+
+	s_sampler_exit.store(false, std::memory_order_release);
+	s_sampler_thread = std::thread(SamplerThread, s_interval_us);
+
+	Console.WriteLn("SamplingProfiler: Started with %u us interval.", s_interval_us);
+	return true;
+}
+
+void SamplingProfiler::Stop()
+{
+	if (!s_active)
+		return;
+
+	s_sampler_exit.store(true, std::memory_order_release);
+	s_sampler_thread.join();
+
+	{
+		std::unique_lock lock(s_mutex);
+		for (const std::unique_ptr<ThreadState>& state : s_threads)
+			DrainSamples(state.get());
+		s_active = false;
+	}
+
+#ifndef _WIN32
+	sigaction(SIGPROF, &s_old_sigprof, nullptr);
+#endif
+
+	// Code which was compiled before the next start won't be in the map anyway, so free it.
+	Perf::SetCodeMapEnabled(false);
+
+	s_stop_time = Common::Timer::GetCurrentValue();
+	Console.WriteLn("SamplingProfiler: Stopped after %" PRIu64 " samples (%" PRIu64 " dropped).", s_total_samples,
+		s_dropped_samples);
+}
+
+bool SamplingProfiler::IsActive()
+{
+	return s_active;
+}
+
+void SamplingProfiler::SamplerThread(u32 interval_us)
+{
+	Threading::SetNameOfCurrentThread("Sampling Profiler");
+
+	while (!s_sampler_exit.load(std::memory_order_acquire))
+	{
+		std::this_thread::sleep_for(std::chrono::microseconds(interval_us));
+
+		std::unique_lock lock(s_mutex);
+		for (const std::unique_ptr<ThreadState>& state : s_threads)
+		{
+#ifdef _WIN32
+			if (SuspendThread(state->handle) == static_cast<DWORD>(-1))
+				continue;
+
+			CONTEXT ctx = {};
+			ctx.ContextFlags = CONTEXT_CONTROL;
+			if (GetThreadContext(state->handle, &ctx))
+			{
+#if defined(ARCH_ARM64)
+				const uptr pc = static_cast<uptr>(ctx.Pc);
+#else
+				const uptr pc = static_cast<uptr>(ctx.Rip);
+#endif
+				const u32 head = state->head.load(std::memory_order_relaxed);
+				state->ring[head % RING_SIZE].store(pc, std::memory_order_relaxed);
+				state->head.store(head + 1, std::memory_order_release);
+			}
+
+			ResumeThread(state->handle);
+#else
+			pthread_kill(state->handle, SIGPROF);
+#endif
+
+			// Signals are asynchronous, so this picks up the previous tick's sample on POSIX.
+			DrainSamples(state.get());
+		}
+	}
+}
+
+void SamplingProfiler::DrainSamples(ThreadState* state)
+{
+	const u32 head = state->head.load(std::memory_order_acquire);
+	if ((head - state->tail) > RING_SIZE)
+	{
+		s_dropped_samples += (head - state->tail) - RING_SIZE;
+		state->tail = head - RING_SIZE;
+	}
+
+	Perf::CodeInfo info;
+	for (; state->tail != head; state->tail++)
+	{
+		const uptr pc = state->ring[state->tail % RING_SIZE].load(std::memory_order_relaxed);
+
+		SampleKey key = {state->name_index, nullptr, 0, false, {}};
+		if (Perf::LookupCode(reinterpret_cast<const void*>(pc), &info))
+		{
+			key.group = info.group;
+			if (IsGroupDetailed(info.group))
+			{
+				key.pc = info.pc;
+				key.has_pc = info.has_pc;
+				key.symbol = std::move(info.symbol);
+			}
+		}
+
+		s_samples[std::move(key)]++;
+		s_total_samples++;
+	}
+}
+
+bool SamplingProfiler::IsGroupDetailed(const Perf::Group* group)
+{
+	if (group == &Perf::ee)
+		return s_options.RecBlocks_EE;
+	else if (group == &Perf::iop)
+		return s_options.RecBlocks_IOP;
+	else if (group == &Perf::vu0)
+		return s_options.RecBlocks_VU0;
+	else if (group == &Perf::vu1)
+		return s_options.RecBlocks_VU1;
+	else
+		return true;
+}
+
+const char* SamplingProfiler::GetGroupName(const Perf::Group* group)
+{
+	if (!group)
+		return "[host]";
+
+	return group->HasPrefix() ? group->GetPrefix() : "JIT";
+}
+
+std::string SamplingProfiler::GetFunctionName(const Perf::Group* group, u32 pc, bool with_offset)
+{
+	const SymbolGuardian* guardian = nullptr;
+	if (group == &Perf::ee)
+		guardian = &R5900SymbolGuardian;
+	else if (group == &Perf::iop)
+		guardian = &R3000SymbolGuardian;
+	else
+		return {};
+
+	const FunctionInfo func = guardian->FunctionOverlappingAddress(pc);
+	if (!func.address.valid() || func.name.empty())
+		return {};
+
+	if (!with_offset || pc == func.address.value)
+		return func.name;
+
+	return fmt::format("{}+0x{:X}", func.name, pc - func.address.value);
+}
+
+bool SamplingProfiler::WriteReport(const std::string& path, u32 max_entries, Error* error)
+{
+	if (s_active)
+	{
+		Error::SetString(error, "Profiler is still active.");
+		return false;
+	}
+
+	const double seconds = Common::Timer::ConvertValueToSeconds(s_stop_time - s_start_time);
+	const double total = static_cast<double>(std::max<u64>(s_total_samples, 1));
+
+	std::string out;
+	fmt::format_to(std::back_inserter(out), "Sampling profile: {} samples over {:.2f} seconds, {} us interval, {} dropped\n\n",
+		s_total_samples, seconds, s_interval_us, s_dropped_samples);
+
+	// Per thread/group breakdown.
+	std::map<std::pair<u32, std::string>, u64> groups;
+	for (const auto& [key, count] : s_samples)
+		groups[{key.thread, GetGroupName(key.group)}] += count;
+
+	out += "Thread               Group       Samples        %\n";
+	for (const auto& [key, count] : groups)
+	{
+		fmt::format_to(std::back_inserter(out), "{:<20} {:<10} {:>8} {:>7.2f}%\n", s_thread_names[key.first], key.second,
+			count, static_cast<double>(count) * 100.0 / total);
+	}
+
+	// Hottest blocks, host code is excluded since we can't say anything useful about it here.
+	std::vector<std::pair<const SampleKey*, u64>> blocks;
+	for (const auto& [key, count] : s_samples)
+	{
+		if (key.group)
+			blocks.emplace_back(&key, count);
+	}
+	std::sort(blocks.begin(), blocks.end(), [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+	if (blocks.size() > max_entries)
+		blocks.resize(max_entries);
+
+	out += "\nTop blocks:\n";
+	out += " Samples        %  Thread               Group  Block     Symbol\n";
+	std::map<std::pair<const Perf::Group*, std::string>, u64> functions;
+	for (const auto& [key, count] : blocks)
+	{
+		std::string block;
+		std::string symbol;
+		if (key->has_pc)
+		{
+			block = fmt::format("{:08X}", key->pc);
+			symbol = GetFunctionName(key->group, key->pc, true);
+		}
+		else
+		{
+			block = "--------";
+			symbol = key->symbol;
+		}
+
+		fmt::format_to(std::back_inserter(out), "{:>8} {:>7.2f}%  {:<20} {:<6} {:<9} {}\n", count,
+			static_cast<double>(count) * 100.0 / total, s_thread_names[key->thread], GetGroupName(key->group), block, symbol);
+	}
+
+	// Same thing rolled up to functions, across all blocks rather than just the top ones.
+	for (const auto& [key, count] : s_samples)
+	{
+		if (!key.group || !key.has_pc)
+			continue;
+
+		std::string name = GetFunctionName(key.group, key.pc, false);
+		if (!name.empty())
+			functions[{key.group, std::move(name)}] += count;
+	}
+
+	if (!functions.empty())
+	{
+		std::vector<std::pair<const std::pair<const Perf::Group*, std::string>*, u64>> sorted_functions;
+		for (const auto& [key, count] : functions)
+			sorted_functions.emplace_back(&key, count);
+		std::sort(sorted_functions.begin(), sorted_functions.end(),
+			[](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+		if (sorted_functions.size() > max_entries)
+			sorted_functions.resize(max_entries);
+
+		out += "\nTop functions:\n";
+		out += " Samples        %  Group  Function\n";
+		for (const auto& [key, count] : sorted_functions)
+		{
+			fmt::format_to(std::back_inserter(out), "{:>8} {:>7.2f}%  {:<6} {}\n", count,
+				static_cast<double>(count) * 100.0 / total, GetGroupName(key->first), key->second);
+		}
+	}
+
+	if (!FileSystem::WriteStringToFile(path.c_str(), out))
+	{
+		Error::SetString(error, fmt::format("Failed to write '{}'.", path));
+		return false;
+	}
+
+	return true;
+}
+
+bool SamplingProfiler::WriteFoldedStacks(const std::string& path, Error* error)
+{
+	if (s_active)
+	{
+		Error::SetString(error, "Profiler is still active.");
+		return false;
+	}
+
+	// Semicolons separate frames, so they can't appear in names.
+	const auto sanitize = [](std::string str) {
+		std::replace(str.begin(), str.end(), ';', ':');
+		return str;
+	};
+
+	std::string out;
+	for (const auto& [key, count] : s_samples)
+	{
+		out += sanitize(s_thread_names[key.thread]);
+		out += ';';
+		out += GetGroupName(key.group);
+
+		if (key.has_pc)
+		{
+			const std::string function = GetFunctionName(key.group, key.pc, false);
+			if (!function.empty())
+			{
+				out += ';';
+				out += sanitize(function);
+			}
+
+			fmt::format_to(std::back_inserter(out), ";{:08X}", key.pc);
+		}
+		else if (!key.symbol.empty())
+		{
+			out += ';';
+			out += sanitize(key.symbol);
+		}
+
+		fmt::format_to(std::back_inserter(out), " {}\n", count);
+	}
+
+	if (!FileSystem::WriteStringToFile(path.c_str(), out))
+	{
+		Error::SetString(error, fmt::format("Failed to write '{}'.", path));
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "common/Pcsx2Types.h"
+
+#include <string>
+
+class Error;
+
+// Statistical profiler for recompiled code. Registered threads are periodically interrupted,
+// their host PC is mapped back to the guest block which generated it via the Perf code map,
+// and hits are aggregated per block so hot guest code can be reported without external tools.
+namespace SamplingProfiler
+{
+	static constexpr u32 DEFAULT_INTERVAL_US = 1000;
+
+	/// Registers/unregisters the calling thread for sampling. Safe to call while the profiler is stopped.
+	void RegisterCurrentThread(const char* name);
+	void UnregisterCurrentThread();
+
+	/// Starts sampling registered threads. Clears any previously collected samples.
+	bool Start(u32 interval_us = DEFAULT_INTERVAL_US);
+
+	/// Stops sampling, collected samples are kept until the next Start().
+	void Stop();
+
+	bool IsActive();
+
+	/// Writes a text report of the hottest guest blocks and functions.
+	bool WriteReport(const std::string& path, u32 max_entries, Error* error);
+
+	/// Writes samples in folded stack format, suitable for flamegraph.pl or speedscope.
+	bool WriteFoldedStacks(const std::string& path, Error* error);
+} // namespace SamplingProfiler
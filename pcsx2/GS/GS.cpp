@@ -522,6 +522,8 @@ void GSGameChanged()
 {
 	if (GSIsHardwareRenderer())
 		GSTextureReplacements::GameChanged();
+	else if (g_gs_renderer)
+		g_gs_renderer->GameChanged();
 
 	if (!VMManager::HasValidVM() && GSCapture::IsCapturing())
 		GSCapture::EndCapture();
@@ -703,7 +705,7 @@ void GSgetStats(SmallStringBase& info)
 	{
 		if (!GSConfig.HWROV)
 		{
-			info.format("{} HW | {} PRIM | {} DRW | {} DRWC | {} BAR | {} RP | {} RB | {} TC | {} TU",
+			info.format("{} HW | {} PRIM | {} DRW | {} DRWC | {} BAR | {} RP | {} RB | {} TC | {} TU | {}/{} TW",
 				api_name,
 				(int)pm.Get(GSPerfMon::Prim),
 				(int)pm.Get(GSPerfMon::Draw),
@@ -712,12 +714,14 @@ void GSgetStats(SmallStringBase& info)
 				(int)std::ceil(pm.Get(GSPerfMon::RenderPasses)),
 				(int)std::ceil(pm.Get(GSPerfMon::Readbacks)),
 				(int)std::ceil(pm.Get(GSPerfMon::TextureCopies)),
-				(int)std::ceil(pm.Get(GSPerfMon::TextureUploads)));
+				(int)std::ceil(pm.Get(GSPerfMon::TextureUploads)),
+				(int)std::ceil(pm.Get(GSPerfMon::TargetWalks)),
+				(int)std::ceil(pm.Get(GSPerfMon::TargetWalks) + pm.Get(GSPerfMon::TargetWalksSkipped)));
 		}
 		else
 		{
 			// Add ROV stats along standard stats.
-			info.format("{} HW | {} PRIM | {} DRW | {}/{} DRWC | {}/{} BAR | {} RP | {} RB | {}/{} TC | {} TU",
+			info.format("{} HW | {} PRIM | {} DRW | {}/{} DRWC | {}/{} BAR | {} RP | {} RB | {}/{} TC | {} TU | {}/{} TW",
 				api_name,
 				(int)pm.Get(GSPerfMon::Prim),
 				(int)pm.Get(GSPerfMon::Draw),
@@ -729,7 +733,9 @@ void GSgetStats(SmallStringBase& info)
 				(int)std::ceil(pm.Get(GSPerfMon::Readbacks)),
 				(int)std::ceil(pm.Get(GSPerfMon::TextureCopies)),
 				(int)std::ceil(pm.Get(GSPerfMon::DepthCopiesROV)),
-				(int)std::ceil(pm.Get(GSPerfMon::TextureUploads)));
+				(int)std::ceil(pm.Get(GSPerfMon::TextureUploads)),
+				(int)std::ceil(pm.Get(GSPerfMon::TargetWalks)),
+				(int)std::ceil(pm.Get(GSPerfMon::TargetWalks) + pm.Get(GSPerfMon::TargetWalksSkipped)));
 		}
 	}
 }
@@ -767,6 +773,10 @@ void GSgetMemoryStats(SmallStringBase& info)
 			format_precision(sources_MB),
 			format_precision(hashcache_MB),
 			format_precision(pool_MB));
+
+		// Spilled textures live in host memory, so they're not part of the VRAM total.
+		if (const u64 spill_usage = g_texture_cache->GetHashCacheSpillMemoryUsage(); spill_usage > 0)
+			info.append_format(" | HC RAM: {} MB", format_precision(get_MB(static_cast<double>(spill_usage))));
 	}
 	else
 	{
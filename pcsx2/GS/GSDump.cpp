@@ -10,12 +10,17 @@
 #include "common/FileSystem.h"
 #include "common/HeapArray.h"
 #include "common/ScopedGuard.h"
+#include "common/Threading.h"
 
 #include <7zCrc.h>
 #include <XzCrc64.h>
 #include <XzEnc.h>
 #include <zstd.h>
 
+#include <array>
+#include <condition_variable>
+#include <mutex>
+
 GSDumpBase::GSDumpBase(std::string fn)
 	: m_filename(std::move(fn))
 	, m_frames(0)
@@ -116,6 +121,15 @@ void GSDumpBase::Write(const void* data, size_t size)
 		Console.Error("GSDump: Error failed to write data");
 }
 
+void GSDumpBase::Close()
+{
+	if (!m_gs)
+		return;
+
+	std::fclose(m_gs);
+	m_gs = nullptr;
+}
+
 //////////////////////////////////////////////////////////////////////
 // GSDump implementation
 //////////////////////////////////////////////////////////////////////
@@ -165,52 +179,160 @@ std::unique_ptr<GSDumpBase> GSDumpBase::CreateUncompressedDump(
 
 namespace
 {
-	class GsDumpBuffered : public GSDumpBase
+	// Appends to one half of a double-buffered arena on the GS thread, while the other half is compressed
+	// and written on a worker thread. The GS thread only waits when it fills a half before the worker is
+	// done with the other one, so recording a dump doesn't slow the game down to the compressor's speed.
+	class GSDumpAsync : public GSDumpBase
 	{
 	protected:
+		static constexpr size_t ARENA_BUFFER_SIZE = 8 * _1mb;
+
 		void AppendRawData(const void* data, size_t size) override final;
 		void AppendRawData(u8 c) override final;
 
-		void EnsureSpace(size_t size);
+		/// Runs on the worker thread, must read blocks with AcquireBlock() until it returns false.
+		virtual void CompressThread() = 0;
+
+		/// Waits for the next full block. Returns false when the dump has ended and all blocks have been read.
+		bool AcquireBlock(const u8** data, size_t* size);
+		void ReleaseBlock();
 
-		DynamicHeapArray<u8, 64> m_buffer;
-		size_t m_buffer_size = 0;
+		void StartWorker();
+
+		/// Submits the remaining data and waits for the worker to finish. Must be called by the derived destructor.
+		void StopWorker();
 
 	public:
-		GsDumpBuffered(std::string fn);
-		virtual ~GsDumpBuffered() override = default;
+		GSDumpAsync(std::string fn);
+		virtual ~GSDumpAsync() override;
+
+	private:
+		void SubmitBlock();
+
+		std::array<DynamicHeapArray<u8, 64>, 2> m_buffers;
+		size_t m_write_pos = 0;
+		u32 m_write_index = 0;
+		u32 m_read_index = 0;
+		u32 m_stalls = 0;
+
+		std::mutex m_mutex;
+		std::condition_variable m_block_ready_cv;
+		std::condition_variable m_block_done_cv;
+		std::array<size_t, 2> m_pending_size = {};
+		std::array<bool, 2> m_pending = {};
+		bool m_finished = false;
+
+		Threading::Thread m_worker;
 	};
 
-	GsDumpBuffered::GsDumpBuffered(std::string fn)
+	GSDumpAsync::GSDumpAsync(std::string fn)
 		: GSDumpBase(std::move(fn))
 	{
-		m_buffer.resize(_1mb);
+		for (auto& buffer : m_buffers)
+			buffer.resize(ARENA_BUFFER_SIZE);
+	}
+
+	GSDumpAsync::~GSDumpAsync()
+	{
+		pxAssertMsg(!m_worker.Joinable(), "StopWorker() not called by derived class");
 	}
 
-	void GsDumpBuffered::AppendRawData(const void* data, size_t size)
+	void GSDumpAsync::AppendRawData(const void* data, size_t size)
 	{
-		if (size == 0) [[unlikely]]
+		// Nothing would consume the blocks without a worker.
+		if (!IsOpen())
 			return;
 
-		EnsureSpace(size);
-		std::memcpy(&m_buffer[m_buffer_size], data, size);
-		m_buffer_size += size;
+		const u8* ptr = static_cast<const u8*>(data);
+		while (size > 0)
+		{
+			const size_t copy = std::min(size, ARENA_BUFFER_SIZE - m_write_pos);
+			std::memcpy(&m_buffers[m_write_index][m_write_pos], ptr, copy);
+			m_write_pos += copy;
+			ptr += copy;
+			size -= copy;
+
+			if (m_write_pos == ARENA_BUFFER_SIZE)
+				SubmitBlock();
+		}
 	}
 
-	void GsDumpBuffered::AppendRawData(u8 c)
+	void GSDumpAsync::AppendRawData(u8 c)
 	{
-		EnsureSpace(1);
-		m_buffer[m_buffer_size++] = c;
+		if (!IsOpen())
+			return;
+
+		m_buffers[m_write_index][m_write_pos++] = c;
+		if (m_write_pos == ARENA_BUFFER_SIZE)
+			SubmitBlock();
 	}
 
-	void GsDumpBuffered::EnsureSpace(size_t size)
+	void GSDumpAsync::SubmitBlock()
 	{
-		const size_t new_size = m_buffer_size + size;
-		if (new_size <= m_buffer.size())
+		std::unique_lock lock(m_mutex);
+		m_pending_size[m_write_index] = m_write_pos;
+		m_pending[m_write_index] = true;
+		m_block_ready_cv.notify_one();
+
+		m_write_index ^= 1;
+		m_write_pos = 0;
+		if (m_pending[m_write_index])
+		{
+			m_stalls++;
+			m_block_done_cv.wait(lock, [this]() { return !m_pending[m_write_index]; });
+		}
+	}
+
+	bool GSDumpAsync::AcquireBlock(const u8** data, size_t* size)
+	{
+		std::unique_lock lock(m_mutex);
+		m_block_ready_cv.wait(lock, [this]() { return m_pending[m_read_index] || m_finished; });
+		if (!m_pending[m_read_index])
+			return false;
+
+		*data = m_buffers[m_read_index].data();
+		*size = m_pending_size[m_read_index];
+		return true;
+	}
+
+	void GSDumpAsync::ReleaseBlock()
+	{
+		std::unique_lock lock(m_mutex);
+		m_pending[m_read_index] = false;
+		m_read_index ^= 1;
+		m_block_done_cv.notify_one();
+	}
+
+	void GSDumpAsync::StartWorker()
+	{
+		if (!m_worker.Start([this]() {
+				Threading::SetNameOfCurrentThread("GS Dump Compressor");
+				CompressThread();
+			}))
+		{
+			Console.ErrorFmt("GSDump: Failed to start compressor thread for {}", GetPath());
+			Close();
+		}
+	}
+
+	void GSDumpAsync::StopWorker()
+	{
+		if (!m_worker.Joinable())
 			return;
 
-		const size_t alloc_size = std::max(m_buffer.size() * 2, new_size);
-		m_buffer.resize(alloc_size);
+		if (m_write_pos > 0)
+			SubmitBlock();
+
+		{
+			std::unique_lock lock(m_mutex);
+			m_finished = true;
+			m_block_ready_cv.notify_one();
+		}
+
+		m_worker.Join();
+
+		if (m_stalls > 0)
+			DevCon.WarningFmt("GSDump: Waited for the compressor {} times.", m_stalls);
 	}
 } // namespace
 
@@ -219,9 +341,11 @@ namespace
 //////////////////////////////////////////////////////////////////////
 namespace
 {
-	class GSDumpXz final : public GsDumpBuffered
+	class GSDumpXz final : public GSDumpAsync
 	{
-		void Compress();
+		static constexpr u64 BLOCK_SIZE = 16 * _1mb;
+
+		void CompressThread() override;
 
 	public:
 		GSDumpXz(const std::string& fn, const std::string& serial, u32 crc,
@@ -233,39 +357,61 @@ namespace
 	GSDumpXz::GSDumpXz(const std::string& fn, const std::string& serial, u32 crc,
 		u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
 		const freezeData& fd, const GSPrivRegSet* regs)
-		: GsDumpBuffered(fn + ".gs.xz")
+		: GSDumpAsync(fn + ".gs.xz")
 	{
+		StartWorker();
 		AddHeader(serial, crc, screenshot_width, screenshot_height, screenshot_pixels, fd, regs);
 	}
 
 	GSDumpXz::~GSDumpXz()
 	{
-		Compress();
+		StopWorker();
 	}
 
-	void GSDumpXz::Compress()
+	void GSDumpXz::CompressThread()
 	{
-		struct MemoryInStream
+		// The encoder pulls its input, so feed it blocks from the arena as they're filled.
+		struct ArenaInStream
 		{
 			ISeqInStream vt;
-			const u8* buffer;
-			size_t buffer_size;
+			GSDumpXz* real;
+			const u8* block;
+			size_t block_size;
 			size_t read_pos;
+			bool acquired;
 		};
-		MemoryInStream mis = {
+		ArenaInStream ais = {
 			{.Read = [](const ISeqInStream* p, void* buf, size_t* size) -> SRes {
-				MemoryInStream* mis = Z7_CONTAINER_FROM_VTBL(p, MemoryInStream, vt);
-				const size_t avail = mis->buffer_size - mis->read_pos;
-				const size_t copy = std::min(avail, *size);
-
-				std::memcpy(buf, &mis->buffer[mis->read_pos], copy);
-				mis->read_pos += copy;
+				ArenaInStream* ais = Z7_CONTAINER_FROM_VTBL(p, ArenaInStream, vt);
+				if (ais->acquired && ais->read_pos == ais->block_size)
+				{
+					ais->real->ReleaseBlock();
+					ais->acquired = false;
+				}
+
+				if (!ais->acquired)
+				{
+					if (!ais->real->AcquireBlock(&ais->block, &ais->block_size))
+					{
+						*size = 0;
+						return SZ_OK;
+					}
+
+					ais->read_pos = 0;
+					ais->acquired = true;
+				}
+
+				const size_t copy = std::min(ais->block_size - ais->read_pos, *size);
+				std::memcpy(buf, &ais->block[ais->read_pos], copy);
+				ais->read_pos += copy;
 				*size = copy;
 				return SZ_OK;
 			}},
-			m_buffer.data(),
-			m_buffer_size,
-			0};
+			this,
+			nullptr,
+			0,
+			0,
+			false};
 
 		struct DumpOutStream
 		{
@@ -280,18 +426,24 @@ namespace
 			}},
 			this};
 
-		pxAssert(m_buffer_size > 0);
-
 		GSInit7ZCRCTables();
 
 		CXzProps props;
 		XzProps_Init(&props);
-		const SRes res = Xz_Encode(&dos.vt, &mis.vt, &props, nullptr);
+
+		// Split into multiple blocks, so the reader can seek without decompressing the whole stream.
+		props.blockSize = BLOCK_SIZE;
+		const SRes res = Xz_Encode(&dos.vt, &ais.vt, &props, nullptr);
 		if (res != SZ_OK)
-		{
 			Console.ErrorFmt("Xz_Encode() failed: {}", static_cast<int>(res));
-			return;
-		}
+
+		// Don't leave the GS thread waiting on a block if the encoder bailed out early.
+		const u8* block;
+		size_t block_size;
+		if (ais.acquired)
+			ReleaseBlock();
+		while (AcquireBlock(&block, &block_size))
+			ReleaseBlock();
 	}
 } // namespace
 
@@ -311,17 +463,21 @@ std::unique_ptr<GSDumpBase> GSDumpBase::CreateXzDump(
 
 namespace
 {
-	class GSDumpZst final : public GSDumpBase
+	class GSDumpZst final : public GSDumpAsync
 	{
+		// Frames are closed periodically, so the reader can seek without decompressing the whole stream.
+		static constexpr size_t FRAME_SIZE = 16 * _1mb;
+
+		// Compression runs off the GS thread already, a couple of extra workers is enough to keep up.
+		static constexpr int COMPRESSION_WORKERS = 2;
+
 		ZSTD_CStream* m_strm;
 
-		std::vector<u8> m_in_buff;
 		std::vector<u8> m_out_buff;
+		size_t m_frame_size = 0;
 
-		void MayFlush();
-		void Compress(ZSTD_EndDirective action);
-		void AppendRawData(const void* data, size_t size);
-		void AppendRawData(u8 c);
+		void CompressThread() override;
+		bool Compress(const u8* data, size_t size, ZSTD_EndDirective action);
 
 	public:
 		GSDumpZst(const std::string& fn, const std::string& serial, u32 crc,
@@ -333,53 +489,57 @@ namespace
 	GSDumpZst::GSDumpZst(const std::string& fn, const std::string& serial, u32 crc,
 		u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
 		const freezeData& fd, const GSPrivRegSet* regs)
-		: GSDumpBase(fn + ".gs.zst")
+		: GSDumpAsync(fn + ".gs.zst")
 	{
 		m_strm = ZSTD_createCStream();
 
 		// Compression level 6 provides a good balance between speed and ratio.
 		ZSTD_CCtx_setParameter(m_strm, ZSTD_c_compressionLevel, 6);
 
-		m_in_buff.reserve(_1mb);
+		// Fails when libzstd is built without threading, in which case it just compresses on our worker.
+		const size_t res = ZSTD_CCtx_setParameter(m_strm, ZSTD_c_nbWorkers, COMPRESSION_WORKERS);
+		if (ZSTD_isError(res))
+			DevCon.WarningFmt("GSDumpZstd: Multithreaded compression unavailable: {}", ZSTD_getErrorName(res));
+
 		m_out_buff.resize(_1mb);
 
+		StartWorker();
 		AddHeader(serial, crc, screenshot_width, screenshot_height, screenshot_pixels, fd, regs);
 	}
 
 	GSDumpZst::~GSDumpZst()
 	{
-		// Finish the stream
-		Compress(ZSTD_e_end);
+		StopWorker();
 
 		ZSTD_freeCStream(m_strm);
 	}
 
-	void GSDumpZst::AppendRawData(const void* data, size_t size)
+	void GSDumpZst::CompressThread()
 	{
-		size_t old_size = m_in_buff.size();
-		m_in_buff.resize(old_size + size);
-		memcpy(&m_in_buff[old_size], data, size);
-		MayFlush();
-	}
+		bool okay = true;
+		const u8* block;
+		size_t block_size;
+		while (AcquireBlock(&block, &block_size))
+		{
+			// Keep consuming blocks after an error, otherwise the GS thread would wait forever.
+			if (okay)
+			{
+				const bool end_frame = (m_frame_size + block_size) >= FRAME_SIZE;
+				m_frame_size = end_frame ? 0 : (m_frame_size + block_size);
+				okay = Compress(block, block_size, end_frame ? ZSTD_e_end : ZSTD_e_continue);
+			}
 
-	void GSDumpZst::AppendRawData(u8 c)
-	{
-		m_in_buff.push_back(c);
-		MayFlush();
-	}
+			ReleaseBlock();
+		}
 
-	void GSDumpZst::MayFlush()
-	{
-		if (m_in_buff.size() >= _1mb)
-			Compress(ZSTD_e_continue);
+		// Finish the stream
+		if (okay && m_frame_size > 0)
+			Compress(nullptr, 0, ZSTD_e_end);
 	}
 
-	void GSDumpZst::Compress(ZSTD_EndDirective action)
+	bool GSDumpZst::Compress(const u8* data, size_t size, ZSTD_EndDirective action)
 	{
-		if (m_in_buff.empty())
-			return;
-
-		ZSTD_inBuffer inbuf = {m_in_buff.data(), m_in_buff.size(), 0};
+		ZSTD_inBuffer inbuf = {data, size, 0};
 
 		for (;;)
 		{
@@ -389,7 +549,7 @@ namespace
 			if (ZSTD_isError(remaining))
 			{
 				Console.ErrorFmt("GSDumpZstd: Error {}", ZSTD_getErrorName(remaining));
-				return;
+				return false;
 			}
 
 			if (outbuf.pos > 0)
@@ -412,7 +572,7 @@ namespace
 			}
 		}
 
-		m_in_buff.clear();
+		return true;
 	}
 } // namespace
 
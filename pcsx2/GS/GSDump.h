@@ -54,6 +54,10 @@ protected:
 		const freezeData& fd, const GSPrivRegSet* regs);
 	void Write(const void* data, size_t size);
 
+	/// Closes the file early, the dump ends at the next VSync.
+	void Close();
+	__fi bool IsOpen() const { return (m_gs != nullptr); }
+
 	virtual void AppendRawData(const void* data, size_t size) = 0;
 	virtual void AppendRawData(u8 c) = 0;
 
@@ -21,6 +21,7 @@
 #include <XzCrc64.h>
 #include <zstd.h>
 
+#include <algorithm>
 #include <mutex>
 
 using namespace GSDumpTypes;
@@ -70,7 +71,7 @@ bool GSDumpFile::GetPreviewImageFromDump(const char* filename, u32* width, u32*
 	return true;
 }
 
-bool GSDumpFile::ReadFile(Error* error)
+bool GSDumpFile::ReadHeader(Error* error)
 {
 	u32 ss;
 	if (Read(&m_crc, sizeof(m_crc)) != sizeof(m_crc) || Read(&ss, sizeof(ss)) != sizeof(ss))
@@ -128,110 +129,96 @@ bool GSDumpFile::ReadFile(Error* error)
 		return false;
 	}
 
-	// read all the packet data in
-	// TODO: make this suck less by getting the full/extracted size and preallocating
-	for (;;)
+	m_packets_start = Tell();
+	return true;
+}
+
+bool GSDumpFile::ReadPacket(GSData* packet, Error* error)
+{
+	u8 id;
+	if (Read(&id, sizeof(id)) != sizeof(id))
 	{
-		const size_t packet_data_size = m_packet_data.size();
-		m_packet_data.resize(std::max<size_t>(packet_data_size * 2, 8 * _1mb));
+		if (!IsEof())
+			Error::SetString(error, TRANSLATE_STR("GSDumpFile", "Failed to read byte."));
+
+		return false;
+	}
 
-		const size_t read_size = m_packet_data.size() - packet_data_size;
-		const size_t read = Read(m_packet_data.data() + packet_data_size, read_size);
-		if (read != read_size)
+	packet->id = static_cast<GSType>(id);
+	packet->path = GSTransferPath::Dummy;
+	packet->data = nullptr;
+
+	switch (packet->id)
+	{
+		case GSType::Transfer:
 		{
-			if (!IsEof())
+			u32 length;
+			if (Read(&packet->path, sizeof(packet->path)) != sizeof(packet->path) ||
+				Read(&length, sizeof(length)) != sizeof(length))
 			{
-				Error::SetString(error, TRANSLATE_STR("GSDumpFile", "Failed to read packet."));
+				if (!IsEof())
+					Error::SetString(error, TRANSLATE_STR("GSDumpFile", "Failed to read word."));
+
 				return false;
 			}
 
-			m_packet_data.resize(packet_data_size + read);
-			m_packet_data.shrink_to_fit();
-			break;
+			packet->length = length;
 		}
+		break;
+		case GSType::VSync:
+			packet->length = 1;
+			break;
+		case GSType::ReadFIFO2:
+			packet->length = 4;
+			break;
+		case GSType::Registers:
+			packet->length = 8192;
+			break;
+		default:
+			Error::SetStringFmt(error,
+				TRANSLATE_FS("GSDumpFile", "Unknown packet type {}"), static_cast<u32>(packet->id));
+			return false;
 	}
 
-	u8* data = m_packet_data.data();
-	size_t remaining = m_packet_data.size();
-
-#define GET_BYTE(dst) \
-	do \
-	{ \
-		if (remaining < sizeof(u8)) \
-		{ \
-			Error::SetString(error, TRANSLATE_STR("GSDumpFile", "Failed to read byte.")); \
-			return false; \
-		} \
-		std::memcpy(dst, data, sizeof(u8)); \
-		data++; \
-		remaining--; \
-	} while (0)
-#define GET_WORD(dst) \
-	do \
-	{ \
-		if (remaining < sizeof(u32)) \
-		{ \
-			Error::SetString(error, TRANSLATE_STR("GSDumpFile", "Failed to read word.")); \
-			return false; \
-		} \
-		std::memcpy(dst, data, sizeof(u32)); \
-		data += sizeof(u32); \
-		remaining -= sizeof(u32); \
-	} while (0)
-
-	while (remaining > 0)
-	{
-		GSData packet = {};
-		packet.path = GSTransferPath::Dummy;
-		GET_BYTE(&packet.id);
-
-		switch (packet.id)
-		{
-			case GSType::Transfer:
-				GET_BYTE(&packet.path);
-				GET_WORD(&packet.length);
-				break;
-			case GSType::VSync:
-				packet.length = 1;
-				break;
-			case GSType::ReadFIFO2:
-				packet.length = 4;
-				break;
-			case GSType::Registers:
-				packet.length = 8192;
-				break;
-			default:
-				Error::SetStringFmt(error,
-					TRANSLATE_FS("GSDumpFile", "Unknown packet type {}"), static_cast<u32>(packet.id));
-				return false;
-		}
+	if (packet->length > 0)
+	{
+		// Path1Old replays read from the end of a 16KB window, so never hand out anything smaller.
+		if (m_packet_data.size() < std::max<size_t>(packet->length, 16384))
+			m_packet_data.resize(std::max<size_t>(packet->length, 16384));
 
-		if (packet.length > 0)
+		const size_t read = Read(m_packet_data.data(), packet->length);
+		if (read != packet->length)
 		{
-			if (remaining < packet.length)
+			if (!IsEof())
 			{
-				// There's apparently some "bad" dumps out there that are missing bytes on the end..
-				// The "safest" option here is to discard the last packet, since that has less risk
-				// of leaving the GS in the middle of a command.
-				Console.Error("(GSDump) Dropping last packet of %u bytes (we only have %u bytes)",
-					static_cast<u32>(packet.length), static_cast<u32>(remaining));
-				break;
+				Error::SetString(error, TRANSLATE_STR("GSDumpFile", "Failed to read packet."));
+				return false;
 			}
 
-			packet.data = data;
-			data += packet.length;
-			remaining -= packet.length;
+			// There's apparently some "bad" dumps out there that are missing bytes on the end..
+			// The "safest" option here is to discard the last packet, since that has less risk
+			// of leaving the GS in the middle of a command.
+			Console.Error("(GSDump) Dropping last packet of %u bytes (we only have %u bytes)",
+				static_cast<u32>(packet->length), static_cast<u32>(read));
+			return false;
 		}
 
-		m_dump_packets.push_back(std::move(packet));
+		packet->data = m_packet_data.data();
 	}
 
-#undef GET_WORD
-#undef GET_BYTE
-
 	return true;
 }
 
+u64 GSDumpFile::GetPacketPosition()
+{
+	return Tell() - m_packets_start;
+}
+
+bool GSDumpFile::SeekPackets(u64 offset)
+{
+	return Seek(m_packets_start + offset);
+}
+
 /******************************************************************/
 
 static std::once_flag s_lzma_crc_table_init;
@@ -256,6 +243,8 @@ namespace
 		bool Open(FileSystem::ManagedCFilePtr fp, Error* error) override;
 		bool IsEof() override;
 		size_t Read(void* ptr, size_t size) override;
+		u64 Tell() override;
+		bool Seek(u64 offset) override;
 
 	private:
 		static constexpr size_t kInputBufSize = static_cast<size_t>(1) << 18;
@@ -271,7 +260,6 @@ namespace
 
 		bool DecompressNextBlock();
 
-
 		std::vector<Block> m_blocks;
 		size_t m_stream_size = 0;
 
@@ -466,6 +454,50 @@ namespace
 		return size - remain;
 	}
 
+	u64 GSDumpLzma::Tell()
+	{
+		return (m_block_index > 0) ? (m_blocks[m_block_index - 1].stream_offset + m_block_pos) : 0;
+	}
+
+	bool GSDumpLzma::Seek(u64 offset)
+	{
+		if (offset > m_stream_size)
+			return false;
+
+		// Still inside the block we have decompressed?
+		if (m_block_index > 0)
+		{
+			const Block& current = m_blocks[m_block_index - 1];
+			if (offset >= current.stream_offset && offset <= (current.stream_offset + m_block_size))
+			{
+				m_block_pos = static_cast<size_t>(offset - current.stream_offset);
+				return true;
+			}
+		}
+
+		// Blocks are sorted by stream offset, so find the last one starting at or before the target.
+		const auto it = std::upper_bound(m_blocks.begin(), m_blocks.end(), offset,
+			[](u64 value, const Block& block) { return value < block.stream_offset; });
+		if (offset == m_stream_size)
+		{
+			// Seeking to the very end, nothing to decompress.
+			m_block_index = m_blocks.size();
+			m_block_size = m_blocks.back().uncompressed_size;
+			m_block_pos = m_block_size;
+			return true;
+		}
+
+		m_block_index = static_cast<size_t>(std::distance(m_blocks.begin(), it)) - 1;
+		m_block_size = 0;
+		m_block_pos = 0;
+
+		if (!DecompressNextBlock())
+			return false;
+
+		m_block_pos = static_cast<size_t>(offset - m_blocks[m_block_index - 1].stream_offset);
+		return true;
+	}
+
 	/******************************************************************/
 
 	class GSDumpDecompressZst final : public GSDumpFile
@@ -473,15 +505,27 @@ namespace
 		static constexpr u32 INPUT_BUFFER_SIZE = 512 * _1kb;
 		static constexpr u32 OUTPUT_BUFFER_SIZE = 2 * _1mb;
 
+		// zstd frames don't carry an index, so we learn where they start as we decode them.
+		struct Frame
+		{
+			u64 file_offset;
+			u64 stream_offset;
+		};
+
 		ZSTD_DStream* m_strm = nullptr;
 		ZSTD_inBuffer m_inbuf = {};
+		u64 m_inbuf_file_offset = 0;
 
 		uint8_t* m_area = nullptr;
 
 		size_t m_avail = 0;
 		size_t m_start = 0;
+		u64 m_area_stream_offset = 0;
+
+		std::vector<Frame> m_frames;
 
 		bool Decompress();
+		void RecordFrame(u64 file_offset, u64 stream_offset);
 
 	public:
 		GSDumpDecompressZst();
@@ -490,6 +534,8 @@ namespace
 		bool Open(FileSystem::ManagedCFilePtr fp, Error* error) override;
 		bool IsEof() override;
 		size_t Read(void* ptr, size_t size) override;
+		u64 Tell() override;
+		bool Seek(u64 offset) override;
 	};
 
 	GSDumpDecompressZst::GSDumpDecompressZst() = default;
@@ -514,19 +560,32 @@ namespace
 		m_inbuf.src = static_cast<uint8_t*>(_aligned_malloc(INPUT_BUFFER_SIZE, 32));
 		m_inbuf.pos = 0;
 		m_inbuf.size = 0;
+		m_inbuf_file_offset = 0;
 		m_avail = 0;
 		m_start = 0;
+		m_area_stream_offset = 0;
+		m_frames.push_back(Frame{0, 0});
 		return true;
 	}
 
+	void GSDumpDecompressZst::RecordFrame(u64 file_offset, u64 stream_offset)
+	{
+		// Frames are discovered in order, unless we're re-decoding after a backwards seek.
+		if (m_frames.back().file_offset < file_offset)
+			m_frames.push_back(Frame{file_offset, stream_offset});
+	}
+
 	bool GSDumpDecompressZst::Decompress()
 	{
+		m_area_stream_offset += m_start + m_avail;
+
 		ZSTD_outBuffer outbuf = {m_area, OUTPUT_BUFFER_SIZE, 0};
 		while (outbuf.pos == 0)
 		{
 			// Nothing left in the input buffer. Read data from the file
 			if (m_inbuf.pos == m_inbuf.size && !std::feof(m_fp.get()))
 			{
+				m_inbuf_file_offset += m_inbuf.size;
 				m_inbuf.size = fread(const_cast<void*>(m_inbuf.src), 1, INPUT_BUFFER_SIZE, m_fp.get());
 				m_inbuf.pos = 0;
 
@@ -543,6 +602,14 @@ namespace
 				Console.Error("Decoder error: (error code %s)", ZSTD_getErrorName(ret));
 				return false;
 			}
+
+			// Decoder stops at the end of each frame, so this is the start of the next one.
+			if (ret == 0)
+				RecordFrame(m_inbuf_file_offset + m_inbuf.pos, m_area_stream_offset + outbuf.pos);
+
+			// Truncated stream, avoid spinning forever.
+			if (outbuf.pos == 0 && m_inbuf.pos == m_inbuf.size && std::feof(m_fp.get()))
+				break;
 		}
 
 		m_start = 0;
@@ -565,6 +632,9 @@ namespace
 			{
 				if (!Decompress()) [[unlikely]]
 					break;
+
+				if (m_avail == 0)
+					break;
 			}
 
 			const size_t l = std::min(size, m_avail);
@@ -578,6 +648,54 @@ namespace
 		return off;
 	}
 
+	u64 GSDumpDecompressZst::Tell()
+	{
+		return m_area_stream_offset + m_start;
+	}
+
+	bool GSDumpDecompressZst::Seek(u64 offset)
+	{
+		// Within the window we already have decompressed?
+		if (offset >= m_area_stream_offset && offset <= (m_area_stream_offset + m_start + m_avail))
+		{
+			const size_t new_start = static_cast<size_t>(offset - m_area_stream_offset);
+			m_avail = (m_start + m_avail) - new_start;
+			m_start = new_start;
+			return true;
+		}
+
+		// Restart decoding from the closest frame we know about, unless we're already past it.
+		const auto it = std::upper_bound(m_frames.begin(), m_frames.end(), offset,
+			[](u64 value, const Frame& frame) { return value < frame.stream_offset; });
+		const Frame& frame = *(it - 1);
+		if (offset < Tell() || frame.stream_offset > Tell())
+		{
+			if (FileSystem::FSeek64(m_fp.get(), static_cast<s64>(frame.file_offset), SEEK_SET) != 0)
+				return false;
+
+			ZSTD_DCtx_reset(m_strm, ZSTD_reset_session_only);
+			m_inbuf.pos = 0;
+			m_inbuf.size = 0;
+			m_inbuf_file_offset = frame.file_offset;
+			m_area_stream_offset = frame.stream_offset;
+			m_start = 0;
+			m_avail = 0;
+		}
+
+		// Skip forward through the frame to the requested offset.
+		while (Tell() < offset)
+		{
+			if (m_avail == 0 && (!Decompress() || m_avail == 0))
+				return false;
+
+			const size_t skip = static_cast<size_t>(std::min<u64>(offset - Tell(), m_avail));
+			m_start += skip;
+			m_avail -= skip;
+		}
+
+		return true;
+	}
+
 	/******************************************************************/
 
 	class GSDumpRaw final : public GSDumpFile
@@ -589,6 +707,8 @@ namespace
 		bool Open(FileSystem::ManagedCFilePtr fp, Error* error) override;
 		bool IsEof() override;
 		size_t Read(void* ptr, size_t size) override;
+		u64 Tell() override;
+		bool Seek(u64 offset) override;
 	};
 
 	GSDumpRaw::GSDumpRaw() = default;
@@ -616,6 +736,16 @@ namespace
 
 		return ret;
 	}
+
+	u64 GSDumpRaw::Tell()
+	{
+		return static_cast<u64>(std::max<s64>(FileSystem::FTell64(m_fp.get()), 0));
+	}
+
+	bool GSDumpRaw::Seek(u64 offset)
+	{
+		return (FileSystem::FSeek64(m_fp.get(), static_cast<s64>(offset), SEEK_SET) == 0);
+	}
 } // namespace
 
 /******************************************************************/
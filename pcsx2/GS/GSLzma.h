@@ -281,7 +281,6 @@ public:
 	};
 
 	using ByteArray = std::vector<u8>;
-	using GSDataArray = std::vector<GSData>;
 
 	virtual ~GSDumpFile();
 
@@ -293,9 +292,23 @@ public:
 
 	__fi const ByteArray& GetRegsData() const { return m_regs_data; }
 	__fi const ByteArray& GetStateData() const { return m_state_data; }
-	__fi const GSDataArray& GetPackets() const { return m_dump_packets; }
 
-	bool ReadFile(Error* error);
+	/// Reads the dump header, state and registers. Packets are decoded on demand through ReadPacket().
+	bool ReadHeader(Error* error);
+
+	/// Decodes the next packet. The returned data pointer is only valid until the next ReadPacket()/SeekPackets().
+	/// Returns false without setting an error when the end of the packet stream has been reached.
+	bool ReadPacket(GSData* packet, Error* error);
+
+	/// Returns the offset of the next packet, relative to the start of the packet stream.
+	u64 GetPacketPosition();
+
+	/// Moves to a packet boundary previously returned by GetPacketPosition(). Only the compressed
+	/// block/frame containing the offset is decoded, not the whole stream leading up to it.
+	bool SeekPackets(u64 offset);
+
+	/// Restarts playback from the first packet.
+	__fi bool RewindPackets() { return SeekPackets(0); }
 
 protected:
 	GSDumpFile();
@@ -304,6 +317,10 @@ protected:
 	virtual bool IsEof() = 0;
 	virtual size_t Read(void* ptr, size_t size) = 0;
 
+	/// Position in the decompressed stream.
+	virtual u64 Tell() = 0;
+	virtual bool Seek(u64 offset) = 0;
+
 protected:
 	FileSystem::ManagedCFilePtr m_fp;
 
@@ -313,9 +330,10 @@ private:
 
 	std::vector<u8> m_regs_data;
 	std::vector<u8> m_state_data;
-	std::vector<u8> m_packet_data;
 
-	GSDataArray m_dump_packets;
+	/// Holds the payload of the most recently read packet, so only one packet is resident at a time.
+	std::vector<u8> m_packet_data;
+	u64 m_packets_start = 0;
 };
 
 // Initializes CRC tables used by LZMA SDK.
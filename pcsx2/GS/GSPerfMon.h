@@ -26,6 +26,8 @@ public:
 		DepthCopiesROV, // Overlaps with regular texture copies.
 		DrawCallsROV, // Overlaps with regular draw calls.
 		BarriersROV, // Overlaps with regular barriers.
+		TargetWalks, // Target list walks in invalidations and lookups.
+		TargetWalksSkipped, // Walks skipped because no target covers the pages.
 		CounterLast,
 
 		// Reused counters for HW.
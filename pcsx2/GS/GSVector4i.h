@@ -970,6 +970,11 @@ public:
 		return GSVector4i(_mm_mulhrs_epi16(m, v.m));
 	}
 
+	__forceinline GSVector4i mul32l(const GSVector4i& v) const
+	{
+		return GSVector4i(_mm_mullo_epi32(m, v.m));
+	}
+
 	GSVector4i madd(const GSVector4i& v) const
 	{
 		return GSVector4i(_mm_madd_epi16(m, v.m));
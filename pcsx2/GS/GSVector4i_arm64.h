@@ -948,6 +948,11 @@ public:
 		return GSVector4i(vreinterpretq_s32_s16(vcombine_s16(narrow_lo, narrow_hi)));
 	}
 
+	__forceinline GSVector4i mul32l(const GSVector4i& v) const
+	{
+		return GSVector4i(vmulq_s32(v4s, v.v4s));
+	}
+
 	template <int shift>
 	__forceinline GSVector4i lerp16(const GSVector4i& a, const GSVector4i& f) const
 	{
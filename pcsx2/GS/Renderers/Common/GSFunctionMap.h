@@ -9,6 +9,7 @@
 #include "common/HostSys.h"
 
 #include <cinttypes>
+#include <unordered_set>
 
 template <class KEY, class VALUE>
 class GSFunctionMap
@@ -67,6 +68,16 @@ public:
 		return m_active->f;
 	}
 
+	/// Forgets which functions were looked up, so the next lookup of each key goes through GetDefaultFunction() again.
+	void ClearActive()
+	{
+		for (auto& i : m_map_active)
+			delete i.second;
+
+		m_map_active.clear();
+		m_active = NULL;
+	}
+
 	void UpdateStats(u64 frame, u64 ticks, int actual, int total, int prims)
 	{
 		if (m_active)
@@ -142,6 +153,8 @@ namespace GSCodeReserve
 	void ResetMemory();
 
 	size_t GetMemoryUsed();
+	size_t GetMemoryFree();
+	size_t GetMemorySize();
 
 	u8* ReserveMemory(size_t size);
 	void CommitMemory(size_t size);
@@ -152,6 +165,7 @@ class GSCodeGeneratorFunctionMap : public GSFunctionMap<KEY, VALUE>
 {
 	std::string m_name;
 	std::unordered_map<u64, VALUE> m_cgmap;
+	std::unordered_set<u64> m_keys;
 
 	enum { MAX_SIZE = 8192 };
 
@@ -168,6 +182,24 @@ public:
 		m_cgmap.clear();
 	}
 
+	/// Every key looked up or added since the last ClearKeys(), including ones flushed from the code cache since.
+	const std::unordered_set<u64>& GetKeys() const
+	{
+		return m_keys;
+	}
+
+	void AddKey(u64 key)
+	{
+		m_keys.insert(key);
+	}
+
+	/// Also forgets the active functions, so keys which were generated before still get recorded on their next use.
+	void ClearKeys()
+	{
+		m_keys.clear();
+		this->ClearActive();
+	}
+
 	VALUE GetDefaultFunction(KEY key)
 	{
 		VALUE ret = nullptr;
@@ -177,6 +209,7 @@ public:
 		if (i != m_cgmap.end())
 		{
 			ret = i->second;
+			m_keys.insert(key);
 		}
 		else
 		{
@@ -202,6 +235,7 @@ public:
 			ret = (VALUE)cg.GetCode();
 
 			m_cgmap[key] = ret;
+			m_keys.insert(key);
 		}
 
 		return ret;
@@ -3769,6 +3769,7 @@ void GSRendererHW::Draw()
 			if (vertical_offset < 0)
 			{
 				ds->m_TEX0.TBP0 = m_cached_ctx.ZBUF.Block();
+				g_texture_cache->InvalidateTargetPages();
 				GSVector2i new_size = ds->m_unscaled_size;
 				// Make sure to use the original format for the offset.
 				const int new_offset = std::abs((vertical_offset / zbuf_psm.pgs.y) * GSLocalMemory::m_psm[ds->m_TEX0.PSM].pgs.y);
@@ -3816,6 +3817,7 @@ void GSRendererHW::Draw()
 				// Thankfully this doesn't really happen, but catwoman moves the framebuffer backwards 1 page with a channel shuffle, which is really messy and not easy to deal with.
 				// Hopefully the quick channel shuffle will just guess this and run with it.
 				ds->m_TEX0.TBP0 += horizontal_offset;
+				g_texture_cache->InvalidateTargetPages();
 				horizontal_offset = 0;
 			}
 
@@ -4066,6 +4068,7 @@ void GSRendererHW::Draw()
 			if (vertical_offset < 0)
 			{
 				rt->m_TEX0.TBP0 = m_cached_ctx.FRAME.Block();
+				g_texture_cache->InvalidateTargetPages();
 				GSVector2i new_size = rt->m_unscaled_size;
 				// Make sure to use the original format for the offset.
 				const int new_offset = std::abs((vertical_offset / frame_psm.pgs.y) * GSLocalMemory::m_psm[rt->m_TEX0.PSM].pgs.y);
@@ -4113,6 +4116,7 @@ void GSRendererHW::Draw()
 				// Thankfully this doesn't really happen, but catwoman moves the framebuffer backwards 1 page with a channel shuffle, which is really messy and not easy to deal with.
 				// Hopefully the quick channel shuffle will just guess this and run with it.
 				rt->m_TEX0.TBP0 += horizontal_offset;
+				g_texture_cache->InvalidateTargetPages();
 				horizontal_offset = 0;
 			}
 
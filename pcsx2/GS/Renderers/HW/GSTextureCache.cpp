@@ -17,6 +17,8 @@
 
 #include "fmt/format.h"
 
+#include <zstd.h>
+
 #include <cinttypes>
 #include <math.h>
 
@@ -32,6 +34,8 @@ static u8* s_unswizzle_buffer;
 
 /// List of candidates for purging when the hash cache gets too large.
 static std::vector<std::pair<GSTextureCache::HashCacheMap::iterator, s32>> s_hash_cache_purge_list;
+static std::vector<u8> s_hash_cache_spill_buffer;
+static std::vector<std::pair<GSTextureCache::HashCacheMap::iterator, u32>> s_hash_cache_spill_list;
 
 #ifdef PCSX2_DEVBUILD
 // We can only set one texture name per command buffer, which would break our fancy texture cache RT/DS/texture naming.
@@ -63,6 +67,8 @@ GSTextureCache::~GSTextureCache()
 	RemoveAll(true, true, true);
 
 	s_hash_cache_purge_list = {};
+	s_hash_cache_spill_buffer = {};
+	s_hash_cache_spill_list = {};
 	_aligned_free(s_unswizzle_buffer);
 }
 
@@ -109,6 +115,8 @@ void GSTextureCache::RemoveAll(bool sources, bool targets, bool hash_cache)
 		m_hash_cache.clear();
 		m_hash_cache_memory_usage = 0;
 		m_hash_cache_replacement_memory_usage = 0;
+		m_hash_cache_spill.clear();
+		m_hash_cache_spill_memory_usage = 0;
 	}
 }
 
@@ -1722,6 +1730,7 @@ GSTextureCache::Source* GSTextureCache::LookupSource(const bool is_color, const
 							}
 							t->m_valid_rgb = true;
 							t->m_TEX0 = dst_match->m_TEX0;
+							InvalidateTargetPages();
 							break;
 						}
 					}
@@ -2843,6 +2852,7 @@ GSTextureCache::Target* GSTextureCache::LookupDrawTarget(GIFRegTEX0 TEX0, const
 			dst->m_32_bits_fmt = dst_match->m_32_bits_fmt;
 			dst->OffsetHack_modxy = dst_match->OffsetHack_modxy;
 			dst->m_end_block = dst_match->m_end_block; // If we're copying the size, we need to keep the end block.
+			InvalidateTargetPages();
 			dst->m_valid = dst_match->m_valid;
 			dst->m_valid_alpha_low = dst_match->m_valid_alpha_low; //&& psm_s.trbpp != 24;
 			dst->m_valid_alpha_high = dst_match->m_valid_alpha_high; //&& psm_s.trbpp != 24;
@@ -3798,6 +3808,7 @@ bool GSTextureCache::PreloadTarget(GIFRegTEX0 TEX0, const GSVector2i& size, cons
 							dst->m_valid = old_dst->m_valid;
 							dst->m_drawn_since_read = old_dst->m_drawn_since_read;
 							dst->m_end_block = old_dst->m_end_block;
+							InvalidateTargetPages();
 							dst->m_valid_rgb = true;
 							old_dst->m_valid_rgb = false;
 							old_dst->m_was_dst_matched = true;
@@ -3921,6 +3932,7 @@ GSTextureCache::Target* GSTextureCache::LookupDisplayTarget(GIFRegTEX0 TEX0, con
 						t->m_TEX0.TBW = TEX0.TBW;
 						t->m_valid = dirty_rect;
 						t->m_end_block = GSLocalMemory::GetEndBlockAddress(t->m_TEX0.TBP0, t->m_TEX0.TBW, t->m_TEX0.PSM, t->m_valid);
+						InvalidateTargetPages();
 						t->m_drawn_since_read = GSVector4i::zero();
 					}
 					else
@@ -4606,6 +4618,13 @@ void GSTextureCache::InvalidateContainedTargets(u32 start_bp, u32 end_bp, u32 wr
 void GSTextureCache::InvalidateVideoMemType(int type, u32 bp, u32 write_psm, u32 write_fbmsk, bool dirty_only)
 {
 	auto& list = m_dst[type];
+	if (!m_dst_pages[type].Overlaps(list, bp, bp))
+	{
+		g_perfmon.Put(GSPerfMon::TargetWalksSkipped, 1);
+		return;
+	}
+
+	g_perfmon.Put(GSPerfMon::TargetWalks, 1);
 	for (auto i = list.begin(); i != list.end(); ++i)
 	{
 		Target* const t = *i;
@@ -4793,6 +4812,13 @@ void GSTextureCache::InvalidateVideoMem(const GSOffset& off, const GSVector4i& r
 	for (int type = 0; type < 2; type++)
 	{
 		auto& list = m_dst[type];
+		if (!m_dst_pages[type].Overlaps(list, bp, end_bp))
+		{
+			g_perfmon.Put(GSPerfMon::TargetWalksSkipped, 1);
+			continue;
+		}
+
+		g_perfmon.Put(GSPerfMon::TargetWalks, 1);
 		for (auto i = list.begin(); i != list.end();)
 		{
 			auto j = i;
@@ -5299,6 +5325,7 @@ bool GSTextureCache::Move(u32 SBP, u32 SBW, u32 SPSM, int sx, int sy, u32 DBP, u
 			if (dst->m_was_dst_matched)
 			{
 				dst->m_TEX0 = new_TEX0;
+				InvalidateTargetPages();
 			}
 		}
 
@@ -5711,6 +5738,15 @@ void GSTextureCache::CopyPages(Target* src, u32 sbw, u32 src_offset, Target* dst
 GSTextureCache::Target* GSTextureCache::GetExactTarget(u32 BP, u32 BW, int type, u32 end_bp)
 {
 	auto& rts = m_dst[type];
+
+	// Any match contains BP, or starts before it and ends after end_bp.
+	if (!m_dst_pages[type].Overlaps(rts, std::min(BP, end_bp), std::max(BP, end_bp)))
+	{
+		g_perfmon.Put(GSPerfMon::TargetWalksSkipped, 1);
+		return nullptr;
+	}
+
+	g_perfmon.Put(GSPerfMon::TargetWalks, 1);
 	for (auto it = rts.begin(); it != rts.end(); ++it) // Iterate targets from MRU to LRU.
 	{
 		Target* t = *it;
@@ -7053,6 +7089,14 @@ GSTextureCache::HashCacheEntry* GSTextureCache::LookupHashCache(const GIFRegTEX0
 	const int tw = region.HasX() ? region.GetWidth() : (1 << TEX0.TW);
 	const int th = region.HasY() ? region.GetHeight() : (1 << TEX0.TH);
 	const int tlevels = lod ? (GSConfig.HWMipmap ? std::min(lod->y - lod->x + 1, GSDevice::GetMipmapLevelsForSize(tw, th)) : -1) : 1;
+
+	// evicted textures which are still in host memory can be uploaded again without decoding
+	if (!paltex && !m_hash_cache_spill.empty())
+	{
+		if (HashCacheEntry* entry = LookupHashCacheSpill(key, tw, th, tlevels))
+			return entry;
+	}
+
 	GSTexture* tex = g_gs_device->CreateTexture(tw, th, tlevels, paltex ? GSTexture::Format::UNorm8 : GSTexture::Format::Color);
 	if (!tex)
 	{
@@ -7159,6 +7203,244 @@ void GSTextureCache::AgeHashCache()
 		for (u32 i = 0; i < entries_to_purge; i++)
 			RemoveFromHashCache(s_hash_cache_purge_list[i].first);
 	}
+
+	EnforceHashCacheBudget();
+
+	if (!m_hash_cache_spill.empty())
+	{
+		for (auto& it : m_hash_cache_spill)
+			it.second.age = std::min<u16>(it.second.age, std::numeric_limits<u16>::max() - 1) + 1;
+
+		TrimHashCacheSpill();
+	}
+}
+
+void GSTextureCache::EnforceHashCacheBudget()
+{
+	const u64 budget = static_cast<u64>(GSConfig.HashCacheVRAMBudget) * _1mb;
+	if (budget == 0 || m_hash_cache_memory_usage <= budget)
+		return;
+
+	// Evict the least recently used textures first. Replacements aren't counted, and textures which
+	// are referenced by sources have to stay.
+	s_hash_cache_purge_list.clear();
+	for (auto it = m_hash_cache.begin(); it != m_hash_cache.end(); ++it)
+	{
+		if (it->second.refcount == 0 && !it->second.is_replacement)
+			s_hash_cache_purge_list.emplace_back(it, static_cast<s32>(it->second.age));
+	}
+
+	std::sort(s_hash_cache_purge_list.begin(), s_hash_cache_purge_list.end(),
+		[](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+
+	// Enough for two 1024x1024 textures with mipmaps, limits both the download texture size and the readback per frame.
+	constexpr u32 MAX_HASH_CACHE_SPILL_ROWS = 4096;
+
+	// Textures which are spilled get copied into the download texture, with their levels stacked below each other,
+	// so the whole batch is read back with one GPU sync. Whatever doesn't fit is evicted on later frames instead.
+	const bool spill = (GSConfig.HashCacheHostBudget != 0);
+	s_hash_cache_spill_list.clear();
+	u64 remaining_usage = m_hash_cache_memory_usage;
+	u32 spill_width = 0;
+	u32 spill_rows = 0;
+	u32 evicted = 0;
+	for (const auto& [it, age] : s_hash_cache_purge_list)
+	{
+		if (remaining_usage <= budget)
+			break;
+
+		GSTexture* const tex = it->second.texture;
+		remaining_usage -= tex->GetMemUsage();
+
+		// Indexed textures would need the palette to be useful again, so only keep RGBA8.
+		if (!spill || tex->GetFormat() != GSTexture::Format::Color)
+		{
+			RemoveFromHashCache(it);
+			evicted++;
+			continue;
+		}
+
+		const u32 rows = GetHashCacheSpillRows(tex);
+		if (!s_hash_cache_spill_list.empty() && (spill_rows + rows) > MAX_HASH_CACHE_SPILL_ROWS)
+			break;
+
+		s_hash_cache_spill_list.emplace_back(it, spill_rows);
+		spill_width = std::max(spill_width, static_cast<u32>(tex->GetWidth()));
+		spill_rows += rows;
+	}
+
+	if (!s_hash_cache_spill_list.empty())
+	{
+		if (PrepareDownloadTexture(spill_width, spill_rows, GSTexture::Format::Color, &m_color_download_texture))
+		{
+			for (const auto& [it, y] : s_hash_cache_spill_list)
+				CopyHashCacheEntryForSpill(it->second.texture, y);
+
+			m_color_download_texture->Flush();
+
+			for (const auto& [it, y] : s_hash_cache_spill_list)
+				SpillHashCacheEntry(it->first, it->second, y);
+
+			m_color_download_texture->Unmap();
+		}
+
+		for (const auto& [it, y] : s_hash_cache_spill_list)
+		{
+			RemoveFromHashCache(it);
+			evicted++;
+		}
+	}
+
+	GL_CACHE("TC: HC Budget: Evicted %u textures, spilled %zu, %" PRIu64 " bytes in VRAM, %" PRIu64 " bytes spilled", evicted,
+		s_hash_cache_spill_list.size(), m_hash_cache_memory_usage, m_hash_cache_spill_memory_usage);
+
+	TrimHashCacheSpill();
+}
+
+u32 GSTextureCache::GetHashCacheSpillRows(const GSTexture* tex)
+{
+	u32 rows = 0;
+	for (int level = 0; level < tex->GetMipmapLevels(); level++)
+		rows += static_cast<u32>(std::max(tex->GetHeight() >> level, 1));
+	return rows;
+}
+
+void GSTextureCache::CopyHashCacheEntryForSpill(GSTexture* tex, u32 y)
+{
+	for (int level = 0; level < tex->GetMipmapLevels(); level++)
+	{
+		const int level_width = std::max(tex->GetWidth() >> level, 1);
+		const int level_height = std::max(tex->GetHeight() >> level, 1);
+		const GSVector4i src(0, 0, level_width, level_height);
+		m_color_download_texture->CopyFromTexture(src.add32(GSVector4i(0, y, 0, y)), tex, src, level, false);
+		y += static_cast<u32>(level_height);
+	}
+}
+
+void GSTextureCache::SpillHashCacheEntry(const HashCacheKey& key, const HashCacheEntry& entry, u32 y)
+{
+	GSTexture* const tex = entry.texture;
+	const int width = tex->GetWidth();
+	const int height = tex->GetHeight();
+	const int levels = tex->GetMipmapLevels();
+
+	size_t size = 0;
+	for (int level = 0; level < levels; level++)
+		size += static_cast<size_t>(std::max(width >> level, 1)) * static_cast<size_t>(std::max(height >> level, 1)) * sizeof(u32);
+
+	s_hash_cache_spill_buffer.resize(size);
+	u8* ptr = s_hash_cache_spill_buffer.data();
+	for (int level = 0; level < levels; level++)
+	{
+		const int level_width = std::max(width >> level, 1);
+		const int level_height = std::max(height >> level, 1);
+		const GSVector4i rc(0, static_cast<int>(y), level_width, static_cast<int>(y) + level_height);
+		if (!m_color_download_texture->ReadTexels(rc, ptr, level_width * sizeof(u32)))
+			return;
+
+		ptr += static_cast<size_t>(level_width) * static_cast<size_t>(level_height) * sizeof(u32);
+		y += static_cast<u32>(level_height);
+	}
+
+	HashCacheSpillEntry spill;
+	spill.data.resize(ZSTD_compressBound(size));
+	const size_t compressed_size = ZSTD_compress(spill.data.data(), spill.data.size(), s_hash_cache_spill_buffer.data(), size, 1);
+	if (ZSTD_isError(compressed_size))
+	{
+		Console.Error("TC: Failed to compress %dx%d hash cache texture: %s", width, height, ZSTD_getErrorName(compressed_size));
+		return;
+	}
+
+	spill.data.resize(compressed_size);
+	spill.data.shrink_to_fit();
+	spill.uncompressed_size = static_cast<u32>(size);
+	spill.width = static_cast<u16>(width);
+	spill.height = static_cast<u16>(height);
+	spill.levels = static_cast<u8>(levels);
+	spill.age = 0;
+	spill.alpha_minmax = entry.alpha_minmax;
+	spill.valid_alpha_minmax = entry.valid_alpha_minmax;
+
+	auto [it, inserted] = m_hash_cache_spill.try_emplace(key);
+	if (!inserted)
+		m_hash_cache_spill_memory_usage -= it->second.data.size();
+	m_hash_cache_spill_memory_usage += compressed_size;
+	it->second = std::move(spill);
+}
+
+GSTextureCache::HashCacheEntry* GSTextureCache::LookupHashCacheSpill(const HashCacheKey& key, int width, int height, int levels)
+{
+	auto it = m_hash_cache_spill.find(key);
+	if (it == m_hash_cache_spill.end())
+		return nullptr;
+
+	// Whatever happens, the texture is going back into VRAM or being dropped.
+	const HashCacheSpillEntry spill = std::move(it->second);
+	m_hash_cache_spill_memory_usage -= spill.data.size();
+	m_hash_cache_spill.erase(it);
+
+	if (spill.width != width || spill.height != height)
+		return nullptr;
+
+	s_hash_cache_spill_buffer.resize(spill.uncompressed_size);
+	const size_t size = ZSTD_decompress(s_hash_cache_spill_buffer.data(), s_hash_cache_spill_buffer.size(), spill.data.data(), spill.data.size());
+	if (ZSTD_isError(size) || size != spill.uncompressed_size)
+	{
+		Console.Error("TC: Failed to decompress %dx%d hash cache texture.", width, height);
+		return nullptr;
+	}
+
+	GSTexture* tex = g_gs_device->CreateTexture(width, height, levels, GSTexture::Format::Color);
+	if (!tex)
+		return nullptr;
+
+	// Mipmap generation may have been switched since it was spilled.
+	if (tex->GetMipmapLevels() != spill.levels)
+	{
+		g_gs_device->Recycle(tex);
+		return nullptr;
+	}
+
+	const u8* ptr = s_hash_cache_spill_buffer.data();
+	for (int level = 0; level < spill.levels; level++)
+	{
+		const int level_width = std::max(width >> level, 1);
+		const int level_height = std::max(height >> level, 1);
+		tex->Update(GSVector4i(0, 0, level_width, level_height), ptr, level_width * sizeof(u32), level);
+		ptr += static_cast<size_t>(level_width) * static_cast<size_t>(level_height) * sizeof(u32);
+	}
+
+	if (spill.levels > 1)
+		tex->ClearMipmapGenerationFlag();
+
+	GL_CACHE("TC: HC Spill Hit: %" PRIx64 " %" PRIx64 " R-%ux%u", key.TEX0Hash, key.CLUTHash, key.region_width, key.region_height);
+
+	const HashCacheEntry entry{tex, 1u, 0u, spill.alpha_minmax, spill.valid_alpha_minmax, false};
+	m_hash_cache_memory_usage += tex->GetMemUsage();
+	return &m_hash_cache.emplace(key, entry).first->second;
+}
+
+void GSTextureCache::TrimHashCacheSpill()
+{
+	const u64 budget = static_cast<u64>(GSConfig.HashCacheHostBudget) * _1mb;
+	if (m_hash_cache_spill_memory_usage <= budget)
+		return;
+
+	std::vector<std::pair<HashCacheSpillMap::iterator, u16>> purge_list;
+	purge_list.reserve(m_hash_cache_spill.size());
+	for (auto it = m_hash_cache_spill.begin(); it != m_hash_cache_spill.end(); ++it)
+		purge_list.emplace_back(it, it->second.age);
+
+	std::sort(purge_list.begin(), purge_list.end(), [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+
+	for (const auto& [it, age] : purge_list)
+	{
+		if (m_hash_cache_spill_memory_usage <= budget)
+			break;
+
+		m_hash_cache_spill_memory_usage -= it->second.data.size();
+		m_hash_cache_spill.erase(it);
+	}
 }
 
 GSTextureCache::Target* GSTextureCache::Target::Create(GIFRegTEX0 TEX0, int w, int h, float scale, int type, bool clear)
@@ -7178,6 +7460,7 @@ GSTextureCache::Target* GSTextureCache::Target::Create(GIFRegTEX0 TEX0, int w, i
 	g_texture_cache->m_target_memory_usage += t->m_texture->GetMemUsage();
 
 	g_texture_cache->m_dst[type].push_front(t);
+	g_texture_cache->InvalidateTargetPages();
 
 	t->UpdateTextureDebugName();
 
@@ -8129,6 +8412,7 @@ void GSTextureCache::Target::ResizeValidity(const GSVector4i& rect)
 		m_valid = m_valid.rintersect(rect);
 		m_drawn_since_read = m_drawn_since_read.rintersect(rect);
 		m_end_block = GSLocalMemory::GetEndBlockAddress(m_TEX0.TBP0, m_TEX0.TBW, m_TEX0.PSM, m_valid);
+		g_texture_cache->InvalidateTargetPages();
 	}
 
 	// Else No valid size, so need to resize down.
@@ -8143,12 +8427,14 @@ void GSTextureCache::Target::UpdateValidity(const GSVector4i& rect, bool can_res
 		m_valid = rect;
 
 		m_end_block = GSLocalMemory::GetEndBlockAddress(m_TEX0.TBP0, m_TEX0.TBW, m_TEX0.PSM, m_valid);
+		g_texture_cache->InvalidateTargetPages();
 	}
 	else if (can_resize)
 	{
 		m_valid = m_valid.runion(rect);
 
 		m_end_block = GSLocalMemory::GetEndBlockAddress(m_TEX0.TBP0, m_TEX0.TBW, m_TEX0.PSM, m_valid);
+		g_texture_cache->InvalidateTargetPages();
 	}
 	// GL_CACHE("TC: UpdateValidity (0x%x->0x%x) from R:%d,%d Valid: %d,%d", m_TEX0.TBP0, m_end_block, rect.z, rect.w, m_valid.z, m_valid.w);
 }
@@ -8305,6 +8591,49 @@ void GSTextureCache::SourceMap::RemoveAt(Source* s)
 	delete s;
 }
 
+bool GSTextureCache::TargetPageMap::Overlaps(const FastList<Target*>& list, u32 start_bp, u32 end_bp)
+{
+	// Removed targets leave their pages behind, so rebuild whenever the list changes size.
+	if (m_dirty || list.size() != m_num_targets)
+		Rebuild(list);
+
+	// Both ranges are unwrapped, so compare them in pages modulo the size of memory.
+	const u32 start_page = start_bp >> 5;
+	const u32 end_page = std::max(start_bp, end_bp) >> 5;
+	if ((end_page - start_page) >= GS_MAX_PAGES)
+		return m_pages.any();
+
+	for (u32 page = start_page; page <= end_page; page++)
+	{
+		if (m_pages.test(page % GS_MAX_PAGES))
+			return true;
+	}
+
+	return false;
+}
+
+void GSTextureCache::TargetPageMap::Rebuild(const FastList<Target*>& list)
+{
+	m_pages.reset();
+
+	for (const Target* t : list)
+	{
+		const u32 start_page = t->m_TEX0.TBP0 >> 5;
+		const u32 end_page = std::max(t->m_TEX0.TBP0, t->UnwrappedEndBlock()) >> 5;
+		if ((end_page - start_page) >= GS_MAX_PAGES)
+		{
+			m_pages.set();
+			break;
+		}
+
+		for (u32 page = start_page; page <= end_page; page++)
+			m_pages.set(page % GS_MAX_PAGES);
+	}
+
+	m_num_targets = list.size();
+	m_dirty = false;
+}
+
 void GSTextureCache::AttachPaletteToSource(Source* s, u16 pal, bool need_gs_texture, bool update_alpha_minmax)
 {
 	s->m_palette_obj = m_palette_map.LookupPalette(pal, need_gs_texture);
@@ -7,6 +7,7 @@
 #include "GS/Renderers/Common/GSFastList.h"
 #include "GS/Renderers/Common/GSDirtyRect.h"
 
+#include <bitset>
 #include <unordered_set>
 #include <utility>
 #include <limits>
@@ -137,6 +138,22 @@ public:
 
 	using HashCacheMap = std::unordered_map<HashCacheKey, HashCacheEntry, HashCacheKeyHash>;
 
+	// Hash cache texture evicted to stay within the VRAM budget, compressed in host memory so it can be
+	// uploaded again on a hit without decoding it from local memory. Only RGBA8 textures are kept.
+	struct HashCacheSpillEntry
+	{
+		std::vector<u8> data; // zstd compressed, all mip levels back to back.
+		u32 uncompressed_size;
+		u16 width;
+		u16 height;
+		u8 levels;
+		u16 age;
+		std::pair<u8, u8> alpha_minmax;
+		bool valid_alpha_minmax;
+	};
+
+	using HashCacheSpillMap = std::unordered_map<HashCacheKey, HashCacheSpillEntry, HashCacheKeyHash>;
+
 	class Surface : public GSAlignedClass<32>
 	{
 	protected:
@@ -383,6 +400,23 @@ public:
 		void RemoveAt(Source* s);
 	};
 
+	// Conservative page occupancy of a target list, so invalidations and lookups which can't touch any
+	// target skip walking the list. Stale pages only cost a walk, so removing a target doesn't update it,
+	// but anything which moves a target or grows its end block has to call InvalidateTargetPages().
+	class TargetPageMap
+	{
+	public:
+		bool Overlaps(const FastList<Target*>& list, u32 start_bp, u32 end_bp);
+		void Invalidate() { m_dirty = true; }
+
+	private:
+		void Rebuild(const FastList<Target*>& list);
+
+		std::bitset<GS_MAX_PAGES> m_pages;
+		u16 m_num_targets = 0;
+		bool m_dirty = true;
+	};
+
 	struct TargetHeightElem
 	{
 		union
@@ -439,8 +473,11 @@ protected:
 	HashCacheMap m_hash_cache;
 	u64 m_hash_cache_memory_usage = 0;
 	u64 m_hash_cache_replacement_memory_usage = 0;
+	HashCacheSpillMap m_hash_cache_spill;
+	u64 m_hash_cache_spill_memory_usage = 0;
 
 	FastList<Target*> m_dst[2];
+	TargetPageMap m_dst_pages[2];
 	FastList<TargetHeightElem> m_target_heights;
 	u64 m_target_memory_usage = 0;
 
@@ -478,6 +515,16 @@ protected:
 	HashCacheEntry* LookupHashCache(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, bool& paltex, const u32* clut, const GSVector2i* lod, SourceRegion region);
 	HashCacheMap::iterator RemoveFromHashCache(HashCacheMap::iterator it);
 	void AgeHashCache();
+	void EnforceHashCacheBudget();
+
+	/// Rows of the download texture needed to spill a hash cache texture, with all of its levels.
+	static u32 GetHashCacheSpillRows(const GSTexture* tex);
+	/// Queues a copy of all levels of a hash cache texture into the download texture, starting at row y.
+	void CopyHashCacheEntryForSpill(GSTexture* tex, u32 y);
+	/// Reads back and compresses a hash cache texture copied to row y, after the download texture is flushed.
+	void SpillHashCacheEntry(const HashCacheKey& key, const HashCacheEntry& entry, u32 y);
+	HashCacheEntry* LookupHashCacheSpill(const HashCacheKey& key, int width, int height, int levels);
+	void TrimHashCacheSpill();
 
 	static void PreloadTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region, GSLocalMemory& mem, bool paltex, GSTexture* tex, u32 level, std::pair<u8, u8>* alpha_minmax);
 	static HashType HashTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region);
@@ -508,9 +555,17 @@ public:
 	__fi u64 GetHashCacheMemoryUsage() const { return m_hash_cache_memory_usage; }
 	__fi u64 GetHashCacheReplacementMemoryUsage() const { return m_hash_cache_replacement_memory_usage; }
 	__fi u64 GetTotalHashCacheMemoryUsage() const { return (m_hash_cache_memory_usage + m_hash_cache_replacement_memory_usage); }
+	__fi u64 GetHashCacheSpillMemoryUsage() const { return m_hash_cache_spill_memory_usage; }
 	__fi u64 GetSourceMemoryUsage() const { return m_source_memory_usage; }
 	__fi u64 GetTargetMemoryUsage() const { return m_target_memory_usage; }
 
+	/// Must be called when a target's start or end block changes outside of UpdateValidity()/ResizeValidity().
+	__fi void InvalidateTargetPages()
+	{
+		m_dst_pages[RenderTarget].Invalidate();
+		m_dst_pages[DepthStencil].Invalidate();
+	}
+
 	void Read(Target* t, const GSVector4i& r);
 	void Read(Source* t, const GSVector4i& r);
 	void RemoveAll(bool sources, bool targets, bool hash_cache);
@@ -5,8 +5,16 @@
 #include "GS/Renderers/SW/GSTextureCacheSW.h"
 #include "GS/Renderers/SW/GSScanlineEnvironment.h"
 #include "GS/Renderers/SW/GSRasterizer.h"
+#include "GS/GS.h"
+#include "Config.h"
+#include "VMManager.h"
 
 #include "common/Console.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
+#include "common/Timer.h"
+
+#include "fmt/format.h"
 
 #include <fstream>
 
@@ -31,10 +39,15 @@ GSDrawScanline::GSDrawScanline()
 	, m_ds_map("GSDrawScanline")
 {
 	GSCodeReserve::ResetMemory();
+
+	m_kernel_cache_serial = VMManager::GetDiscSerial();
+	LoadKernelCache();
 }
 
 GSDrawScanline::~GSDrawScanline()
 {
+	SaveKernelCache();
+
 	if (const size_t used = GSCodeReserve::GetMemoryUsed(); used > 0)
 		DevCon.WriteLn("SW JIT generated %zu bytes of code", used);
 }
@@ -174,6 +187,147 @@ bool GSDrawScanline::SetupDraw(GSRasterizerData& data)
 #endif
 }
 
+namespace
+{
+	struct KernelCacheHeader
+	{
+		static constexpr u32 MAGIC = 0x4B575347; // GSWK
+		static constexpr u32 VERSION = 1;
+
+		u32 magic;
+		u32 version;
+		u32 num_setup_prim;
+		u32 num_draw_scanline;
+	};
+
+	// Leave plenty of the code buffer for kernels which weren't seen before.
+	static constexpr u32 MAX_CACHED_KERNELS = 2048;
+} // namespace
+
+static std::string GetKernelCachePath(const std::string& serial)
+{
+	return Path::Combine(EmuFolders::Cache, fmt::format("sw_kernels_{}.bin", Path::SanitizeFileName(serial)));
+}
+
+void GSDrawScanline::GameChanged()
+{
+	std::string serial = VMManager::GetDiscSerial();
+	if (serial == m_kernel_cache_serial)
+		return;
+
+	SaveKernelCache();
+	m_kernel_cache_serial = std::move(serial);
+	LoadKernelCache();
+}
+
+void GSDrawScanline::LoadKernelCache()
+{
+	m_sp_map.ClearKeys();
+	m_ds_map.ClearKeys();
+	m_kernel_cache_size = 0;
+
+#ifdef ENABLE_JIT_RASTERIZER
+	if (m_kernel_cache_serial.empty() || GSConfig.DisableShaderCache)
+		return;
+
+	const std::string path = GetKernelCachePath(m_kernel_cache_serial);
+	std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(path.c_str());
+	if (!data.has_value())
+		return;
+
+	KernelCacheHeader header = {};
+	if (data->size() >= sizeof(header))
+		std::memcpy(&header, data->data(), sizeof(header));
+
+	if (header.magic != KernelCacheHeader::MAGIC || header.version != KernelCacheHeader::VERSION ||
+		(header.num_setup_prim + header.num_draw_scanline) > MAX_CACHED_KERNELS ||
+		data->size() != (sizeof(header) + (header.num_setup_prim + header.num_draw_scanline) * sizeof(u64)))
+	{
+		Console.Warning("(GSDrawScanline) Ignoring invalid kernel cache '%s'.", path.c_str());
+		return;
+	}
+
+	Common::Timer timer;
+
+	// Keep at least half of the code buffer for kernels which weren't seen before. Keys which don't fit are still
+	// kept, so they aren't dropped from the file the next time it's saved.
+	const size_t min_free = GSCodeReserve::GetMemorySize() / 2;
+	u32 generated = 0;
+	const u8* ptr = data->data() + sizeof(header);
+	for (u32 i = 0; i < header.num_setup_prim; i++, ptr += sizeof(u64))
+	{
+		u64 key;
+		std::memcpy(&key, ptr, sizeof(key));
+		if (GSCodeReserve::GetMemoryFree() > min_free)
+		{
+			m_sp_map.GetDefaultFunction(key);
+			generated++;
+		}
+		else
+		{
+			m_sp_map.AddKey(key);
+		}
+	}
+	for (u32 i = 0; i < header.num_draw_scanline; i++, ptr += sizeof(u64))
+	{
+		u64 key;
+		std::memcpy(&key, ptr, sizeof(key));
+		if (GSCodeReserve::GetMemoryFree() > min_free)
+		{
+			m_ds_map.GetDefaultFunction(key);
+			generated++;
+		}
+		else
+		{
+			m_ds_map.AddKey(key);
+		}
+	}
+
+	m_kernel_cache_size = m_sp_map.GetKeys().size() + m_ds_map.GetKeys().size();
+	DevCon.WriteLn("(GSDrawScanline) Pre-generated %u of %zu kernels for %s in %.2f ms.", generated, m_kernel_cache_size,
+		m_kernel_cache_serial.c_str(), timer.GetTimeMilliseconds());
+#endif
+}
+
+void GSDrawScanline::SaveKernelCache()
+{
+#ifdef ENABLE_JIT_RASTERIZER
+	const std::unordered_set<u64>& sp_keys = m_sp_map.GetKeys();
+	const std::unordered_set<u64>& ds_keys = m_ds_map.GetKeys();
+	if (m_kernel_cache_serial.empty() || GSConfig.DisableShaderCache ||
+		(sp_keys.size() + ds_keys.size()) <= m_kernel_cache_size)
+	{
+		return;
+	}
+
+	// Setup kernels are few and shared by many draw kernels, so they go first if the file has to be truncated.
+	const u32 num_setup_prim = static_cast<u32>(std::min<size_t>(sp_keys.size(), MAX_CACHED_KERNELS));
+	const u32 num_draw_scanline = static_cast<u32>(std::min<size_t>(ds_keys.size(), MAX_CACHED_KERNELS - num_setup_prim));
+	const KernelCacheHeader header = {KernelCacheHeader::MAGIC, KernelCacheHeader::VERSION, num_setup_prim, num_draw_scanline};
+
+	std::vector<u8> data(sizeof(header) + (num_setup_prim + num_draw_scanline) * sizeof(u64));
+	u8* ptr = data.data();
+	std::memcpy(ptr, &header, sizeof(header));
+	ptr += sizeof(header);
+	const auto write_keys = [&ptr](const std::unordered_set<u64>& keys, u32 count) {
+		for (auto it = keys.begin(); count > 0; ++it, count--)
+		{
+			const u64 key = *it;
+			std::memcpy(ptr, &key, sizeof(key));
+			ptr += sizeof(key);
+		}
+	};
+	write_keys(sp_keys, num_setup_prim);
+	write_keys(ds_keys, num_draw_scanline);
+
+	const std::string path = GetKernelCachePath(m_kernel_cache_serial);
+	if (!FileSystem::WriteBinaryFile(path.c_str(), data.data(), data.size()))
+		Console.Warning("(GSDrawScanline) Failed to write kernel cache '%s'.", path.c_str());
+	else
+		m_kernel_cache_size = sp_keys.size() + ds_keys.size();
+#endif
+}
+
 void GSDrawScanline::UpdateDrawStats(u64 frame, u64 ticks, int actual, int total, int prims)
 {
 	m_ds_map.UpdateStats(frame, ticks, actual, total, prims);
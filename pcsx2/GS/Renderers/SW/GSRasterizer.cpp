@@ -49,10 +49,12 @@ GSRasterizer::GSRasterizer(GSDrawScanline* ds, int id, int threads)
 	if (!m_edge.buff)
 		pxFailRel("failed to allocate storage for m_edge.buff");
 
-	int rows = (2048 >> m_thread_height) + 16;
-	m_scanline = (u8*)_aligned_malloc(rows, 64);
+	// FindMyNextScanline() scans past the last band for the next row this rasterizer owns, which can be up to
+	// threads - 1 rows further on, so pad the mask by at least that much.
+	m_scanline_rows = (2048 >> m_thread_height) + std::max(threads, 16);
+	m_scanline = (u8*)_aligned_malloc(m_scanline_rows, 64);
 
-	for (int i = 0; i < rows; i++)
+	for (int i = 0; i < m_scanline_rows; i++)
 	{
 		m_scanline[i] = (i % threads) == id ? 1 : 0;
 	}
@@ -71,44 +73,17 @@ static void __fi AddScanlineInfo(GSVertexSW* e, int pixels, int left, int top)
 	e->_pad.I32[2] = top;
 }
 
-bool GSRasterizer::IsOneOfMyScanlines(int top) const
+void GSRasterizer::SetTile(int id)
 {
-	pxAssert(top >= 0 && top < 2048);
-
-	return m_scanline[top >> m_thread_height] != 0;
-}
-
-bool GSRasterizer::IsOneOfMyScanlines(int top, int bottom) const
-{
-	pxAssert(top >= 0 && top < 2048 && bottom >= 0 && bottom < 2048);
-
-	top = top >> m_thread_height;
-	bottom = (bottom + (1 << m_thread_height) - 1) >> m_thread_height;
-
-	while (top < bottom)
-	{
-		if (m_scanline[top++])
-		{
-			return true;
-		}
-	}
+	if (m_id == id)
+		return;
 
-	return false;
-}
+	m_id = id;
 
-int GSRasterizer::FindMyNextScanline(int top) const
-{
-	int i = top >> m_thread_height;
-
-	if (m_scanline[i] == 0)
+	for (int i = 0; i < m_scanline_rows; i++)
 	{
-		while (m_scanline[++i] == 0)
-			;
-
-		top = i << m_thread_height;
+		m_scanline[i] = (i % m_threads) == id ? 1 : 0;
 	}
-
-	return top;
 }
 
 int GSRasterizer::GetPixels(bool reset)
@@ -1498,27 +1473,38 @@ void GSSingleRasterizer::PrintStats()
 #endif
 }
 
+void GSSingleRasterizer::GameChanged()
+{
+	m_ds.GameChanged();
+}
+
 //
 
 GSRasterizerList::GSRasterizerList(int threads)
 {
 	m_thread_height = compute_best_thread_height(threads);
 
-	const int rows = (2048 >> m_thread_height) + 16;
-	m_scanline = static_cast<u8*>(_aligned_malloc(rows, 64));
-
-	for (int i = 0; i < rows; i++)
-	{
-		m_scanline[i] = static_cast<u8>(i % threads);
-	}
+	// Can't have more tiles than there are bands of scanlines.
+	m_tile_count = std::min(threads * TILES_PER_THREAD, 2048 >> m_thread_height);
+	m_tiles = std::make_unique<Tile[]>(m_tile_count);
+	for (int i = 0; i < m_tile_count; i++)
+		m_tiles[i].draws = std::make_unique<u64[]>(DRAW_RING_SIZE);
+	m_draws = std::make_unique<QueuedDraw[]>(DRAW_RING_SIZE);
+	m_semas = std::make_unique<Threading::WorkSema[]>(threads);
+	m_inline_r = std::make_unique<GSRasterizer>(&m_ds, 0, 1);
 
 	PerformanceMetrics::SetGSSWThreadCount(threads);
 }
 
 GSRasterizerList::~GSRasterizerList()
 {
+	m_exit.store(true, std::memory_order_release);
+	for (size_t i = 0; i < m_workers.size(); i++)
+		m_semas[i].NotifyOfWork();
+	for (std::thread& thread : m_workers)
+		thread.join();
+
 	PerformanceMetrics::SetGSSWThreadCount(0);
-	_aligned_free(m_scanline);
 }
 
 void GSRasterizerList::OnWorkerStartup(int i, u64 affinity)
@@ -1539,6 +1525,84 @@ void GSRasterizerList::OnWorkerShutdown(int i)
 {
 }
 
+void GSRasterizerList::WorkerThread(int i, u64 affinity)
+{
+	OnWorkerStartup(i, affinity);
+
+	Threading::WorkSema& sema = m_semas[i];
+	while (true)
+	{
+		sema.WaitForWorkWithSpin();
+		if (m_exit.load(std::memory_order_acquire))
+			break;
+
+		// A worker which gave up on a tile because someone else owned it can go back to sleep, since the
+		// owner always rescans after releasing it.
+		while (ProcessTiles(i))
+			;
+	}
+
+	OnWorkerShutdown(i);
+}
+
+bool GSRasterizerList::IsTilePending(int tile) const
+{
+	const Tile& t = m_tiles[tile];
+	return (t.next.load(std::memory_order_acquire) != t.last.load());
+}
+
+bool GSRasterizerList::ProcessTiles(int i)
+{
+	GSRasterizer& r = *m_r[i];
+	bool did_work = false;
+
+	// Start at our own tiles, then steal from everyone else.
+	const int first_tile = i * TILES_PER_THREAD;
+	for (int n = 0; n < m_tile_count; n++)
+	{
+		const int tile = (first_tile + n) % m_tile_count;
+		Tile& t = m_tiles[tile];
+		if (!IsTilePending(tile) || t.busy.exchange(true))
+			continue;
+
+		u64 next = t.next.load(std::memory_order_relaxed);
+		const u64 last = t.last.load();
+
+		r.SetTile(tile);
+
+		for (; next != last; next++)
+		{
+			QueuedDraw& draw = m_draws[t.draws[next % DRAW_RING_SIZE] % DRAW_RING_SIZE];
+			r.Draw(*draw.data.get());
+
+			// Drop the draw as soon as every tile is done, so its pages are released.
+			if (draw.tiles_left.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				draw.data = nullptr;
+		}
+
+		t.next.store(next, std::memory_order_release);
+		t.busy.store(false);
+		did_work = true;
+	}
+
+	return did_work;
+}
+
+void GSRasterizerList::RetireDraws()
+{
+	u64 oldest = m_draw_tail;
+	for (int i = 0; i < m_tile_count; i++)
+	{
+		// The oldest draw a tile is still waiting on holds back everything after it.
+		const Tile& t = m_tiles[i];
+		const u64 next = t.next.load(std::memory_order_acquire);
+		if (next != t.last.load(std::memory_order_relaxed))
+			oldest = std::min(oldest, t.draws[next % DRAW_RING_SIZE]);
+	}
+
+	m_draw_retired = oldest;
+}
+
 void GSRasterizerList::Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data)
 {
 	GSVector4i r = data->bbox.rintersect(data->scissor);
@@ -1552,12 +1616,45 @@ void GSRasterizerList::Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data
 
 	pxAssert(r.top >= 0 && r.top <= 2048 && r.bottom >= 0 && r.bottom <= 2048);
 
-	int top = r.top >> m_thread_height;
-	int bottom = std::min<int>((r.bottom + (1 << m_thread_height) - 1) >> m_thread_height, top + (int)m_workers.size());
+	const int top = r.top >> m_thread_height;
+	const int bottom = (r.bottom + (1 << m_thread_height) - 1) >> m_thread_height;
+	if (top >= bottom)
+		return;
 
-	while (top < bottom)
+	if ((r.width() * r.height()) <= INLINE_DRAW_PIXELS && IsSynced())
 	{
-		m_workers[m_scanline[top++]]->Push(data);
+		m_inline_r->Draw(*data.get());
+		return;
+	}
+
+	while ((m_draw_tail - m_draw_retired) >= DRAW_RING_SIZE)
+	{
+		RetireDraws();
+		if ((m_draw_tail - m_draw_retired) >= DRAW_RING_SIZE)
+			std::this_thread::yield();
+	}
+
+	const int tiles = std::min(bottom - top, m_tile_count);
+	const u64 index = m_draw_tail++;
+	QueuedDraw& draw = m_draws[index % DRAW_RING_SIZE];
+	pxAssert(!draw.data.get());
+	draw.data = data;
+	draw.tiles_left.store(tiles, std::memory_order_relaxed);
+
+	for (int i = 0; i < tiles; i++)
+	{
+		Tile& t = m_tiles[(top + i) % m_tile_count];
+		const u64 pos = t.last.load(std::memory_order_relaxed);
+		t.draws[pos % DRAW_RING_SIZE] = index;
+		t.last.store(pos + 1);
+	}
+
+	// Only wake as many workers as there are tiles to draw, small draws don't need everyone.
+	const u32 workers = static_cast<u32>(std::min<size_t>(tiles, m_workers.size()));
+	for (u32 i = 0; i < workers; i++)
+	{
+		m_semas[m_next_worker].NotifyOfWork();
+		m_next_worker = (m_next_worker + 1) % static_cast<u32>(m_workers.size());
 	}
 }
 
@@ -1567,18 +1664,21 @@ void GSRasterizerList::Sync()
 	{
 		for (size_t i = 0; i < m_workers.size(); i++)
 		{
-			m_workers[i]->Wait();
+			m_semas[i].WaitForEmptyWithSpin();
 		}
 
+		pxAssert(IsSynced());
+		m_draw_retired = m_draw_tail;
+
 		g_perfmon.Put(GSPerfMon::SyncPoint, 1);
 	}
 }
 
 bool GSRasterizerList::IsSynced() const
 {
-	for (size_t i = 0; i < m_workers.size(); i++)
+	for (int i = 0; i < m_tile_count; i++)
 	{
-		if (!m_workers[i]->IsEmpty())
+		if (IsTilePending(i))
 		{
 			return false;
 		}
@@ -1589,7 +1689,7 @@ bool GSRasterizerList::IsSynced() const
 
 int GSRasterizerList::GetPixels(bool reset)
 {
-	int pixels = 0;
+	int pixels = m_inline_r->GetPixels(reset);
 
 	for (size_t i = 0; i < m_workers.size(); i++)
 	{
@@ -1615,15 +1715,16 @@ std::unique_ptr<IRasterizer> GSRasterizerList::Create(int threads)
 	if (EmuConfig.EnableThreadPinning && !pin)
 		WARNING_LOG("Not pinning SW threads, we need {} processors, but only have {}", threads, procs.size());
 
+	for (int i = 0; i < threads; i++)
+	{
+		// Each rasterizer switches between tiles, so it's created for the tile count rather than the thread count.
+		rl->m_r.push_back(std::unique_ptr<GSRasterizer>(new GSRasterizer(&rl->m_ds, (i * TILES_PER_THREAD) % rl->m_tile_count, rl->m_tile_count)));
+	}
+
 	for (int i = 0; i < threads; i++)
 	{
 		const u64 affinity = pin ? (static_cast<u64>(1u) << procs[i]) : 0;
-		rl->m_r.push_back(std::unique_ptr<GSRasterizer>(new GSRasterizer(&rl->m_ds, i, threads)));
-		auto& r = *rl->m_r[i];
-		rl->m_workers.push_back(std::unique_ptr<GSWorker>(new GSWorker(
-			[i, affinity]() { GSRasterizerList::OnWorkerStartup(i, affinity); },
-			[&r](GSRingHeap::SharedPtr<GSRasterizerData>& item) { r.Draw(*item.get()); },
-			[i]() { GSRasterizerList::OnWorkerShutdown(i); })));
+		rl->m_workers.emplace_back(&GSRasterizerList::WorkerThread, rl.get(), i, affinity);
 	}
 
 	return rl;
@@ -1633,6 +1734,11 @@ void GSRasterizerList::PrintStats()
 {
 }
 
+void GSRasterizerList::GameChanged()
+{
+	m_ds.GameChanged();
+}
+
 #define INIT4(x0, x1, x2, x3, x4) static_cast<DrawEdgeTrianglePtr>(&GSRasterizer::DrawEdgeTriangle<x0, x1, x2, x3, x4>)
 #define INIT3(x0, x1, x2, x3) { INIT4(x0, x1, x2, x3, false)    , INIT4(x0, x1, x2, x3, true) } 
 #define INIT2(x0, x1, x2)     { INIT3(x0, x1, x2, false)        , INIT3(x0, x1, x2, true)     } 
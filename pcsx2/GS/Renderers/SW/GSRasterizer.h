@@ -7,10 +7,14 @@
 #include "GS/Renderers/SW/GSDrawScanline.h"
 #include "GS/GSAlignedClass.h"
 #include "GS/GSPerfMon.h"
-#include "GS/GSJobQueue.h"
 #include "GS/GSRingHeap.h"
 #include "GS/MultiISA.h"
 
+#include "common/Threading.h"
+
+#include <atomic>
+#include <thread>
+
 MULTI_ISA_UNSHARED_START
 
 class GSDrawScanline;
@@ -71,6 +75,7 @@ protected:
 	int m_id;
 	int m_threads;
 	int m_thread_height;
+	int m_scanline_rows;
 	u8* m_scanline;
 	u8 m_scanmsk_value;
 	GSVector4i m_scissor;
@@ -128,9 +133,50 @@ public:
 	GSRasterizer(GSDrawScanline* ds, int id, int threads);
 	~GSRasterizer();
 
-	__forceinline bool IsOneOfMyScanlines(int top) const;
-	__forceinline bool IsOneOfMyScanlines(int top, int bottom) const;
-	__forceinline int FindMyNextScanline(int top) const;
+	__forceinline bool IsOneOfMyScanlines(int top) const
+	{
+		pxAssert(top >= 0 && top < 2048);
+
+		return m_scanline[top >> m_thread_height] != 0;
+	}
+
+	__forceinline bool IsOneOfMyScanlines(int top, int bottom) const
+	{
+		pxAssert(top >= 0 && top < 2048 && bottom >= 0 && bottom < 2048);
+
+		top = top >> m_thread_height;
+		bottom = (bottom + (1 << m_thread_height) - 1) >> m_thread_height;
+
+		while (top < bottom)
+		{
+			if (m_scanline[top++])
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	__forceinline int FindMyNextScanline(int top) const
+	{
+		int i = top >> m_thread_height;
+
+		if (m_scanline[i] == 0)
+		{
+			while (m_scanline[++i] == 0)
+				;
+
+			top = i << m_thread_height;
+		}
+
+		return top;
+	}
+
+	int GetThreadHeight() const { return m_thread_height; }
+
+	/// Switches which of the interleaved scanline groups this rasterizer draws.
+	void SetTile(int id);
 
 	void Draw(GSRasterizerData& data);
 	int GetPixels(bool reset);
@@ -146,6 +192,7 @@ public:
 	virtual bool IsSynced() const = 0;
 	virtual int GetPixels(bool reset = true) = 0;
 	virtual void PrintStats() = 0;
+	virtual void GameChanged() = 0;
 };
 
 class GSSingleRasterizer final : public IRasterizer
@@ -159,6 +206,7 @@ public:
 	bool IsSynced() const override;
 	int GetPixels(bool reset = true) override;
 	void PrintStats() override;
+	void GameChanged() override;
 
 	void Draw(GSRasterizerData& data);
 
@@ -170,21 +218,60 @@ private:
 class GSRasterizerList final : public IRasterizer
 {
 protected:
-	using GSWorker = GSJobQueue<GSRingHeap::SharedPtr<GSRasterizerData>, 65536>;
+	/// Scanline groups per worker thread. Idle workers steal groups from busy ones, more groups balance better,
+	/// but every group a draw touches has to set up all of its primitives again.
+	static constexpr int TILES_PER_THREAD = 2;
+
+	/// Draws smaller than this are rasterized on the GS thread when the workers are idle, waking them costs more.
+	static constexpr int INLINE_DRAW_PIXELS = 64 * 64;
+
+	static constexpr u32 DRAW_RING_SIZE = 4096;
+
+	struct QueuedDraw
+	{
+		GSRingHeap::SharedPtr<GSRasterizerData> data;
+		std::atomic<int> tiles_left;
+	};
+
+	/// Every m_tile_count'th band of scanlines, starting at the tile index. Only one worker owns a tile at a time,
+	/// and it draws the tile's queue in order, so draws can't overtake each other.
+	struct alignas(64) Tile
+	{
+		std::atomic<u64> next{0}; ///< Position of the next draw to process in the queue.
+		std::atomic<u64> last{0}; ///< Number of draws queued.
+		std::atomic<bool> busy{false};
+		std::unique_ptr<u64[]> draws; ///< Indices into m_draws, DRAW_RING_SIZE entries.
+	};
 
 	GSDrawScanline m_ds;
 
 	// Worker threads depend on the rasterizers, so don't change the order.
 	std::vector<std::unique_ptr<GSRasterizer>> m_r;
-	std::vector<std::unique_ptr<GSWorker>> m_workers;
-	u8* m_scanline;
-	int m_thread_height;
+	std::unique_ptr<GSRasterizer> m_inline_r;
+	std::unique_ptr<Threading::WorkSema[]> m_semas;
+	std::vector<std::thread> m_workers;
+	std::atomic<bool> m_exit{false};
+
+	std::unique_ptr<QueuedDraw[]> m_draws;
+	std::unique_ptr<Tile[]> m_tiles;
+	int m_tile_count = 0;
+	int m_thread_height = 0;
+
+	// Only touched by the GS thread.
+	u64 m_draw_tail = 0;
+	u64 m_draw_retired = 0;
+	u32 m_next_worker = 0;
 
 	GSRasterizerList(int threads);
 
 	static void OnWorkerStartup(int i, u64 affinity);
 	static void OnWorkerShutdown(int i);
 
+	void WorkerThread(int i, u64 affinity);
+	bool ProcessTiles(int i);
+	bool IsTilePending(int tile) const;
+	void RetireDraws();
+
 public:
 	~GSRasterizerList() override;
 
@@ -197,6 +284,7 @@ public:
 	bool IsSynced() const override;
 	int GetPixels(bool reset) override;
 	void PrintStats() override;
+	void GameChanged() override;
 };
 
 MULTI_ISA_UNSHARED_END
@@ -52,6 +52,11 @@ void GSRendererSW::Reset(bool hardware_reset)
 	GSRenderer::Reset(hardware_reset);
 }
 
+void GSRendererSW::GameChanged()
+{
+	m_rl->GameChanged();
+}
+
 void GSRendererSW::Destroy()
 {
 	// Need to destroy worker queue first to stop any pending thread work
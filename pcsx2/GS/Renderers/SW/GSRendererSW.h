@@ -90,6 +90,7 @@ public:
 	__fi static GSRendererSW* GetInstance() { return static_cast<GSRendererSW*>(g_gs_renderer.get()); }
 
 	void Destroy() override;
+	void GameChanged() override;
 };
 
 MULTI_ISA_UNSHARED_END
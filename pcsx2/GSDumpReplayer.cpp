@@ -26,7 +26,14 @@
 #include "common/Threading.h"
 #include "common/Timer.h"
 
+#define XXH_STATIC_LINKING_ONLY 1
+#define XXH_INLINE_ALL 1
+#include "xxhash.h"
+
+#include <zstd.h>
+
 #include <atomic>
+#include <limits>
 
 static void GSDumpReplayerCpuReserve();
 static void GSDumpReplayerCpuShutdown();
@@ -36,9 +43,49 @@ static void GSDumpReplayerCpuExecute();
 static void GSDumpReplayerExitExecution();
 static void GSDumpReplayerCancelInstruction();
 static void GSDumpReplayerCpuClear(u32 addr, u32 size);
+static void GSDumpReplayerSaveIndex();
+
+namespace
+{
+	/// Frame offsets and periodic GS snapshots for a dump, cached in <dump>.idx so frame ranges
+	/// can be replayed without going through every frame before them.
+	struct GSDumpIndex
+	{
+		static constexpr u32 MAGIC = 0x49445347; // GSDI
+		static constexpr u32 VERSION = 1;
+		static constexpr u32 SNAPSHOT_INTERVAL = 60;
+
+		struct Header
+		{
+			u32 magic;
+			u32 version;
+			u64 dump_hash;
+			u32 num_frames;
+			u32 num_snapshots;
+		};
+
+		struct Snapshot
+		{
+			u32 frame;
+			u32 state_size;
+			std::vector<u8> data; ///< zstd compressed GS registers, followed by the GS freeze data.
+		};
+
+		u64 dump_hash = 0;
+		std::vector<u64> frame_offsets; ///< Packet position at the start of each frame.
+		std::vector<Snapshot> snapshots; ///< Sorted by frame.
+		bool loaded = false;
+		bool dirty = false;
+	};
+} // namespace
 
 static std::unique_ptr<GSDumpFile> s_dump_file;
+static std::string s_dump_filename;
+static GSDumpIndex s_dump_index;
+static u32 s_frame_range_start = 0;
+static u32 s_frame_range_end = std::numeric_limits<u32>::max();
 static u32 s_current_packet = 0;
+static u32 s_packet_count = 0;
 static u32 s_dump_frame_number = 0;
 static s32 s_dump_loop_count = 0;
 static bool s_dump_running = false;
@@ -92,7 +139,7 @@ bool GSDumpReplayer::Initialize(const char* filename, Error* error)
 
 	Error dump_error;
 	s_dump_file = GSDumpFile::OpenGSDump(filename, &dump_error);
-	if (!s_dump_file || !s_dump_file->ReadFile(&dump_error))
+	if (!s_dump_file || !s_dump_file->ReadHeader(&dump_error))
 	{
 		Error::SetStringFmt(error, TRANSLATE_FS("GSDumpReplayer", "Failed to open or read '{}': {}"),
 			Path::GetFileName(filename), dump_error.GetDescription());
@@ -101,6 +148,8 @@ bool GSDumpReplayer::Initialize(const char* filename, Error* error)
 	}
 
 	Console.WriteLn("(GSDumpReplayer) Read file in %.2f ms.", timer.GetTimeMilliseconds());
+	s_dump_filename = filename;
+	s_dump_index = {};
 
 	// We replace all CPUs.
 	Cpu = &GSDumpReplayerCpu;
@@ -126,15 +175,19 @@ bool GSDumpReplayer::ChangeDump(const char* filename)
 
 	Error error;
 	std::unique_ptr<GSDumpFile> new_dump(GSDumpFile::OpenGSDump(filename));
-	if (!new_dump || !new_dump->ReadFile(&error))
+	if (!new_dump || !new_dump->ReadHeader(&error))
 	{
 		Host::ReportErrorAsync("GSDumpReplayer", fmt::format("Failed to open or read '{}': {}",
 													 Path::GetFileName(filename), error.GetDescription()));
 		return false;
 	}
 
+	GSDumpReplayerSaveIndex();
 	s_dump_file = std::move(new_dump);
+	s_dump_filename = filename;
+	s_dump_index = {};
 	s_current_packet = 0;
+	s_packet_count = 0;
 
 	// Don't forget to reset the GS!
 	GSDumpReplayerCpuReset();
@@ -145,11 +198,21 @@ void GSDumpReplayer::Shutdown()
 {
 	Console.WriteLn("(GSDumpReplayer) Shutting down.");
 
+	GSDumpReplayerSaveIndex();
+
 	Cpu = nullptr;
 	psxCpu = nullptr;
 	CpuVU0 = nullptr;
 	CpuVU1 = nullptr;
 	s_dump_file.reset();
+	s_dump_filename = {};
+	s_dump_index = {};
+}
+
+void GSDumpReplayer::SetFrameRange(u32 start, u32 end)
+{
+	s_frame_range_start = start;
+	s_frame_range_end = std::max(start, end);
 }
 
 std::string GSDumpReplayer::GetDumpSerial()
@@ -198,8 +261,240 @@ void GSDumpReplayerCpuReset()
 	s_dump_frame_number = 0;
 }
 
+static bool GSDumpReplayerHasFrameRange()
+{
+	return (s_frame_range_start > 0 || s_frame_range_end != std::numeric_limits<u32>::max());
+}
+
+static std::string GSDumpReplayerGetIndexPath()
+{
+	return s_dump_filename + ".idx";
+}
+
+static u64 GSDumpReplayerGetDumpHash()
+{
+	// Hashing the whole dump would defeat the point, the starting state plus file size is unique enough.
+	const GSDumpFile::ByteArray& state = s_dump_file->GetStateData();
+	const GSDumpFile::ByteArray& regs = s_dump_file->GetRegsData();
+	const u64 seed = static_cast<u64>(FileSystem::GetPathFileSize(s_dump_filename.c_str()));
+	return XXH3_64bits_withSeed(state.data(), state.size(), XXH3_64bits_withSeed(regs.data(), regs.size(), seed));
+}
+
+static void GSDumpReplayerLoadIndex()
+{
+	s_dump_index = {};
+	s_dump_index.loaded = true;
+	s_dump_index.dump_hash = GSDumpReplayerGetDumpHash();
+
+	const std::string path = GSDumpReplayerGetIndexPath();
+	std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(path.c_str());
+	if (!data.has_value())
+		return;
+
+	const u8* ptr = data->data();
+	const u8* const end = ptr + data->size();
+	const auto read = [&ptr, end](void* dst, size_t size) {
+		if (static_cast<size_t>(end - ptr) < size)
+			return false;
+
+		std::memcpy(dst, ptr, size);
+		ptr += size;
+		return true;
+	};
+
+	GSDumpIndex::Header header;
+	if (!read(&header, sizeof(header)) || header.magic != GSDumpIndex::MAGIC || header.version != GSDumpIndex::VERSION)
+	{
+		Console.Warning("(GSDumpReplayer) Ignoring invalid index '%s'.", path.c_str());
+		return;
+	}
+	else if (header.dump_hash != s_dump_index.dump_hash)
+	{
+		Console.Warning("(GSDumpReplayer) Index '%s' is for a different dump, rebuilding.", path.c_str());
+		return;
+	}
+
+	// Sizes come from the file, so check them against what's left of it before allocating anything.
+	static constexpr size_t SNAPSHOT_HEADER_SIZE = sizeof(u32) * 3;
+	const auto invalid = [&path]() {
+		Console.Warning("(GSDumpReplayer) Index '%s' is truncated or corrupt, rebuilding.", path.c_str());
+	};
+	if (static_cast<u64>(header.num_frames) * sizeof(u64) > static_cast<size_t>(end - ptr) ||
+		static_cast<u64>(header.num_snapshots) * SNAPSHOT_HEADER_SIZE >
+			static_cast<size_t>(end - ptr) - header.num_frames * sizeof(u64))
+	{
+		invalid();
+		return;
+	}
+
+	std::vector<u64> frame_offsets(header.num_frames);
+	std::vector<GSDumpIndex::Snapshot> snapshots(header.num_snapshots);
+	read(frame_offsets.data(), frame_offsets.size() * sizeof(u64));
+
+	for (GSDumpIndex::Snapshot& snapshot : snapshots)
+	{
+		u32 compressed_size;
+		if (!read(&snapshot.frame, sizeof(snapshot.frame)) || !read(&snapshot.state_size, sizeof(snapshot.state_size)) ||
+			!read(&compressed_size, sizeof(compressed_size)) || snapshot.frame >= header.num_frames ||
+			compressed_size > static_cast<size_t>(end - ptr))
+		{
+			invalid();
+			return;
+		}
+
+		// The decompressed size is allocated when the snapshot is restored, so it has to match the zstd frame.
+		if (ZSTD_getFrameContentSize(ptr, compressed_size) != snapshot.state_size)
+		{
+			invalid();
+			return;
+		}
+
+		snapshot.data.assign(ptr, ptr + compressed_size);
+		ptr += compressed_size;
+	}
+
+	s_dump_index.frame_offsets = std::move(frame_offsets);
+	s_dump_index.snapshots = std::move(snapshots);
+	Console.WriteLn("(GSDumpReplayer) Loaded index with %zu frames and %zu snapshots.",
+		s_dump_index.frame_offsets.size(), s_dump_index.snapshots.size());
+}
+
+void GSDumpReplayerSaveIndex()
+{
+	if (!s_dump_index.dirty)
+		return;
+
+	s_dump_index.dirty = false;
+
+	const GSDumpIndex::Header header = {GSDumpIndex::MAGIC, GSDumpIndex::VERSION, s_dump_index.dump_hash,
+		static_cast<u32>(s_dump_index.frame_offsets.size()), static_cast<u32>(s_dump_index.snapshots.size())};
+
+	std::vector<u8> data;
+	const auto write = [&data](const void* src, size_t size) {
+		data.insert(data.end(), static_cast<const u8*>(src), static_cast<const u8*>(src) + size);
+	};
+	write(&header, sizeof(header));
+	write(s_dump_index.frame_offsets.data(), s_dump_index.frame_offsets.size() * sizeof(u64));
+	for (const GSDumpIndex::Snapshot& snapshot : s_dump_index.snapshots)
+	{
+		const u32 compressed_size = static_cast<u32>(snapshot.data.size());
+		write(&snapshot.frame, sizeof(snapshot.frame));
+		write(&snapshot.state_size, sizeof(snapshot.state_size));
+		write(&compressed_size, sizeof(compressed_size));
+		write(snapshot.data.data(), snapshot.data.size());
+	}
+
+	const std::string path = GSDumpReplayerGetIndexPath();
+	if (!FileSystem::WriteBinaryFile(path.c_str(), data.data(), data.size()))
+		Console.Warning("(GSDumpReplayer) Failed to write index to '%s'.", path.c_str());
+}
+
+static void GSDumpReplayerSaveSnapshot()
+{
+	freezeData fd = {0, nullptr};
+	MTGS::FreezeData mfd = {&fd, 0};
+	MTGS::Freeze(FreezeAction::Size, mfd);
+	if (mfd.retval != 0 || fd.size <= 0)
+		return;
+
+	// GS registers first, then the GS state, same as the dump header.
+	std::vector<u8> state(Ps2MemSize::GSregs + static_cast<size_t>(fd.size));
+	std::memcpy(state.data(), PS2MEM_GS, Ps2MemSize::GSregs);
+	fd.data = state.data() + Ps2MemSize::GSregs;
+	MTGS::Freeze(FreezeAction::Save, mfd);
+	if (mfd.retval != 0)
+		return;
+
+	GSDumpIndex::Snapshot snapshot;
+	snapshot.frame = s_dump_frame_number;
+	snapshot.state_size = static_cast<u32>(state.size());
+	snapshot.data.resize(ZSTD_compressBound(state.size()));
+	const size_t compressed_size = ZSTD_compress(snapshot.data.data(), snapshot.data.size(), state.data(), state.size(), 1);
+	if (ZSTD_isError(compressed_size))
+		return;
+
+	snapshot.data.resize(compressed_size);
+	snapshot.data.shrink_to_fit();
+
+	const auto it = std::upper_bound(s_dump_index.snapshots.begin(), s_dump_index.snapshots.end(), snapshot.frame,
+		[](u32 frame, const GSDumpIndex::Snapshot& rhs) { return frame < rhs.frame; });
+	s_dump_index.snapshots.insert(it, std::move(snapshot));
+	s_dump_index.dirty = true;
+}
+
+static void GSDumpReplayerIndexFrame()
+{
+	// Called at the start of each frame, after the previous frame's vsync.
+	if (s_dump_frame_number == s_dump_index.frame_offsets.size())
+	{
+		s_dump_index.frame_offsets.push_back(s_dump_file->GetPacketPosition());
+		s_dump_index.dirty = true;
+	}
+
+	// Only snapshot while fast forwarding, so the frames being measured aren't disturbed.
+	if (s_dump_frame_number == 0 || (s_dump_frame_number % GSDumpIndex::SNAPSHOT_INTERVAL) != 0 ||
+		s_dump_frame_number > s_frame_range_start ||
+		std::any_of(s_dump_index.snapshots.begin(), s_dump_index.snapshots.end(),
+			[](const GSDumpIndex::Snapshot& snapshot) { return snapshot.frame == s_dump_frame_number; }))
+	{
+		return;
+	}
+
+	GSDumpReplayerSaveSnapshot();
+}
+
+static bool GSDumpReplayerLoadSnapshot(u32 frame)
+{
+	// Closest snapshot at or before the requested frame.
+	const auto it = std::upper_bound(s_dump_index.snapshots.begin(), s_dump_index.snapshots.end(), frame,
+		[](u32 frame, const GSDumpIndex::Snapshot& rhs) { return frame < rhs.frame; });
+	if (it == s_dump_index.snapshots.begin())
+		return false;
+
+	const GSDumpIndex::Snapshot& snapshot = *(it - 1);
+	std::vector<u8> state(snapshot.state_size);
+	const size_t state_size = ZSTD_decompress(state.data(), state.size(), snapshot.data.data(), snapshot.data.size());
+	if (ZSTD_isError(state_size) || state_size != state.size() || state_size < Ps2MemSize::GSregs ||
+		!s_dump_file->SeekPackets(s_dump_index.frame_offsets[snapshot.frame]))
+	{
+		Console.Error("(GSDumpReplayer) Failed to restore snapshot for frame %u.", snapshot.frame);
+		return false;
+	}
+
+	std::memcpy(PS2MEM_GS, state.data(), Ps2MemSize::GSregs);
+
+	freezeData fd = {static_cast<int>(state.size() - Ps2MemSize::GSregs), state.data() + Ps2MemSize::GSregs};
+	MTGS::FreezeData mfd = {&fd, 0};
+	MTGS::Freeze(FreezeAction::Load, mfd);
+	if (mfd.retval != 0)
+	{
+		Host::ReportFormattedErrorAsync("GSDumpReplayer", "Failed to load GS state.");
+		return false;
+	}
+
+	Console.WriteLn("(GSDumpReplayer) Jumped to frame %u.", snapshot.frame);
+	s_dump_frame_number = snapshot.frame;
+	return true;
+}
+
 static void GSDumpReplayerLoadInitialState()
 {
+	s_current_packet = 0;
+	s_dump_frame_number = 0;
+
+	if (GSDumpReplayerHasFrameRange())
+	{
+		if (!s_dump_index.loaded)
+			GSDumpReplayerLoadIndex();
+
+		if (s_frame_range_start > 0 && GSDumpReplayerLoadSnapshot(s_frame_range_start))
+			return;
+	}
+
+	s_dump_file->RewindPackets();
+	if (GSDumpReplayerHasFrameRange())
+		GSDumpReplayerIndexFrame();
+
 	// reset GS registers to initial dump values
 	std::memcpy(PS2MEM_GS, s_dump_file->GetRegsData().data(),
 		std::min(Ps2MemSize::GSregs, static_cast<u32>(s_dump_file->GetRegsData().size())));
@@ -264,20 +559,50 @@ void GSDumpReplayerCpuStep()
 		s_needs_state_loaded = false;
 	}
 
-	const GSDumpFile::GSData& packet = s_dump_file->GetPackets()[s_current_packet];
-	s_current_packet = (s_current_packet + 1) % static_cast<u32>(s_dump_file->GetPackets().size());
-	if (s_current_packet == 0)
+	GSDumpFile::GSData packet;
+	Error error;
+	const bool end_of_range = (s_dump_frame_number > s_frame_range_end);
+	if (end_of_range || !s_dump_file->ReadPacket(&packet, &error))
 	{
-		s_dump_frame_number = 0;
-		if (s_dump_loop_count > 0)
-			s_dump_loop_count--;
-		else if (s_dump_loop_count == 0)
+		// End of the dump, loop back around unless we've played it enough times.
+		if (!error.IsValid())
 		{
+			if (!GSDumpReplayerHasFrameRange())
+				s_packet_count = s_current_packet;
+
+			s_current_packet = 0;
+			s_dump_frame_number = 0;
+			if (s_dump_loop_count > 0)
+			{
+				s_dump_loop_count--;
+			}
+			else if (s_dump_loop_count == 0)
+			{
+				Host::RequestVMShutdown(false, false, false);
+				s_dump_running = false;
+				return;
+			}
+
+			// Frame ranges restart from the closest snapshot, instead of replaying from the top.
+			if (GSDumpReplayerHasFrameRange())
+			{
+				s_needs_state_loaded = true;
+				return;
+			}
+		}
+
+		if (error.IsValid() || !s_dump_file->RewindPackets() || !s_dump_file->ReadPacket(&packet, &error))
+		{
+			Host::ReportErrorAsync("GSDumpReplayer", fmt::format("Failed to read packet {}: {}",
+														 s_current_packet, error.GetDescription()));
 			Host::RequestVMShutdown(false, false, false);
 			s_dump_running = false;
+			return;
 		}
 	}
 
+	s_current_packet++;
+
 	switch (packet.id)
 	{
 		case GSDumpTypes::GSType::Transfer:
@@ -315,10 +640,17 @@ void GSDumpReplayerCpuStep()
 
 		case GSDumpTypes::GSType::VSync:
 		{
+			// Don't limit frames we're fast forwarding through to reach the start of the range.
+			const bool fast_forwarding = (s_dump_frame_number < s_frame_range_start);
 			s_dump_frame_number++;
-			GSDumpReplayerUpdateFrameLimit();
-			GSDumpReplayerFrameLimit();
+			if (!fast_forwarding)
+			{
+				GSDumpReplayerUpdateFrameLimit();
+				GSDumpReplayerFrameLimit();
+			}
 			MTGS::PostVsyncStart(false);
+			if (GSDumpReplayerHasFrameRange())
+				GSDumpReplayerIndexFrame();
 			VMManager::Internal::VSyncOnCPUThread();
 			if (VMManager::Internal::IsExecutionInterrupted())
 				GSDumpReplayerExitExecution();
@@ -399,7 +731,10 @@ void GSDumpReplayer::RenderUI()
 	DRAW_LINE(font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
 
 	text.clear();
-	fmt::format_to(std::back_inserter(text), "Packet Number: {}/{}", s_current_packet, static_cast<u32>(s_dump_file->GetPackets().size()));
+	if (s_packet_count > 0)
+		fmt::format_to(std::back_inserter(text), "Packet Number: {}/{}", s_current_packet, s_packet_count);
+	else
+		fmt::format_to(std::back_inserter(text), "Packet Number: {}", s_current_packet);
 	DRAW_LINE(font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
 
 #undef DRAW_LINE
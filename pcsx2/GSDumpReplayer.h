@@ -18,6 +18,10 @@ namespace GSDumpReplayer
 	bool IsRunner();
 	void SetIsDumpRunner(bool is_runner);
 
+	/// Restricts playback to frames [start, end]. Frame offsets and periodic GS snapshots are cached
+	/// next to the dump, so later runs can jump close to the start of the range instead of replaying up to it.
+	void SetFrameRange(u32 start, u32 end);
+
 	bool Initialize(const char* filename, Error* error = nullptr);
 	bool ChangeDump(const char* filename);
 	void Shutdown();
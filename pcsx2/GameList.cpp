@@ -18,16 +18,27 @@
 #include "common/ProgressCallback.h"
 #include "common/ScopedGuard.h"
 #include "common/StringUtil.h"
+#include "common/Threading.h"
+#include "common/Timer.h"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
+#include <condition_variable>
 #include <cstdio>
+#include <cstring>
 #include <ctime>
 #include <fstream>
+#include <mutex>
+#include <span>
 #include <string_view>
 #include <utility>
 
+#define XXH_STATIC_LINKING_ONLY 1
+#define XXH_INLINE_ALL 1
+#include "xxhash.h"
+
 #ifdef _WIN32
 #include "common/RedtapeWindows.h"
 #endif
@@ -37,8 +48,14 @@ namespace GameList
 	enum : u32
 	{
 		GAME_LIST_CACHE_SIGNATURE = 0x45434C47,
-		GAME_LIST_CACHE_VERSION = 34,
+		GAME_LIST_CACHE_VERSION = 35,
+
+		// Probed entries are written out every this many seconds, so a crash or cancel part way
+		// through scanning a large library doesn't throw away everything which was probed.
+		// Each write rewrites the whole cache, so going by file count would make large scans quadratic.
+		GAME_LIST_CACHE_CHECKPOINT_SECONDS = 30,
 
+		MAX_SCAN_THREADS = 8,
 
 		PLAYED_TIME_SERIAL_LENGTH = 32,
 		PLAYED_TIME_LAST_TIME_LENGTH = 20, // uint64
@@ -46,13 +63,47 @@ namespace GameList
 		PLAYED_TIME_LINE_LENGTH = PLAYED_TIME_SERIAL_LENGTH + 1 + PLAYED_TIME_LAST_TIME_LENGTH + 1 + PLAYED_TIME_TOTAL_TIME_LENGTH,
 	};
 
+	// The cache is an index which is mapped and searched in place, instead of being read into
+	// memory on startup. Records are sorted by the hash of their path, and are followed by the
+	// string table, where each string is a u32 length and the characters.
+	struct CacheIndexHeader
+	{
+		u32 signature;
+		u32 version;
+		u32 num_records;
+		u32 strings_size;
+	};
+
+	struct CacheIndexRecord
+	{
+		u64 path_hash;
+		u64 total_size;
+		u64 last_modified_time;
+		u32 crc;
+		u32 path_offset; // offsets into the string table
+		u32 serial_offset;
+		u32 title_offset;
+		u32 title_sort_offset;
+		u32 title_en_offset;
+		u8 type;
+		u8 region;
+		u8 compatibility_rating;
+		u8 pad[5];
+	};
+	static_assert(sizeof(CacheIndexRecord) == 56);
+
+	struct ScanJob
+	{
+		std::string path;
+		std::time_t timestamp;
+	};
+
 	struct PlayedTimeEntry
 	{
 		std::time_t last_played_time;
 		std::time_t total_played_time;
 	};
 
-	using CacheMap = UnorderedStringMap<Entry>;
 	using PlayedTimeMap = UnorderedStringMap<PlayedTimeEntry>;
 
 	static bool IsScannableFilename(const std::string_view path);
@@ -64,18 +115,23 @@ namespace GameList
 
 	static bool GetGameListEntryFromCache(const std::string& path, GameList::Entry* entry);
 	static void ScanDirectory(const char* path, bool recursive, bool only_cache, const std::vector<std::string>& excluded_paths,
-		const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini, ProgressCallback* progress);
+		const PlayedTimeMap& played_time_map, std::vector<ScanJob>* jobs, ProgressCallback* progress);
+	static void ScanFiles(std::vector<ScanJob> jobs, const PlayedTimeMap& played_time_map,
+		const INISettingsInterface& custom_attributes_ini, ProgressCallback* progress);
 	static bool AddFileFromCache(const std::string& path, std::time_t timestamp, const PlayedTimeMap& played_time_map);
+	static bool ProbeFile(const std::string& path, std::time_t timestamp, const PlayedTimeMap& played_time_map,
+		const INISettingsInterface& custom_attributes_ini, Entry* entry);
+	static void AddScannedEntry(Entry entry);
 	static bool ScanFile(std::string path, std::time_t timestamp, std::unique_lock<std::recursive_mutex>& lock,
 		const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini);
 
 	static void LoadCache();
-	static bool LoadEntriesFromCache(std::FILE* stream);
-	static bool OpenCacheForWriting();
-	static bool WriteEntryToCache(const GameList::Entry* entry);
-	static void CloseCacheFileStream();
+	static void CloseCache();
+	static CacheIndexRecord GetCacheIndexRecord(u32 index);
+	static bool GetCacheIndexString(u32 offset, std::string_view* dest);
+	static bool ReadCacheIndexEntry(const CacheIndexRecord& record, Entry* entry);
+	static bool WriteCacheFile();
 	static void DeleteCacheFile();
-	static void RewriteCacheFile();
 
 	static std::string GetPlayedTimeFile();
 	static bool ParsePlayedTimeLine(char* line, std::string& serial, PlayedTimeEntry& entry);
@@ -91,8 +147,19 @@ namespace GameList
 
 static std::vector<GameList::Entry> s_entries;
 static std::recursive_mutex s_mutex;
-static GameList::CacheMap s_cache_map;
-static std::FILE* s_cache_write_stream = nullptr;
+
+// Files which aren't games, only kept so they're written back to the cache and not probed again.
+static std::vector<GameList::Entry> s_invalid_entries;
+
+// Mapped cache index, only open during the cache lookup part of a refresh.
+static std::span<const u8> s_cache_index;
+static std::span<const u8> s_cache_index_strings;
+static u32 s_cache_index_count = 0;
+static u32 s_cache_index_hits = 0;
+static std::vector<bool> s_cache_index_used;
+
+// CDVD is global state, so only one disc image can be opened for probing at a time.
+static std::mutex s_probe_mutex;
 
 const char* GameList::EntryTypeToString(EntryType type, bool translate)
 {
@@ -258,6 +325,7 @@ bool GameList::GetIsoSerialAndCRC(const std::string& path, s32* disc_type, std::
 	Error error;
 
 	// This isn't great, we really want to make it all thread-local...
+	std::unique_lock lock(s_probe_mutex);
 	CDVD = &CDVDapi_Iso;
 	if (!CDVD->open(path, &error))
 	{
@@ -447,110 +515,100 @@ bool GameList::PopulateEntryFromPath(const std::string& path, GameList::Entry* e
 
 bool GameList::GetGameListEntryFromCache(const std::string& path, GameList::Entry* entry)
 {
-	auto iter = s_cache_map.find(path);
-	if (iter == s_cache_map.end())
+	if (s_cache_index_count == 0)
 		return false;
 
-	*entry = std::move(iter->second);
-	s_cache_map.erase(iter);
-	return true;
-}
+	const u64 hash = XXH3_64bits(path.data(), path.size());
 
-static bool ReadString(std::FILE* stream, std::string* dest)
-{
-	u32 size;
-	if (std::fread(&size, sizeof(size), 1, stream) != 1)
-		return false;
+	// lower bound on the path hash
+	u32 first = 0;
+	u32 count = s_cache_index_count;
+	while (count > 0)
+	{
+		const u32 step = count / 2;
+		if (GetCacheIndexRecord(first + step).path_hash < hash)
+		{
+			first += step + 1;
+			count -= step + 1;
+		}
+		else
+		{
+			count = step;
+		}
+	}
 
-	dest->resize(size);
-	if (size > 0 && std::fread(dest->data(), size, 1, stream) != 1)
-		return false;
+	for (u32 i = first; i < s_cache_index_count; i++)
+	{
+		const CacheIndexRecord record = GetCacheIndexRecord(i);
+		if (record.path_hash != hash)
+			break;
 
-	return true;
-}
+		std::string_view record_path;
+		if (!GetCacheIndexString(record.path_offset, &record_path) || record_path != path)
+			continue;
 
-static bool ReadU8(std::FILE* stream, u8* dest)
-{
-	return std::fread(dest, sizeof(u8), 1, stream) > 0;
-}
+		if (!ReadCacheIndexEntry(record, entry))
+		{
+			Console.Warning("Game list cache entry is corrupted");
+			return false;
+		}
 
-static bool ReadU32(std::FILE* stream, u32* dest)
-{
-	return std::fread(dest, sizeof(u32), 1, stream) > 0;
-}
+		if (!s_cache_index_used[i])
+		{
+			s_cache_index_used[i] = true;
+			s_cache_index_hits++;
+		}
 
-static bool ReadU64(std::FILE* stream, u64* dest)
-{
-	return std::fread(dest, sizeof(u64), 1, stream) > 0;
-}
+		return true;
+	}
 
-static bool WriteString(std::FILE* stream, const std::string& str)
-{
-	const u32 size = static_cast<u32>(str.size());
-	return (std::fwrite(&size, sizeof(size), 1, stream) > 0 && (size == 0 || std::fwrite(str.data(), size, 1, stream) > 0));
+	return false;
 }
 
-static bool WriteU8(std::FILE* stream, u8 dest)
+GameList::CacheIndexRecord GameList::GetCacheIndexRecord(u32 index)
 {
-	return std::fwrite(&dest, sizeof(u8), 1, stream) > 0;
+	CacheIndexRecord record;
+	std::memcpy(&record, s_cache_index.data() + sizeof(CacheIndexHeader) + index * sizeof(CacheIndexRecord), sizeof(record));
+	return record;
 }
 
-static bool WriteU32(std::FILE* stream, u32 dest)
+bool GameList::GetCacheIndexString(u32 offset, std::string_view* dest)
 {
-	return std::fwrite(&dest, sizeof(u32), 1, stream) > 0;
-}
+	u32 size;
+	if (static_cast<size_t>(offset) + sizeof(size) > s_cache_index_strings.size())
+		return false;
 
-static bool WriteU64(std::FILE* stream, u64 dest)
-{
-	return std::fwrite(&dest, sizeof(u64), 1, stream) > 0;
+	std::memcpy(&size, s_cache_index_strings.data() + offset, sizeof(size));
+	if (static_cast<size_t>(offset) + sizeof(size) + size > s_cache_index_strings.size())
+		return false;
+
+	*dest = std::string_view(reinterpret_cast<const char*>(s_cache_index_strings.data() + offset + sizeof(size)), size);
+	return true;
 }
 
-bool GameList::LoadEntriesFromCache(std::FILE* stream)
+bool GameList::ReadCacheIndexEntry(const CacheIndexRecord& record, Entry* entry)
 {
-	u32 file_signature, file_version;
-	s64 start_pos, file_size;
-	if (!ReadU32(stream, &file_signature) || !ReadU32(stream, &file_version) || file_signature != GAME_LIST_CACHE_SIGNATURE ||
-		file_version != GAME_LIST_CACHE_VERSION || (start_pos = FileSystem::FTell64(stream)) < 0 ||
-		FileSystem::FSeek64(stream, 0, SEEK_END) != 0 || (file_size = FileSystem::FTell64(stream)) < 0 ||
-		FileSystem::FSeek64(stream, start_pos, SEEK_SET) != 0)
+	std::string_view path, serial, title, title_sort, title_en;
+	if (!GetCacheIndexString(record.path_offset, &path) || !GetCacheIndexString(record.serial_offset, &serial) ||
+		!GetCacheIndexString(record.title_offset, &title) || !GetCacheIndexString(record.title_sort_offset, &title_sort) ||
+		!GetCacheIndexString(record.title_en_offset, &title_en) || record.region >= static_cast<u8>(Region::Count) ||
+		record.type >= static_cast<u8>(EntryType::Count) ||
+		record.compatibility_rating > static_cast<u8>(CompatibilityRating::Perfect))
 	{
-		Console.Warning("Game list cache is corrupted");
 		return false;
 	}
 
-	while (FileSystem::FTell64(stream) != file_size)
-	{
-		std::string path;
-		GameList::Entry ge;
-
-		u8 type;
-		u8 region;
-		u8 compatibility_rating;
-		u64 last_modified_time;
-
-		if (!ReadString(stream, &path) || !ReadString(stream, &ge.serial) || !ReadString(stream, &ge.title) || !ReadString(stream, &ge.title_sort) ||
-			!ReadString(stream, &ge.title_en) || !ReadU8(stream, &type) || !ReadU8(stream, &region) || !ReadU64(stream, &ge.total_size) ||
-			!ReadU64(stream, &last_modified_time) || !ReadU32(stream, &ge.crc) || !ReadU8(stream, &compatibility_rating) ||
-			region >= static_cast<u8>(Region::Count) || type >= static_cast<u8>(EntryType::Count) ||
-			compatibility_rating > static_cast<u8>(CompatibilityRating::Perfect))
-		{
-			Console.Warning("Game list cache entry is corrupted");
-			return false;
-		}
-
-		ge.path = path;
-		ge.region = static_cast<Region>(region);
-		ge.type = static_cast<EntryType>(type);
-		ge.compatibility_rating = static_cast<CompatibilityRating>(compatibility_rating);
-		ge.last_modified_time = static_cast<std::time_t>(last_modified_time);
-
-		auto iter = s_cache_map.find(ge.path);
-		if (iter != s_cache_map.end())
-			iter->second = std::move(ge);
-		else
-			s_cache_map.emplace(std::move(path), std::move(ge));
-	}
-
+	entry->path = path;
+	entry->serial = serial;
+	entry->title = title;
+	entry->title_sort = title_sort;
+	entry->title_en = title_en;
+	entry->type = static_cast<EntryType>(record.type);
+	entry->region = static_cast<Region>(record.region);
+	entry->total_size = record.total_size;
+	entry->last_modified_time = static_cast<std::time_t>(record.last_modified_time);
+	entry->crc = record.crc;
+	entry->compatibility_rating = static_cast<CompatibilityRating>(record.compatibility_rating);
 	return true;
 }
 
@@ -561,97 +619,126 @@ static std::string GetCacheFilename()
 
 void GameList::LoadCache()
 {
+	CloseCache();
+
 	const std::string cache_filename(GetCacheFilename());
-	auto stream = FileSystem::OpenManagedCFile(cache_filename.c_str(), "rb");
-	if (!stream)
+	if (!FileSystem::FileExists(cache_filename.c_str()))
 		return;
 
-	if (!LoadEntriesFromCache(stream.get()))
+	s_cache_index = FileSystem::MapBinaryFileForRead(cache_filename.c_str());
+
+	CacheIndexHeader header = {};
+	if (s_cache_index.size() >= sizeof(header))
+		std::memcpy(&header, s_cache_index.data(), sizeof(header));
+
+	const size_t strings_start = sizeof(header) + static_cast<size_t>(header.num_records) * sizeof(CacheIndexRecord);
+	if (header.signature != GAME_LIST_CACHE_SIGNATURE || header.version != GAME_LIST_CACHE_VERSION ||
+		strings_start + header.strings_size != s_cache_index.size())
 	{
+		Console.Warning("Game list cache is corrupted");
 		Console.Warning("Deleting corrupted cache file '%s'", cache_filename.c_str());
-		stream.reset();
-		s_cache_map.clear();
+		CloseCache();
 		DeleteCacheFile();
 		return;
 	}
+
+	s_cache_index_strings = s_cache_index.subspan(strings_start);
+	s_cache_index_count = header.num_records;
+	s_cache_index_hits = 0;
+	s_cache_index_used.assign(s_cache_index_count, false);
 }
 
-bool GameList::OpenCacheForWriting()
+void GameList::CloseCache()
+{
+	if (!s_cache_index.empty())
+		FileSystem::UnmapFile(s_cache_index);
+
+	s_cache_index = {};
+	s_cache_index_strings = {};
+	s_cache_index_count = 0;
+	s_cache_index_hits = 0;
+	s_cache_index_used = {};
+}
+
+bool GameList::WriteCacheFile()
 {
 	const std::string cache_filename(GetCacheFilename());
 	if (cache_filename.empty())
 		return false;
 
-	pxAssert(!s_cache_write_stream);
-	s_cache_write_stream = FileSystem::OpenCFile(cache_filename.c_str(), "r+b");
-	if (s_cache_write_stream)
-	{
-		// check the header
-		u32 signature, version;
-		if (ReadU32(s_cache_write_stream, &signature) && signature == GAME_LIST_CACHE_SIGNATURE &&
-			ReadU32(s_cache_write_stream, &version) && version == GAME_LIST_CACHE_VERSION &&
-			FileSystem::FSeek64(s_cache_write_stream, 0, SEEK_END) == 0)
-		{
-			return true;
-		}
+	std::vector<CacheIndexRecord> records;
+	std::vector<u8> strings;
+	const auto add_string = [&strings](const std::string& str) {
+		const u32 offset = static_cast<u32>(strings.size());
+		const u32 size = static_cast<u32>(str.size());
+		strings.resize(offset + sizeof(size) + size);
+		std::memcpy(&strings[offset], &size, sizeof(size));
+		std::memcpy(&strings[offset + sizeof(size)], str.data(), size);
+		return offset;
+	};
+	const auto add_entry = [&records, &add_string](const Entry& entry) {
+		CacheIndexRecord& record = records.emplace_back();
+		std::memset(&record, 0, sizeof(record));
+		record.path_hash = XXH3_64bits(entry.path.data(), entry.path.size());
+		record.total_size = entry.total_size;
+		record.last_modified_time = static_cast<u64>(entry.last_modified_time);
+		record.crc = entry.crc;
+		record.path_offset = add_string(entry.path);
+		record.serial_offset = add_string(entry.serial);
+		record.title_offset = add_string(entry.title);
+		record.title_sort_offset = add_string(entry.title_sort);
+		record.title_en_offset = add_string(entry.title_en);
+		record.type = static_cast<u8>(entry.type);
+		record.region = static_cast<u8>(entry.region);
+		record.compatibility_rating = static_cast<u8>(entry.compatibility_rating);
+	};
 
-		std::fclose(s_cache_write_stream);
+	{
+		std::unique_lock lock(s_mutex);
+		records.reserve(s_entries.size() + s_invalid_entries.size());
+		for (const Entry& entry : s_entries)
+			add_entry(entry);
+		for (const Entry& entry : s_invalid_entries)
+			add_entry(entry);
 	}
 
-	Console.WriteLn("Creating new game list cache file: '%s'", cache_filename.c_str());
+	std::sort(records.begin(), records.end(),
+		[](const CacheIndexRecord& lhs, const CacheIndexRecord& rhs) { return lhs.path_hash < rhs.path_hash; });
 
-	s_cache_write_stream = FileSystem::OpenCFile(cache_filename.c_str(), "w+b");
-	if (!s_cache_write_stream)
-		return false;
+	CacheIndexHeader header;
+	header.signature = GAME_LIST_CACHE_SIGNATURE;
+	header.version = GAME_LIST_CACHE_VERSION;
+	header.num_records = static_cast<u32>(records.size());
+	header.strings_size = static_cast<u32>(strings.size());
 
+	// Write to a temporary file and swap it in, so there's always a complete cache on disk.
+	Error error;
+	const std::string temp_filename(cache_filename + ".tmp");
+	auto fp = FileSystem::OpenManagedCFile(temp_filename.c_str(), "wb", &error);
+	if (!fp || std::fwrite(&header, sizeof(header), 1, fp.get()) != 1 ||
+		(!records.empty() && std::fwrite(records.data(), records.size() * sizeof(CacheIndexRecord), 1, fp.get()) != 1) ||
+		(!strings.empty() && std::fwrite(strings.data(), strings.size(), 1, fp.get()) != 1) || std::fflush(fp.get()) != 0)
+	{
+		Console.Error(fmt::format("Failed to write game list cache '{}': {}", temp_filename, error.GetDescription()));
+		fp.reset();
+		FileSystem::DeleteFilePath(temp_filename.c_str());
+		return false;
+	}
 
-	// new cache file, write header
-	if (!WriteU32(s_cache_write_stream, GAME_LIST_CACHE_SIGNATURE) || !WriteU32(s_cache_write_stream, GAME_LIST_CACHE_VERSION))
+	fp.reset();
+	if (!FileSystem::RenamePath(temp_filename.c_str(), cache_filename.c_str(), &error))
 	{
-		Console.Error("Failed to write game list cache header");
-		std::fclose(s_cache_write_stream);
-		s_cache_write_stream = nullptr;
-		FileSystem::DeleteFilePath(cache_filename.c_str());
+		Console.Error(fmt::format("Failed to replace game list cache '{}': {}", cache_filename, error.GetDescription()));
+		FileSystem::DeleteFilePath(temp_filename.c_str());
 		return false;
 	}
 
 	return true;
 }
 
-bool GameList::WriteEntryToCache(const Entry* entry)
-{
-	bool result = true;
-	result &= WriteString(s_cache_write_stream, entry->path);
-	result &= WriteString(s_cache_write_stream, entry->serial);
-	result &= WriteString(s_cache_write_stream, entry->title);
-	result &= WriteString(s_cache_write_stream, entry->title_sort);
-	result &= WriteString(s_cache_write_stream, entry->title_en);
-	result &= WriteU8(s_cache_write_stream, static_cast<u8>(entry->type));
-	result &= WriteU8(s_cache_write_stream, static_cast<u8>(entry->region));
-	result &= WriteU64(s_cache_write_stream, entry->total_size);
-	result &= WriteU64(s_cache_write_stream, static_cast<u64>(entry->last_modified_time));
-	result &= WriteU32(s_cache_write_stream, entry->crc);
-	result &= WriteU8(s_cache_write_stream, static_cast<u8>(entry->compatibility_rating));
-
-	// flush after each entry, that way we don't end up with a corrupted file if we crash scanning.
-	if (result)
-		result = (std::fflush(s_cache_write_stream) == 0);
-
-	return result;
-}
-
-void GameList::CloseCacheFileStream()
-{
-	if (!s_cache_write_stream)
-		return;
-
-	std::fclose(s_cache_write_stream);
-	s_cache_write_stream = nullptr;
-}
-
 void GameList::DeleteCacheFile()
 {
-	pxAssert(!s_cache_write_stream);
+	pxAssert(s_cache_index.empty());
 
 	const std::string cache_filename(GetCacheFilename());
 	if (cache_filename.empty() || !FileSystem::FileExists(cache_filename.c_str()))
@@ -663,27 +750,13 @@ void GameList::DeleteCacheFile()
 		Console.Warning("Failed to delete game list cache '%s'", cache_filename.c_str());
 }
 
-void GameList::RewriteCacheFile()
-{
-	CloseCacheFileStream();
-	DeleteCacheFile();
-
-	if (OpenCacheForWriting())
-	{
-		for (const GameList::Entry& entry : s_entries)
-			WriteEntryToCache(&entry);
-
-		CloseCacheFileStream();
-	}
-}
-
 static bool IsPathExcluded(const std::vector<std::string>& excluded_paths, const std::string& path)
 {
 	return std::find_if(excluded_paths.begin(), excluded_paths.end(), [&path](const std::string& entry) { return !entry.empty() && path.starts_with(entry); }) != excluded_paths.end();
 }
 
 void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache, const std::vector<std::string>& excluded_paths,
-	const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini, ProgressCallback* progress)
+	const PlayedTimeMap& played_time_map, std::vector<ScanJob>* jobs, ProgressCallback* progress)
 {
 	Console.WriteLn("Scanning %s%s", path, recursive ? " (recursively)" : "");
 
@@ -715,22 +788,119 @@ void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache,
 			continue;
 		}
 
+		// Files which aren't cached are probed afterwards, all directories at once.
 		std::unique_lock lock(s_mutex);
 		if (GetEntryForPath(ffd.FileName.c_str()) || AddFileFromCache(ffd.FileName, ffd.ModificationTime, played_time_map) || only_cache)
 		{
 			continue;
 		}
 
-		const std::string_view filename = Path::GetFileName(ffd.FileName);
-		progress->SetStatusText(fmt::format(TRANSLATE_FS("GameList", "Scanning {}..."), filename.data()).c_str());
-		ScanFile(std::move(ffd.FileName), ffd.ModificationTime, lock, played_time_map, custom_attributes_ini);
-		progress->SetProgressValue(files_scanned);
+		jobs->push_back(ScanJob{std::move(ffd.FileName), ffd.ModificationTime});
 	}
 
 	progress->SetProgressValue(files_scanned);
 	progress->PopState();
 }
 
+void GameList::ScanFiles(std::vector<ScanJob> jobs, const PlayedTimeMap& played_time_map,
+	const INISettingsInterface& custom_attributes_ini, ProgressCallback* progress)
+{
+	// The same file can be reached through more than one directory.
+	std::sort(jobs.begin(), jobs.end(), [](const ScanJob& lhs, const ScanJob& rhs) { return lhs.path < rhs.path; });
+	jobs.erase(std::unique(jobs.begin(), jobs.end(), [](const ScanJob& lhs, const ScanJob& rhs) { return lhs.path == rhs.path; }),
+		jobs.end());
+	if (jobs.empty())
+		return;
+
+	progress->PushState();
+	progress->SetProgressRange(static_cast<u32>(jobs.size()));
+	progress->SetProgressValue(0);
+
+	std::mutex state_mutex;
+	std::condition_variable state_cv;
+	std::atomic<size_t> next_job{0};
+	std::atomic_bool cancelled{false};
+	size_t jobs_done = 0;
+	u32 workers_running = 0;
+	size_t last_done_job = 0;
+
+	const auto worker = [&]() {
+		Threading::SetNameOfCurrentThread("Game List Scan");
+
+		for (;;)
+		{
+			const size_t index = next_job.fetch_add(1, std::memory_order_relaxed);
+			if (index >= jobs.size() || cancelled.load(std::memory_order_relaxed))
+				break;
+
+			Entry entry;
+			if (ProbeFile(jobs[index].path, jobs[index].timestamp, played_time_map, custom_attributes_ini, &entry))
+			{
+				std::unique_lock lock(s_mutex);
+				AddScannedEntry(std::move(entry));
+			}
+
+			std::unique_lock lock(state_mutex);
+			jobs_done++;
+			last_done_job = index;
+			state_cv.notify_one();
+		}
+
+		std::unique_lock lock(state_mutex);
+		workers_running--;
+		state_cv.notify_one();
+	};
+
+	const u32 num_threads = static_cast<u32>(std::min<size_t>(
+		jobs.size(), std::clamp(std::thread::hardware_concurrency(), 1u, static_cast<u32>(MAX_SCAN_THREADS))));
+	std::vector<Threading::Thread> threads(num_threads);
+	workers_running = num_threads;
+	for (Threading::Thread& thread : threads)
+		thread.Start(worker);
+
+	size_t jobs_checkpointed = 0;
+	Common::Timer checkpoint_timer;
+	std::unique_lock lock(state_mutex);
+	for (;;)
+	{
+		state_cv.wait_for(lock, std::chrono::milliseconds(100));
+
+		const size_t done = jobs_done;
+		const std::string_view filename = Path::GetFileName(jobs[last_done_job].path);
+		lock.unlock();
+
+		if (progress->IsCancelled())
+			cancelled.store(true, std::memory_order_relaxed);
+
+		if (done > 0)
+		{
+			progress->SetStatusText(fmt::format(TRANSLATE_FS("GameList", "Scanning {}..."), filename).c_str());
+			progress->SetProgressValue(static_cast<u32>(done));
+		}
+
+		if (done != jobs_checkpointed && checkpoint_timer.GetTimeSeconds() >= static_cast<double>(GAME_LIST_CACHE_CHECKPOINT_SECONDS))
+		{
+			WriteCacheFile();
+			jobs_checkpointed = done;
+			checkpoint_timer.Reset();
+		}
+
+		lock.lock();
+		if (workers_running == 0)
+			break;
+	}
+	lock.unlock();
+
+	for (Threading::Thread& thread : threads)
+		thread.Join();
+
+	if (jobs_done != jobs_checkpointed)
+		WriteCacheFile();
+
+	progress->SetProgressValue(static_cast<u32>(jobs_done));
+	progress->PopState();
+}
+
 bool GameList::AddFileFromCache(const std::string& path, std::time_t timestamp, const PlayedTimeMap& played_time_map)
 {
 	Entry entry;
@@ -739,7 +909,15 @@ bool GameList::AddFileFromCache(const std::string& path, std::time_t timestamp,
 
 	// Skip over invalid entries.
 	if (entry.type == EntryType::Invalid)
+	{
+		if (std::none_of(s_invalid_entries.begin(), s_invalid_entries.end(),
+				[&path](const Entry& existing_entry) { return (existing_entry.path == path); }))
+		{
+			s_invalid_entries.push_back(std::move(entry));
+		}
+
 		return true;
+	}
 
 	auto iter = played_time_map.find(entry.serial);
 	if (iter != played_time_map.end())
@@ -752,65 +930,78 @@ bool GameList::AddFileFromCache(const std::string& path, std::time_t timestamp,
 	return true;
 }
 
-bool GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_lock<std::recursive_mutex>& lock,
-	const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini)
+bool GameList::ProbeFile(const std::string& path, std::time_t timestamp, const PlayedTimeMap& played_time_map,
+	const INISettingsInterface& custom_attributes_ini, Entry* entry)
 {
-	// don't block UI while scanning
-	lock.unlock();
-
 	DevCon.WriteLn("Scanning '%s'...", path.c_str());
 
-	Entry entry;
-	if (!PopulateEntryFromPath(path, &entry))
+	if (!PopulateEntryFromPath(path, entry))
 		return false;
 
-	entry.last_modified_time = timestamp;
+	entry->last_modified_time = timestamp;
 
-	if (s_cache_write_stream || OpenCacheForWriting())
-	{
-		if (!WriteEntryToCache(&entry))
-			Console.Warning("Failed to write entry '%s' to cache", entry.path.c_str());
-	}
-
-	if (entry.type == EntryType::Invalid)
-	{
-		// don't add invalid entries to list
-		lock.lock();
+	// don't need anything else for invalid entries, they're only cached
+	if (entry->type == EntryType::Invalid)
 		return true;
-	}
 
-	const auto iter = played_time_map.find(entry.serial);
+	const auto iter = played_time_map.find(entry->serial);
 	if (iter != played_time_map.end())
 	{
-		entry.last_played_time = iter->second.last_played_time;
-		entry.total_played_time = iter->second.total_played_time;
+		entry->last_played_time = iter->second.last_played_time;
+		entry->total_played_time = iter->second.total_played_time;
 	}
 
-	auto custom_title = custom_attributes_ini.GetOptionalStringValue(EncodeIniKey(entry.path).c_str(), "Title");
+	auto custom_title = custom_attributes_ini.GetOptionalStringValue(EncodeIniKey(entry->path).c_str(), "Title");
 	if (custom_title)
 	{
-		entry.title = std::move(custom_title.value());
+		entry->title = std::move(custom_title.value());
 	}
-	const auto custom_region = custom_attributes_ini.GetOptionalIntValue(EncodeIniKey(entry.path).c_str(), "Region");
+	const auto custom_region = custom_attributes_ini.GetOptionalIntValue(EncodeIniKey(entry->path).c_str(), "Region");
 	if (custom_region)
 	{
 		const int custom_region_value = custom_region.value();
 		if (custom_region_value >= 0 && custom_region_value < static_cast<int>(Region::Count))
 		{
-			entry.region = static_cast<Region>(custom_region_value);
+			entry->region = static_cast<Region>(custom_region_value);
 		}
 	}
 
-	lock.lock();
+	return true;
+}
 
+void GameList::AddScannedEntry(Entry entry)
+{
 	// remove if present
-	auto it = std::find_if(
-		s_entries.begin(), s_entries.end(), [&entry](const Entry& existing_entry) { return (existing_entry.path == entry.path); });
-	if (it != s_entries.end())
-		s_entries.erase(it);
+	const auto remove_path = [&entry](std::vector<Entry>& entries) {
+		auto it = std::find_if(
+			entries.begin(), entries.end(), [&entry](const Entry& existing_entry) { return (existing_entry.path == entry.path); });
+		if (it != entries.end())
+			entries.erase(it);
+	};
+	remove_path(s_entries);
+	remove_path(s_invalid_entries);
 
-	s_entries.push_back(std::move(entry));
-	return true;
+	// don't add invalid entries to list
+	if (entry.type == EntryType::Invalid)
+		s_invalid_entries.push_back(std::move(entry));
+	else
+		s_entries.push_back(std::move(entry));
+}
+
+bool GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_lock<std::recursive_mutex>& lock,
+	const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini)
+{
+	// don't block UI while scanning
+	lock.unlock();
+
+	Entry entry;
+	const bool result = ProbeFile(path, timestamp, played_time_map, custom_attributes_ini, &entry);
+
+	lock.lock();
+	if (result)
+		AddScannedEntry(std::move(entry));
+
+	return result;
 }
 
 std::unique_lock<std::recursive_mutex> GameList::GetLock()
@@ -886,6 +1077,7 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
 	{
 		std::unique_lock lock(s_mutex);
 		old_entries.swap(s_entries);
+		s_invalid_entries.clear();
 	}
 
 	const std::vector<std::string> excluded_paths(Host::GetBaseStringListSetting("GameList", "ExcludedPaths"));
@@ -895,34 +1087,51 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
 	INISettingsInterface custom_attributes_ini(GetCustomPropertiesFile());
 	custom_attributes_ini.Load();
 
-	if (!dirs.empty() || !recursive_dirs.empty())
+	if (dirs.empty() && recursive_dirs.empty())
 	{
-		progress->SetProgressRange(static_cast<u32>(dirs.size() + recursive_dirs.size()));
-		progress->SetProgressValue(0);
+		CloseCache();
+		return;
+	}
 
-		// we manually count it here, because otherwise pop state updates it itself
-		int directory_counter = 0;
-		for (const std::string& dir : dirs)
-		{
-			if (progress->IsCancelled())
-				break;
+	// One step per directory, plus one for probing everything which wasn't in the cache.
+	progress->SetProgressRange(static_cast<u32>(dirs.size() + recursive_dirs.size() + 1));
+	progress->SetProgressValue(0);
 
-			ScanDirectory(dir.c_str(), false, only_cache, excluded_paths, played_time, custom_attributes_ini, progress);
-			progress->SetProgressValue(++directory_counter);
-		}
-		for (const std::string& dir : recursive_dirs)
-		{
-			if (progress->IsCancelled())
-				break;
+	// we manually count it here, because otherwise pop state updates it itself
+	int directory_counter = 0;
+	std::vector<ScanJob> jobs;
+	for (const std::string& dir : dirs)
+	{
+		if (progress->IsCancelled())
+			break;
 
-			ScanDirectory(dir.c_str(), true, only_cache, excluded_paths, played_time, custom_attributes_ini, progress);
-			progress->SetProgressValue(++directory_counter);
-		}
+		ScanDirectory(dir.c_str(), false, only_cache, excluded_paths, played_time, &jobs, progress);
+		progress->SetProgressValue(++directory_counter);
+	}
+	for (const std::string& dir : recursive_dirs)
+	{
+		if (progress->IsCancelled())
+			break;
+
+		ScanDirectory(dir.c_str(), true, only_cache, excluded_paths, played_time, &jobs, progress);
+		progress->SetProgressValue(++directory_counter);
 	}
 
-	// don't need unused cache entries
-	CloseCacheFileStream();
-	s_cache_map.clear();
+	// Everything which is still needed from the cache has been looked up now. If we didn't get
+	// through all directories, we can't tell which entries are stale, so leave the cache alone.
+	const bool cache_complete = !progress->IsCancelled();
+	const bool cache_has_unused_entries = (s_cache_index_hits != s_cache_index_count);
+	CloseCache();
+
+	if (!cache_complete)
+		return;
+
+	if (!jobs.empty())
+		ScanFiles(std::move(jobs), played_time, custom_attributes_ini, progress);
+	else if (cache_has_unused_entries || invalidate_cache)
+		WriteCacheFile();
+
+	progress->SetProgressValue(++directory_counter);
 }
 
 bool GameList::RescanPath(const std::string& path)
@@ -948,8 +1157,8 @@ bool GameList::RescanPath(const std::string& path)
 	if (!ScanFile(path, sd.ModificationTime, lock, played_time, custom_attributes_ini))
 		return true;
 
-	// update cache.. this is far from ideal, but since everything's variable length, all we can do.
-	RewriteCacheFile();
+	// update cache
+	WriteCacheFile();
 	return true;
 }
 
@@ -9,6 +9,7 @@
 #include "ImGui/ImGuiOverlays.h"
 #include "Input/InputManager.h"
 #include "Recording/InputRecording.h"
+#include "Rewind.h"
 #include "SPU2/spu2.h"
 #include "VMManager.h"
 #include "SIO/Memcard/MemoryCardFile.h"
@@ -117,6 +118,36 @@ static void HotkeySaveStateSlot(s32 slot)
 	});
 }
 
+static void HotkeyRewind()
+{
+	Host::RunOnCPUThread([]() {
+		if (!VMManager::HasValidVM())
+			return;
+
+		if (!EmuConfig.Savestate.RewindEnabled || Rewind::GetSnapshotCount() == 0)
+		{
+			Host::AddIconOSDMessage("Rewind", ICON_FA_TRIANGLE_EXCLAMATION,
+				TRANSLATE_STR("Hotkeys", "No rewind snapshots are available."), Host::OSD_QUICK_DURATION);
+			return;
+		}
+
+		// Go back roughly one second per press.
+		const float snapshots_per_second = VMManager::GetFrameRate() / static_cast<float>(EmuConfig.Savestate.RewindFrequency);
+		const u32 count = std::max(static_cast<u32>(std::round(snapshots_per_second)), 1u);
+
+		Error error;
+		if (!Rewind::RewindSnapshots(count, &error))
+		{
+			Host::AddIconOSDMessage("Rewind", ICON_FA_TRIANGLE_EXCLAMATION,
+				fmt::format(TRANSLATE_FS("Hotkeys", "Failed to rewind: {}"), error.GetDescription()),
+				Host::OSD_ERROR_DURATION);
+			return;
+		}
+
+		Host::AddIconOSDMessage("Rewind", ICON_FA_BACKWARD, TRANSLATE_STR("Hotkeys", "Rewound."), Host::OSD_QUICK_DURATION);
+	});
+}
+
 static bool CanPause()
 {
 	static constexpr const float PAUSE_INTERVAL = 3.0f;
@@ -287,6 +318,11 @@ DEFINE_HOTKEY("LoadBackupStateFromSlot", TRANSLATE_NOOP("Hotkeys", "Save States"
 		if (!pressed && VMManager::HasValidVM())
 			SaveStateSelectorUI::LoadCurrentBackupSlot();
 	})
+DEFINE_HOTKEY("Rewind", TRANSLATE_NOOP("Hotkeys", "Save States"),
+	TRANSLATE_NOOP("Hotkeys", "Rewind"), [](s32 pressed) {
+		if (!pressed && VMManager::HasValidVM())
+			HotkeyRewind();
+	})
 DEFINE_HOTKEY("SaveStateAndSelectNextSlot", TRANSLATE_NOOP("Hotkeys", "Save States"),
 	TRANSLATE_NOOP("Hotkeys", "Save State and Select Next Slot"), [](s32 pressed) {
 		if (!pressed && VMManager::HasValidVM())
@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-2.0+
+
+// The IDCT is based on the one in the mpeg2dec library,
+//
+// Copyright (C) 2000-2002 Michel Lespinasse <walken@zoy.org>
+// Copyright (C) 1999-2000 Aaron Holtzman <aholtzma@ess.engr.uvic.ca>
+//
+// under the GPL license.
+
+#pragma once
+
+#include "GS/GSVector.h"
+#include "GS/MultiISA.h"
+
+#define W1 2841 /* 2048*sqrt (2)*cos (1*pi/16) */
+#define W2 2676 /* 2048*sqrt (2)*cos (2*pi/16) */
+#define W3 2408 /* 2048*sqrt (2)*cos (3*pi/16) */
+#define W5 1609 /* 2048*sqrt (2)*cos (5*pi/16) */
+#define W6 1108 /* 2048*sqrt (2)*cos (6*pi/16) */
+#define W7 565  /* 2048*sqrt (2)*cos (7*pi/16) */
+
+/*
+ * In legal streams, the IDCT output should be between -384 and +384.
+ * In corrupted streams, it is possible to force the IDCT output to go
+ * to +-3826 - this is the worst case for a column IDCT where the
+ * column inputs are 16-bit values.
+ */
+
+MULTI_ISA_UNSHARED_START
+
+__forceinline static void IDCT_Butterfly(GSVector4i& t0, GSVector4i& t1, int w0, int w1, const GSVector4i& d0, const GSVector4i& d1)
+{
+	const GSVector4i tmp = d0.add32(d1).mul32l(GSVector4i(w0));
+	t0 = tmp.add32(d1.mul32l(GSVector4i(w1 - w0)));
+	t1 = tmp.sub32(d0.mul32l(GSVector4i(w1 + w0)));
+}
+
+/// One pass of the IDCT over four rows or columns at once, in 32-bit lanes. x[k] holds element k of each.
+/// The rounding of the row and column passes differs, it has to match the scalar version exactly.
+template <bool column>
+__forceinline static void IDCT_Pass(GSVector4i (&x)[8])
+{
+	GSVector4i a0, a1, a2, a3;
+	{
+		const GSVector4i d0 = x[0].sll32<11>().add32(GSVector4i(column ? 65536 : 128));
+		const GSVector4i d2 = x[2].sll32<11>();
+		const GSVector4i t0 = d0.add32(d2);
+		const GSVector4i t1 = d0.sub32(d2);
+		GSVector4i t2, t3;
+		IDCT_Butterfly(t2, t3, W6, W2, x[3], x[1]);
+		a0 = t0.add32(t2);
+		a1 = t1.add32(t3);
+		a2 = t1.sub32(t3);
+		a3 = t0.sub32(t2);
+	}
+
+	GSVector4i b0, b1, b2, b3;
+	{
+		GSVector4i t0, t1, t2, t3;
+		IDCT_Butterfly(t0, t1, W7, W1, x[7], x[4]);
+		IDCT_Butterfly(t2, t3, W3, W5, x[5], x[6]);
+		b0 = t0.add32(t2);
+		b3 = t1.add32(t3);
+		t0 = t0.sub32(t2);
+		t1 = t1.sub32(t3);
+		if constexpr (column)
+		{
+			t0 = t0.sra32<8>();
+			t1 = t1.sra32<8>();
+			b1 = t0.add32(t1).mul32l(GSVector4i(181));
+			b2 = t0.sub32(t1).mul32l(GSVector4i(181));
+		}
+		else
+		{
+			b1 = t0.add32(t1).mul32l(GSVector4i(181)).sra32<8>();
+			b2 = t0.sub32(t1).mul32l(GSVector4i(181)).sra32<8>();
+		}
+	}
+
+	constexpr int shift = column ? 17 : 8;
+	x[0] = a0.add32(b0).sra32<shift>();
+	x[1] = a1.add32(b1).sra32<shift>();
+	x[2] = a2.add32(b2).sra32<shift>();
+	x[3] = a3.add32(b3).sra32<shift>();
+	x[4] = a3.sub32(b3).sra32<shift>();
+	x[5] = a2.sub32(b2).sra32<shift>();
+	x[6] = a1.sub32(b1).sra32<shift>();
+	x[7] = a0.sub32(b0).sra32<shift>();
+}
+
+/// Transposes an 8x8 block of 16-bit values, one row per vector.
+__forceinline static void IDCT_Transpose(GSVector4i (&v)[8])
+{
+	const GSVector4i a0 = v[0].upl16(v[1]);
+	const GSVector4i a1 = v[0].uph16(v[1]);
+	const GSVector4i a2 = v[2].upl16(v[3]);
+	const GSVector4i a3 = v[2].uph16(v[3]);
+	const GSVector4i a4 = v[4].upl16(v[5]);
+	const GSVector4i a5 = v[4].uph16(v[5]);
+	const GSVector4i a6 = v[6].upl16(v[7]);
+	const GSVector4i a7 = v[6].uph16(v[7]);
+
+	const GSVector4i b0 = a0.upl32(a2);
+	const GSVector4i b1 = a0.uph32(a2);
+	const GSVector4i b2 = a1.upl32(a3);
+	const GSVector4i b3 = a1.uph32(a3);
+	const GSVector4i b4 = a4.upl32(a6);
+	const GSVector4i b5 = a4.uph32(a6);
+	const GSVector4i b6 = a5.upl32(a7);
+	const GSVector4i b7 = a5.uph32(a7);
+
+	v[0] = b0.upl64(b4);
+	v[1] = b0.uph64(b4);
+	v[2] = b1.upl64(b5);
+	v[3] = b1.uph64(b5);
+	v[4] = b2.upl64(b6);
+	v[5] = b2.uph64(b6);
+	v[6] = b3.upl64(b7);
+	v[7] = b3.uph64(b7);
+}
+
+/// Runs one pass over eight rows or columns of 16-bit values. The results are truncated to 16 bits,
+/// like the stores in the scalar version, so out of range values in corrupted streams wrap the same way.
+template <bool column>
+__forceinline static void IDCT_Pass16(GSVector4i (&v)[8])
+{
+	GSVector4i lo[8], hi[8];
+	for (int i = 0; i < 8; i++)
+	{
+		lo[i] = v[i].i16to32();
+		hi[i] = v[i].uph64().i16to32();
+	}
+
+	IDCT_Pass<column>(lo);
+	IDCT_Pass<column>(hi);
+
+	for (int i = 0; i < 8; i++)
+		v[i] = lo[i].sll32<16>().sra32<16>().ps32(hi[i].sll32<16>().sra32<16>());
+}
+
+/// Inverse transforms a 16-byte aligned block, leaving the result in rows, one per vector.
+/// Bit exact with the scalar mpeg2dec IDCT.
+__forceinline static void IDCT_Rows(const s16* block, GSVector4i (&rows)[8])
+{
+	for (int i = 0; i < 8; i++)
+		rows[i] = GSVector4i::load<true>(block + 8 * i);
+
+	// Rows are transformed first, which means working on the transpose so each lane is one row.
+	IDCT_Transpose(rows);
+	IDCT_Pass16<false>(rows);
+	IDCT_Transpose(rows);
+	IDCT_Pass16<true>(rows);
+}
+
+__forceinline static void IDCT_Block(s16* block)
+{
+	GSVector4i rows[8];
+	IDCT_Rows(block, rows);
+
+	for (int i = 0; i < 8; i++)
+		GSVector4i::store<true>(block + 8 * i, rows[i]);
+}
+
+MULTI_ISA_UNSHARED_END
+
+#undef W1
+#undef W2
+#undef W3
+#undef W5
+#undef W6
+#undef W7
@@ -61,6 +61,7 @@ SmallString s_speed_line;
 SmallString s_gs_stats_line;
 SmallString s_gs_memory_stats_line;
 SmallString s_gs_frame_times_line;
+SmallString s_gs_ring_stats_line;
 SmallString s_resolution_line;
 SmallString s_hardware_info_cpu_line;
 SmallString s_hardware_info_gpu_line;
@@ -405,6 +406,13 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 				if (!s_gs_memory_stats_line.empty())
 					DRAW_LINE(osd_font, font_size, s_gs_memory_stats_line.c_str(), white_color);
 				DRAW_LINE(osd_font, font_size, s_gs_frame_times_line.c_str(), white_color);
+
+				s_gs_ring_stats_line.format("Ring: {:.0f}% | Stalls: {} ({:.2f}ms) | GS Idle: {:.0f}%",
+					PerformanceMetrics::GetGSRingUsage(),
+					PerformanceMetrics::GetGSRingStalls(),
+					PerformanceMetrics::GetGSRingStallTime(),
+					PerformanceMetrics::GetGSThreadIdle());
+				DRAW_LINE(osd_font, font_size, s_gs_ring_stats_line.c_str(), white_color);
 			}
 
 			if (GSConfig.OsdShowResolution)
@@ -518,6 +526,7 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 				if (!s_gs_memory_stats_line.empty())
 					DRAW_LINE(osd_font, font_size, s_gs_memory_stats_line.c_str(), white_color);
 				DRAW_LINE(osd_font, font_size, s_gs_frame_times_line.c_str(), white_color);
+				DRAW_LINE(osd_font, font_size, s_gs_ring_stats_line.c_str(), white_color);
 			}
 
 			if (GSConfig.OsdShowResolution)
@@ -12,6 +12,7 @@
 #include "common/FPControl.h"
 #include "common/ScopedGuard.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 #include "common/WrappedMemCopy.h"
 
 #include <list>
@@ -55,6 +56,8 @@ namespace MTGS
 
 	static void SendSimplePacket(Command type, int data0, int data1, int data2);
 	static void SendSimpleGSPacket(Command type, u32 offset, u32 size, GIF_PATH path);
+	static void QueuePath3Packet(u32 offset, u32 size);
+	static void FlushPendingPath3Packet();
 	static void SendPointerPacket(Command type, u32 data0, void* data1);
 	static void _FinishSimplePacket();
 	static u8* GetDataPacketPtr();
@@ -80,11 +83,28 @@ namespace MTGS
 	static std::atomic<int> s_QueuedFrameCount;
 	static std::atomic<bool> s_VsyncSignalListener;
 
-	static std::mutex s_mtx_RingBufferBusy2; // Gets released on semaXGkick waiting...
 	static Threading::WorkSema s_sem_event;
 	static Threading::UserspaceSemaphore s_sem_OnRingReset;
 	static Threading::UserspaceSemaphore s_sem_Vsync;
 
+	// Lets the MTVU thread sleep until the GS thread has retired a PATH1 packet (see WaitGS),
+	// instead of the two threads handing a lock back and forth for every packet.
+	static std::atomic<bool> s_MTVUPacketSignalEnable;
+	static Threading::UserspaceSemaphore s_sem_MTVUPacketDone;
+
+	// Adjacent PATH3 packets are merged before they're committed to the ring, since games often
+	// upload textures as lots of small IMAGE transfers. Only touched by the EE thread.
+	static constexpr u32 MAX_PENDING_PATH3_SIZE = 0x10000;
+	static u32 s_pending_path3_offset;
+	static u32 s_pending_path3_size; // zero when nothing is pending
+
+	// Running totals for the performance overlay, see GetRingStats().
+	static std::atomic<u64> s_stat_occupancy_sum;
+	static std::atomic<u64> s_stat_occupancy_samples;
+	static std::atomic<u64> s_stat_producer_stalls;
+	static std::atomic<u64> s_stat_producer_stall_ticks;
+	static std::atomic<u64> s_stat_consumer_idle_ticks;
+
 	// Used to delay the sending of events.  Performance is better if the ringbuffer
 	// has more than one command in it when the thread is kicked.
 	static int s_CopyDataTally;
@@ -207,6 +227,8 @@ void MTGS::ResetGS(bool hardware_reset)
 
 	if (hardware_reset)
 	{
+		// The GIF paths are about to be cleared, so whatever was pending is gone.
+		s_pending_path3_size = 0;
 		s_ReadPos = s_WritePos.load();
 		s_QueuedFrameCount = 0;
 		s_VsyncSignalListener = 0;
@@ -320,8 +342,6 @@ void MTGS::MainLoop()
 	PacketTagType prevCmd;
 #endif
 
-	std::unique_lock mtvu_lock(s_mtx_RingBufferBusy2);
-
 	while (true)
 	{
 		if (s_run_idle_flag.load(std::memory_order_acquire) && VMManager::GetState() != VMState::Running && GSHasDisplayWindow())
@@ -334,9 +354,9 @@ void MTGS::MainLoop()
 		}
 		else
 		{
-			mtvu_lock.unlock();
+			const u64 idle_start = GetCPUTicks();
 			s_sem_event.WaitForWork();
-			mtvu_lock.lock();
+			s_stat_consumer_idle_ticks.fetch_add(GetCPUTicks() - idle_start, std::memory_order_relaxed);
 		}
 
 		if (!s_open_flag.load(std::memory_order_acquire))
@@ -460,19 +480,21 @@ void MTGS::MainLoop()
 				case Command::MTVUGSPacket:
 				{
 					MTVU_LOG("MTGS - Waiting on semaXGkick!");
+					// Wait for MTVU to complete vu1 program
 					if (!vu1Thread.semaXGkick.TryWait())
-					{
-						mtvu_lock.unlock();
-						// Wait for MTVU to complete vu1 program
 						vu1Thread.semaXGkick.Wait();
-						mtvu_lock.lock();
-					}
+
 					Gif_Path& path = gifUnit.gifPath[GIF_PATH_1];
 					GS_Packet gsPack = path.GetGSPacketMTVU(); // Get vu1 program's xgkick packet(s)
 					if (gsPack.size)
 						GSgifTransfer((u8*)&path.buffer[gsPack.offset], gsPack.size / 16);
 					path.readAmount.fetch_sub(gsPack.size + gsPack.readAmount, std::memory_order_acq_rel);
 					path.PopGSPacketMTVU(); // Should be done last, for proper Gif_MTGS_Wait()
+
+					// Pairs with the fence in WaitGS(), the MTVU thread either sees the pop or we see its flag.
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					if (s_MTVUPacketSignalEnable.exchange(false, std::memory_order_acq_rel))
+						s_sem_MTVUPacketDone.Post();
 					break;
 				}
 
@@ -603,6 +625,8 @@ void MTGS::MainLoop()
 
 	// Unblock any threads in WaitGS in case MTGS gets cancelled while still processing work
 	s_ReadPos.store(s_WritePos.load(std::memory_order_acquire), std::memory_order_relaxed);
+	if (s_MTVUPacketSignalEnable.exchange(false, std::memory_order_acq_rel))
+		s_sem_MTVUPacketDone.Post();
 	s_sem_event.Kill();
 }
 
@@ -621,6 +645,10 @@ void MTGS::WaitGS(bool syncRegs, bool weakWait, bool isMTVU)
 	// Both m_ReadPos and m_WritePos can be relaxed as we only want to test if the queue is empty but
 	// we don't want to access the content of the queue
 
+	// The pending PATH3 packet belongs to the EE thread, and the GS can't finish without it.
+	if (!isMTVU)
+		FlushPendingPath3Packet();
+
 	SetEvent();
 	if (weakWait && isMTVU)
 	{
@@ -630,17 +658,20 @@ void MTGS::WaitGS(bool syncRegs, bool weakWait, bool isMTVU)
 		// Note: m_WritePos doesn't seem to have proper atomic write
 		// code, so reading it from the MTVU thread might be dangerous;
 		// hence it has been avoided...
-		u32 startP1Packs = path.GetPendingGSPackets();
-		if (startP1Packs)
+		const u32 startP1Packs = path.GetPendingGSPackets();
+		while (startP1Packs && path.GetPendingGSPackets() == startP1Packs)
 		{
-			while (true)
+			s_MTVUPacketSignalEnable.store(true, std::memory_order_release);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (path.GetPendingGSPackets() != startP1Packs || !IsOpen())
 			{
-				// m_mtx_RingBufferBusy2.Wait();
-				s_mtx_RingBufferBusy2.lock();
-				s_mtx_RingBufferBusy2.unlock();
-				if (path.GetPendingGSPackets() != startP1Packs)
-					break;
+				// The GS thread may have already taken the flag, keep the semaphore balanced.
+				if (!s_MTVUPacketSignalEnable.exchange(false, std::memory_order_acq_rel))
+					s_sem_MTVUPacketDone.Wait();
+				break;
 			}
+
+			s_sem_MTVUPacketDone.Wait();
 		}
 	}
 	else
@@ -662,6 +693,11 @@ void MTGS::WaitGS(bool syncRegs, bool weakWait, bool isMTVU)
 // For use in loops that wait on the GS thread to do certain things.
 void MTGS::SetEvent()
 {
+	s_stat_occupancy_sum.fetch_add(
+		(s_WritePos.load(std::memory_order_relaxed) - s_ReadPos.load(std::memory_order_relaxed)) & RingBufferMask,
+		std::memory_order_relaxed);
+	s_stat_occupancy_samples.fetch_add(1, std::memory_order_relaxed);
+
 	s_sem_event.NotifyOfWork();
 	s_CopyDataTally = 0;
 }
@@ -728,6 +764,12 @@ void MTGS::GenericStall(uint size)
 
 	if (freeroom <= size)
 	{
+		const u64 stall_start = GetCPUTicks();
+		ScopedGuard stall_stats([stall_start]() {
+			s_stat_producer_stalls.fetch_add(1, std::memory_order_relaxed);
+			s_stat_producer_stall_ticks.fetch_add(GetCPUTicks() - stall_start, std::memory_order_relaxed);
+		});
+
 		// writepos will overlap readpos if we commit the data, so we need to wait until
 		// readpos is out past the end of the future write pos, or until it wraps around
 		// (in which case writepos will be >= readpos).
@@ -793,6 +835,8 @@ void MTGS::GenericStall(uint size)
 
 void MTGS::PrepDataPacket(Command cmd, u32 size)
 {
+	FlushPendingPath3Packet();
+
 	s_packet_size = size;
 	++size; // takes into account our RingCommand QWC.
 	GenericStall(size);
@@ -836,6 +880,7 @@ void MTGS::SendSimplePacket(Command type, int data0, int data1, int data2)
 {
 	//ScopedLock locker( m_PacketLocker );
 
+	FlushPendingPath3Packet();
 	GenericStall(1);
 	PacketTagType& tag = (PacketTagType&)RingBuffer[s_WritePos.load(std::memory_order_relaxed)];
 
@@ -859,10 +904,51 @@ void MTGS::SendSimpleGSPacket(Command type, u32 offset, u32 size, GIF_PATH path)
 	}
 }
 
+void MTGS::QueuePath3Packet(u32 offset, u32 size)
+{
+	if (IsDevBuild && EmuConfig.GS.SynchronousMTGS) [[unlikely]]
+	{
+		SendSimpleGSPacket(Command::GSPacket, offset, size, GIF_PATH_3);
+		return;
+	}
+
+	if (s_pending_path3_size != 0 && (s_pending_path3_offset + s_pending_path3_size) == offset &&
+		(s_pending_path3_size + size) <= MAX_PENDING_PATH3_SIZE)
+	{
+		s_pending_path3_size += size;
+		return;
+	}
+
+	FlushPendingPath3Packet();
+	s_pending_path3_offset = offset;
+	s_pending_path3_size = size;
+}
+
+void MTGS::FlushPendingPath3Packet()
+{
+	if (s_pending_path3_size == 0)
+		return;
+
+	const u32 size = std::exchange(s_pending_path3_size, 0);
+	SendSimpleGSPacket(Command::GSPacket, s_pending_path3_offset, size, GIF_PATH_3);
+}
+
+MTGS::RingStats MTGS::GetRingStats()
+{
+	RingStats stats;
+	stats.occupancy_sum = s_stat_occupancy_sum.load(std::memory_order_relaxed);
+	stats.occupancy_samples = s_stat_occupancy_samples.load(std::memory_order_relaxed);
+	stats.producer_stalls = s_stat_producer_stalls.load(std::memory_order_relaxed);
+	stats.producer_stall_ticks = s_stat_producer_stall_ticks.load(std::memory_order_relaxed);
+	stats.consumer_idle_ticks = s_stat_consumer_idle_ticks.load(std::memory_order_relaxed);
+	return stats;
+}
+
 void MTGS::SendPointerPacket(Command type, u32 data0, void* data1)
 {
 	//ScopedLock locker( m_PacketLocker );
 
+	FlushPendingPath3Packet();
 	GenericStall(1);
 	PacketTagType& tag = (PacketTagType&)RingBuffer[s_WritePos.load(std::memory_order_relaxed)];
 
@@ -1068,7 +1154,10 @@ void Gif_AddCompletedGSPacket(GS_Packet& gsPack, GIF_PATH path)
 	{
 		pxAssertMsg(!gsPack.readAmount, "Gif Unit - gsPack.readAmount only valid for MTVU path 1!");
 		gifUnit.gifPath[path].readAmount.fetch_add(gsPack.size);
-		MTGS::SendSimpleGSPacket(MTGS::Command::GSPacket, gsPack.offset, gsPack.size, path);
+		if (path == GIF_PATH_3)
+			MTGS::QueuePath3Packet(gsPack.offset, gsPack.size);
+		else
+			MTGS::SendSimpleGSPacket(MTGS::Command::GSPacket, gsPack.offset, gsPack.size, path);
 	}
 }
 
@@ -41,6 +41,16 @@ namespace MTGS
 		s32 retval; // value returned from the call, valid only after an mtgsWaitGS()
 	};
 
+	/// Running totals for the ring buffer since startup. Ticks are in GetCPUTicks() units.
+	struct RingStats
+	{
+		u64 occupancy_sum; // in qwords, sampled each time the GS thread is kicked
+		u64 occupancy_samples;
+		u64 producer_stalls; // times the EE had to wait for space in the ring
+		u64 producer_stall_ticks;
+		u64 consumer_idle_ticks; // time the GS thread spent waiting for work
+	};
+
 	const Threading::ThreadHandle& GetThreadHandle();
 	bool IsOpen();
 
@@ -63,6 +73,7 @@ namespace MTGS
 	void Freeze(FreezeAction mode, FreezeData& data);
 
 	int GetCurrentVsyncQueueSize();
+	RingStats GetRingStats();
 	void PostVsyncStart(bool registers_written);
 	void InitAndReadFIFO(u8* mem, u32 qwc);
 
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "Common.h"
+#include "DebugTools/SamplingProfiler.h"
 #include "Gif_Unit.h"
 #include "MTVU.h"
 #include "VMManager.h"
@@ -128,6 +129,7 @@ void VU_Thread::Reset()
 void VU_Thread::ExecuteRingBuffer()
 {
 	Threading::SetNameOfCurrentThread("MTVU");
+	SamplingProfiler::RegisterCurrentThread("MTVU");
 
 	for (;;)
 	{
@@ -204,6 +206,7 @@ void VU_Thread::ExecuteRingBuffer()
 		}
 	}
 
+	SamplingProfiler::UnregisterCurrentThread();
 	semaEvent.Kill();
 }
 
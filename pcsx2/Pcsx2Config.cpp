@@ -454,6 +454,8 @@ Pcsx2Config::RecompilerOptions::RecompilerOptions()
 	EnableVU1 = true;
 	EnableFastmem = true;
 	PauseOnTLBMiss = false;
+	EnableEEBlockProfile = false;
+	EnableVUProgramProfile = false;
 
 	// vu and fpu clamping default to standard overflow.
 	vu0Overflow = true;
@@ -532,6 +534,8 @@ void Pcsx2Config::RecompilerOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitBool(EnableVU1);
 	SettingsWrapBitBool(EnableFastmem);
 	SettingsWrapBitBool(PauseOnTLBMiss);
+	SettingsWrapBitBool(EnableEEBlockProfile);
+	SettingsWrapBitBool(EnableVUProgramProfile);
 
 	SettingsWrapBitBool(vu0Overflow);
 	SettingsWrapBitBool(vu0ExtraOverflow);
@@ -844,6 +848,8 @@ bool Pcsx2Config::GSOptions::OptionsAreEqual(const GSOptions& right) const
 		OpEqu(BeforeDrawFunctionId) &&
 		OpEqu(MoveHandlerFunctionId) &&
 		OpEqu(SkipDrawEnd) &&
+		OpEqu(HashCacheVRAMBudget) &&
+		OpEqu(HashCacheHostBudget) &&
 		OpEqu(SkipDrawStart) &&
 
 		OpEqu(UserHacks_AutoFlush) &&
@@ -1064,6 +1070,8 @@ void Pcsx2Config::GSOptions::LoadSave(SettingsWrapper& wrap)
 	SettingsWrapBitfieldEx(SkipDrawStart, "UserHacks_SkipDraw_Start");
 	SettingsWrapBitfieldEx(SkipDrawEnd, "UserHacks_SkipDraw_End");
 	SkipDrawEnd = std::max(SkipDrawStart, SkipDrawEnd);
+	SettingsWrapBitfieldEx(HashCacheVRAMBudget, "HashCacheVRAMBudget");
+	SettingsWrapBitfieldEx(HashCacheHostBudget, "HashCacheHostBudget");
 
 	SettingsWrapIntEnumEx(UserHacks_HalfPixelOffset, "UserHacks_HalfPixelOffset");
 	SettingsWrapBitfieldEx(UserHacks_RoundSprite, "UserHacks_round_sprite_offset");
@@ -1679,6 +1687,11 @@ void Pcsx2Config::SavestateOptions::LoadSave(SettingsWrapper& wrap)
 
 	SettingsWrapIntEnumEx(CompressionType, "SavestateCompressionType");
 	SettingsWrapIntEnumEx(CompressionRatio, "SavestateCompressionRatio");
+	SettingsWrapEntry(RewindEnabled);
+	SettingsWrapEntry(RewindFrequency);
+	SettingsWrapEntry(RewindBufferSize);
+
+	RewindFrequency = std::max(RewindFrequency, 1u);
 }
 
 bool Pcsx2Config::SavestateOptions::operator!=(const SavestateOptions& right) const
@@ -1688,7 +1701,8 @@ bool Pcsx2Config::SavestateOptions::operator!=(const SavestateOptions& right) co
 
 bool Pcsx2Config::SavestateOptions::operator==(const SavestateOptions& right) const
 {
-	return OpEqu(CompressionType) && OpEqu(CompressionRatio);
+	return OpEqu(CompressionType) && OpEqu(CompressionRatio) && OpEqu(RewindEnabled) && OpEqu(RewindFrequency) &&
+		   OpEqu(RewindBufferSize);
 };
 
 Pcsx2Config::FilenameOptions::FilenameOptions()
@@ -54,6 +54,12 @@ static float s_vu_thread_time = 0.0f;
 static float s_capture_thread_usage = 0.0f;
 static float s_capture_thread_time = 0.0f;
 
+static MTGS::RingStats s_last_ring_stats = {};
+static float s_gs_ring_usage = 0.0f;
+static u32 s_gs_ring_stalls = 0;
+static float s_gs_ring_stall_time = 0.0f;
+static float s_gs_thread_idle = 0.0f;
+
 static PerformanceMetrics::FrameTimeHistory s_frame_time_history;
 static u32 s_frame_time_history_pos = 0;
 
@@ -91,6 +97,11 @@ void PerformanceMetrics::Clear()
 	s_capture_thread_usage = 0.0f;
 	s_capture_thread_time = 0.0f;
 
+	s_gs_ring_usage = 0.0f;
+	s_gs_ring_stalls = 0;
+	s_gs_ring_stall_time = 0.0f;
+	s_gs_thread_idle = 0.0f;
+
 	s_average_gpu_time = 0.0f;
 	s_gpu_usage = 0.0f;
 
@@ -120,6 +131,7 @@ void PerformanceMetrics::Reset()
 	s_last_gs_time = MTGS::GetThreadHandle().GetCPUTime();
 	s_last_vu_time = THREAD_VU1 ? vu1Thread.GetThreadHandle().GetCPUTime() : 0;
 	s_last_ticks = GetCPUTicks();
+	s_last_ring_stats = MTGS::GetRingStats();
 	s_last_capture_time = GSCapture::IsCapturing() ? GSCapture::GetEncoderThreadHandle().GetCPUTime() : 0;
 
 	for (GSSWThreadStats& stat : s_gs_sw_threads)
@@ -212,6 +224,19 @@ void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_sk
 	s_vu_thread_time = static_cast<double>(vu_delta) * time_divider;
 	s_capture_thread_time = static_cast<double>(capture_delta) * time_divider;
 
+	const MTGS::RingStats ring_stats = MTGS::GetRingStats();
+	const u64 occupancy_samples = ring_stats.occupancy_samples - s_last_ring_stats.occupancy_samples;
+	s_gs_ring_usage = (occupancy_samples > 0) ?
+						  (100.0f * static_cast<float>(ring_stats.occupancy_sum - s_last_ring_stats.occupancy_sum) /
+							  (static_cast<float>(occupancy_samples) * static_cast<float>(MTGS::RingBufferSize))) :
+						  0.0f;
+	s_gs_ring_stalls = static_cast<u32>(ring_stats.producer_stalls - s_last_ring_stats.producer_stalls);
+	s_gs_ring_stall_time = 1000.0f * static_cast<float>(ring_stats.producer_stall_ticks - s_last_ring_stats.producer_stall_ticks) /
+						   static_cast<float>(GetTickFrequency());
+	s_gs_thread_idle = 100.0f * static_cast<float>(ring_stats.consumer_idle_ticks - s_last_ring_stats.consumer_idle_ticks) /
+					   static_cast<float>(std::max<u64>(ticks_delta, 1));
+	s_last_ring_stats = ring_stats;
+
 	for (GSSWThreadStats& thread : s_gs_sw_threads)
 	{
 		const u64 time = thread.handle.GetCPUTime();
@@ -317,6 +342,26 @@ float PerformanceMetrics::GetGSThreadAverageTime()
 	return s_gs_thread_time;
 }
 
+float PerformanceMetrics::GetGSRingUsage()
+{
+	return s_gs_ring_usage;
+}
+
+u32 PerformanceMetrics::GetGSRingStalls()
+{
+	return s_gs_ring_stalls;
+}
+
+float PerformanceMetrics::GetGSRingStallTime()
+{
+	return s_gs_ring_stall_time;
+}
+
+float PerformanceMetrics::GetGSThreadIdle()
+{
+	return s_gs_thread_idle;
+}
+
 float PerformanceMetrics::GetVUThreadUsage()
 {
 	return s_vu_thread_usage;
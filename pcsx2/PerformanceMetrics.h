@@ -46,6 +46,13 @@ namespace PerformanceMetrics
 	double GetCPUThreadAverageTime();
 	float GetGSThreadUsage();
 	float GetGSThreadAverageTime();
+
+	/// MTGS ring statistics over the last update interval: average fill as a percentage of the
+	/// ring, number of times and milliseconds the EE waited for space, and GS thread idle percentage.
+	float GetGSRingUsage();
+	u32 GetGSRingStalls();
+	float GetGSRingStallTime();
+	float GetGSThreadIdle();
 	float GetVUThreadUsage();
 	float GetVUThreadAverageTime();
 	float GetCaptureThreadUsage();
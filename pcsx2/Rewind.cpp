@@ -0,0 +1,312 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "Achievements.h"
+#include "Config.h"
+#include "GSDumpReplayer.h"
+#include "Memory.h"
+#include "Rewind.h"
+#include "SaveState.h"
+#include "vtlb.h"
+
+#include "common/BitUtils.h"
+#include "common/Console.h"
+#include "common/Error.h"
+
+#include "fmt/format.h"
+
+#include <zstd.h>
+
+#include <cstring>
+#include <deque>
+#include <vector>
+
+namespace Rewind
+{
+	namespace
+	{
+		// Reverse delta, turns the state captured by a snapshot back into the one before it.
+		// Layout is the header, all EE pages, all state pages, then the page indices.
+		struct UndoRecordHeader
+		{
+			u32 state_size;
+			u32 num_ee_pages;
+			u32 num_state_pages;
+		};
+
+		struct UndoRecord
+		{
+			std::vector<u8> data; // zstd compressed
+			u32 uncompressed_size;
+		};
+	} // namespace
+
+	static constexpr int COMPRESSION_LEVEL = 1;
+
+	static void Capture();
+	static void CaptureBaseline();
+	static void AppendPage(const u8* data);
+	static bool ApplyUndoRecord(Error* error);
+	static void TrimHistory();
+
+	static std::deque<UndoRecord> s_records;
+	static size_t s_records_size = 0;
+
+	// Copy of the most recent snapshot, the records walk this backwards.
+	static std::vector<u8> s_ee_shadow;
+	static std::vector<u8> s_state_shadow;
+	static bool s_has_baseline = false;
+
+	// Scratch buffers, kept around to avoid reallocating every capture.
+	static std::vector<u8> s_state_buffer;
+	static std::vector<u8> s_undo_buffer;
+	static std::vector<u32> s_dirty_pages;
+	static std::vector<u32> s_page_indices;
+
+	static ZSTD_CCtx* s_cctx = nullptr;
+	static u32 s_frame_counter = 0;
+} // namespace Rewind
+
+void Rewind::FrameUpdate()
+{
+	if (Achievements::IsHardcoreModeActive() || GSDumpReplayer::IsReplayingDump())
+	{
+		if (s_has_baseline)
+			Reset();
+
+		return;
+	}
+
+	if (++s_frame_counter < EmuConfig.Savestate.RewindFrequency)
+		return;
+
+	s_frame_counter = 0;
+	Capture();
+}
+
+void Rewind::CaptureBaseline()
+{
+	s_ee_shadow.assign(eeMem->Main, eeMem->Main + Ps2MemSize::ExposedRam);
+	s_state_shadow.swap(s_state_buffer);
+	mmap_SetDirtyPageTracking(true);
+	s_has_baseline = true;
+}
+
+void Rewind::AppendPage(const u8* data)
+{
+	const size_t pos = s_undo_buffer.size();
+	s_undo_buffer.resize(pos + __pagesize);
+	std::memcpy(&s_undo_buffer[pos], data, __pagesize);
+}
+
+void Rewind::Capture()
+{
+	Error error;
+	if (!SaveState_SaveToBuffer(s_state_buffer, &error))
+	{
+		Console.Error(fmt::format("Rewind: Failed to save state: {}", error.GetDescription()));
+		Reset();
+		return;
+	}
+
+	// Pad to page size, so the state can be diffed in pages like memory.
+	s_state_buffer.resize(Common::PageAlign(s_state_buffer.size()));
+
+	if (!s_has_baseline)
+	{
+		CaptureBaseline();
+		return;
+	}
+
+	UndoRecordHeader header = {};
+	header.state_size = static_cast<u32>(s_state_shadow.size());
+	s_undo_buffer.resize(sizeof(header));
+	s_page_indices.clear();
+
+	// Only dirty pages can differ, but games often rewrite memory with the same contents.
+	mmap_CollectDirtyPages(s_dirty_pages);
+	for (const u32 page : s_dirty_pages)
+	{
+		u8* shadow = &s_ee_shadow[page * __pagesize];
+		const u8* current = &eeMem->Main[page * __pagesize];
+		if (std::memcmp(shadow, current, __pagesize) == 0)
+			continue;
+
+		AppendPage(shadow);
+		std::memcpy(shadow, current, __pagesize);
+		s_page_indices.push_back(page);
+		header.num_ee_pages++;
+	}
+
+	// Pages past the end of the new state still need to be restored, pages past the end of
+	// the old state are dropped when the state is truncated on rewind.
+	const u32 old_state_pages = static_cast<u32>(s_state_shadow.size() / __pagesize);
+	const u32 new_state_pages = static_cast<u32>(s_state_buffer.size() / __pagesize);
+	for (u32 page = 0; page < old_state_pages; page++)
+	{
+		const u8* shadow = &s_state_shadow[page * __pagesize];
+		if (page < new_state_pages && std::memcmp(shadow, &s_state_buffer[page * __pagesize], __pagesize) == 0)
+			continue;
+
+		AppendPage(shadow);
+		s_page_indices.push_back(page);
+		header.num_state_pages++;
+	}
+	s_state_shadow.swap(s_state_buffer);
+
+	const size_t indices_pos = s_undo_buffer.size();
+	s_undo_buffer.resize(indices_pos + s_page_indices.size() * sizeof(u32));
+	std::memcpy(&s_undo_buffer[indices_pos], s_page_indices.data(), s_page_indices.size() * sizeof(u32));
+	std::memcpy(s_undo_buffer.data(), &header, sizeof(header));
+
+	if (!s_cctx && !(s_cctx = ZSTD_createCCtx()))
+	{
+		Console.Error("Rewind: Failed to create compression context.");
+		Reset();
+		return;
+	}
+
+	UndoRecord record;
+	record.uncompressed_size = static_cast<u32>(s_undo_buffer.size());
+	record.data.resize(ZSTD_compressBound(s_undo_buffer.size()));
+	const size_t compressed_size = ZSTD_compressCCtx(s_cctx, record.data.data(), record.data.size(),
+		s_undo_buffer.data(), s_undo_buffer.size(), COMPRESSION_LEVEL);
+	if (ZSTD_isError(compressed_size))
+	{
+		Console.Error(fmt::format("Rewind: Failed to compress snapshot: {}", ZSTD_getErrorName(compressed_size)));
+		Reset();
+		return;
+	}
+
+	record.data.resize(compressed_size);
+	record.data.shrink_to_fit();
+	s_records_size += compressed_size;
+	s_records.push_back(std::move(record));
+	TrimHistory();
+}
+
+void Rewind::TrimHistory()
+{
+	const size_t budget = static_cast<size_t>(EmuConfig.Savestate.RewindBufferSize) * _1mb;
+	while (!s_records.empty() && s_records_size > budget)
+	{
+		s_records_size -= s_records.front().data.size();
+		s_records.pop_front();
+	}
+}
+
+bool Rewind::ApplyUndoRecord(Error* error)
+{
+	UndoRecordHeader header;
+	if (s_undo_buffer.size() < sizeof(header))
+	{
+		Error::SetString(error, "Rewind snapshot is truncated.");
+		return false;
+	}
+
+	std::memcpy(&header, s_undo_buffer.data(), sizeof(header));
+	const size_t num_pages = static_cast<size_t>(header.num_ee_pages) + header.num_state_pages;
+	if (s_undo_buffer.size() != sizeof(header) + num_pages * (__pagesize + sizeof(u32)) ||
+		(header.state_size % __pagesize) != 0)
+	{
+		Error::SetString(error, "Rewind snapshot is corrupted.");
+		return false;
+	}
+
+	const u8* data = s_undo_buffer.data() + sizeof(header);
+	const u8* indices = data + num_pages * __pagesize;
+	s_state_shadow.resize(header.state_size);
+
+	for (size_t i = 0; i < num_pages; i++)
+	{
+		u32 page;
+		std::memcpy(&page, indices + i * sizeof(u32), sizeof(page));
+
+		std::vector<u8>& dest = (i < header.num_ee_pages) ? s_ee_shadow : s_state_shadow;
+		if ((static_cast<size_t>(page) + 1) * __pagesize > dest.size())
+		{
+			Error::SetString(error, "Rewind snapshot is corrupted.");
+			return false;
+		}
+
+		std::memcpy(&dest[page * __pagesize], data + i * __pagesize, __pagesize);
+	}
+
+	return true;
+}
+
+bool Rewind::RewindSnapshots(u32 count, Error* error)
+{
+	if (!s_has_baseline)
+	{
+		Error::SetString(error, "No rewind snapshots are available.");
+		return false;
+	}
+
+	count = std::min(count, static_cast<u32>(s_records.size()));
+	for (u32 i = 0; i < count; i++)
+	{
+		const UndoRecord& record = s_records.back();
+		s_undo_buffer.resize(record.uncompressed_size);
+
+		const size_t size = ZSTD_decompress(s_undo_buffer.data(), s_undo_buffer.size(), record.data.data(), record.data.size());
+		if (ZSTD_isError(size) || size != record.uncompressed_size)
+		{
+			Error::SetString(error, "Failed to decompress rewind snapshot.");
+			Reset();
+			return false;
+		}
+
+		if (!ApplyUndoRecord(error))
+		{
+			Reset();
+			return false;
+		}
+
+		s_records_size -= record.data.size();
+		s_records.pop_back();
+	}
+
+	if (!SaveState_LoadFromBuffer(s_state_shadow, s_ee_shadow, error))
+	{
+		Reset();
+		return false;
+	}
+
+	// Memory now matches the shadow again, so start tracking from a clean slate.
+	mmap_SetDirtyPageTracking(true);
+	s_frame_counter = 0;
+	return true;
+}
+
+void Rewind::Reset()
+{
+	if (mmap_IsDirtyPageTrackingEnabled())
+		mmap_SetDirtyPageTracking(false);
+
+	s_records.clear();
+	s_records_size = 0;
+	s_has_baseline = false;
+	s_frame_counter = 0;
+
+	std::vector<u8>().swap(s_ee_shadow);
+	std::vector<u8>().swap(s_state_shadow);
+	std::vector<u8>().swap(s_state_buffer);
+	std::vector<u8>().swap(s_undo_buffer);
+
+	if (s_cctx)
+	{
+		ZSTD_freeCCtx(s_cctx);
+		s_cctx = nullptr;
+	}
+}
+
+u32 Rewind::GetSnapshotCount()
+{
+	return static_cast<u32>(s_records.size());
+}
+
+size_t Rewind::GetMemoryUsage()
+{
+	return s_records_size + s_ee_shadow.size() + s_state_shadow.size();
+}
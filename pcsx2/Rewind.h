@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "common/Pcsx2Types.h"
+
+class Error;
+
+// In-memory rewind history. Instead of keeping full states around, the latest state is kept
+// uncompressed as a baseline, and each snapshot stores only the pages which changed since the
+// previous one (compressed), which is enough to walk the baseline backwards. Dirty EE memory
+// pages are found through write protection, so unchanged memory is never even compared.
+namespace Rewind
+{
+	/// Called once per frame on the CPU thread, captures a snapshot every RewindFrequency frames.
+	void FrameUpdate();
+
+	/// Restores the state from `count` snapshots ago. A count of zero returns to the most recent snapshot.
+	bool RewindSnapshots(u32 count, Error* error);
+
+	/// Discards all snapshots, and stops tracking dirty pages until the next capture.
+	void Reset();
+
+	u32 GetSnapshotCount();
+	size_t GetMemoryUsage();
+} // namespace Rewind
@@ -15,6 +15,7 @@
 #include "common/Error.h"
 #include "common/FileSystem.h"
 #include "common/Path.h"
+#include "common/ScopedGuard.h"
 #include "common/StringUtil.h"
 #include "common/Timer.h"
 #include "common/YAML.h"
@@ -24,6 +25,19 @@
 #include <optional>
 #include <chrono>
 
+// Header of _pcsx2_journal, followed by the filter string and then a page number and page of data for each journaled page
+struct FolderMemoryCardJournalHeader
+{
+	static constexpr u32 MAGIC = 0x4E524A46; // FJRN
+	static constexpr u32 VERSION = 1;
+
+	u32 magic;
+	u32 version;
+	u32 pageCount;
+	u32 filteringEnabled;
+	u32 filterLength;
+};
+
 // A helper function to parse the YAML file
 static std::optional<ryml::Tree> loadYamlFile(const char* filePath)
 {
@@ -102,8 +116,10 @@ time_t MemoryCardFileEntryDateTime::ToTime() const
 }
 
 FolderMemoryCard::FolderMemoryCard()
-	: m_framesUntilFlush(0)
+	: m_flushRunning(false)
+	, m_framesUntilFlush(0)
 	, m_timeLastWritten(0)
+	, m_flushAllMetadata(false)
 	, m_slot(0)
 	, m_isEnabled(false)
 	, m_performFileWrites(false)
@@ -111,8 +127,14 @@ FolderMemoryCard::FolderMemoryCard()
 {
 }
 
+FolderMemoryCard::~FolderMemoryCard()
+{
+	WaitForFlush();
+}
+
 void FolderMemoryCard::InitializeInternalData()
 {
+	WaitForFlush();
 	memset(&m_superBlock, 0xFF, sizeof(m_superBlock));
 	memset(&m_indirectFat, 0xFF, sizeof(m_indirectFat));
 	memset(&m_fat, 0xFF, sizeof(m_fat));
@@ -123,6 +145,7 @@ void FolderMemoryCard::InitializeInternalData()
 	m_lastAccessedFile.CloseAll();
 	m_fileMetadataQuickAccess.clear();
 	m_timeLastWritten = 0;
+	m_flushAllMetadata = true;
 	m_isEnabled = false;
 	m_framesUntilFlush = 0;
 	m_performFileWrites = true;
@@ -188,6 +211,7 @@ void FolderMemoryCard::Open(std::string fullPath, const Pcsx2Config::McdOptions&
 	m_filteringEnabled = enableFiltering;
 	m_filteringString = std::move(filter);
 	LoadMemoryCardData(sizeInClusters, enableFiltering, m_filteringString);
+	ReplayJournal();
 
 	SetTimeLastWrittenToNow();
 	m_framesUntilFlush = 0;
@@ -204,6 +228,10 @@ void FolderMemoryCard::Close(bool flush)
 	{
 		Flush();
 	}
+	else
+	{
+		WaitForFlush();
+	}
 
 	m_cache.clear();
 	m_oldDataCache.clear();
@@ -707,6 +735,7 @@ s32 FolderMemoryCard::IsPresent() const
 
 void FolderMemoryCard::GetSizeInfo(McdSizeInfo& outways) const
 {
+	std::unique_lock lock(m_flushMutex);
 	outways.SectorSize = PageSize;
 	outways.EraseBlockSizeInSectors = BlockSize / PageSize;
 	outways.McdSizeInSectors = GetSizeInClusters() * 2;
@@ -961,8 +990,13 @@ s32 FolderMemoryCard::Read(u8* dest, u32 adr, int size)
 		{
 			memcpy(dest, &it->second.raw[offset], dataLength);
 		}
+		else if ((it = m_flushSnapshot.find(page)) != m_flushSnapshot.end())
+		{
+			memcpy(dest, &it->second.raw[offset], dataLength);
+		}
 		else
 		{
+			std::unique_lock lock(m_flushMutex);
 			ReadDataWithoutCache(dest, adr, dataLength);
 		}
 	}
@@ -1040,8 +1074,17 @@ s32 FolderMemoryCard::Save(const u8* src, u32 adr, int size)
 		if (it == m_cache.end())
 		{
 			cachePage = &m_cache[page];
-			const u32 adrLoad = page * PageSizeRaw;
-			ReadDataWithoutCache(&cachePage->raw[0], adrLoad, PageSize);
+			if (auto flushIt = m_flushSnapshot.find(page); flushIt != m_flushSnapshot.end())
+			{
+				// the page is being flushed right now, by the time this one is flushed that's what's in the file system
+				memcpy(&cachePage->raw[0], &flushIt->second.raw[0], PageSize);
+			}
+			else
+			{
+				std::unique_lock lock(m_flushMutex);
+				const u32 adrLoad = page * PageSizeRaw;
+				ReadDataWithoutCache(&cachePage->raw[0], adrLoad, PageSize);
+			}
 			memcpy(&m_oldDataCache[page].raw[0], &cachePage->raw[0], PageSize);
 		}
 		else
@@ -1060,19 +1103,111 @@ s32 FolderMemoryCard::Save(const u8* src, u32 adr, int size)
 
 void FolderMemoryCard::NextFrame()
 {
+	// pick up a finished flush, so its snapshot is dropped and anything it couldn't write goes back into the cache
+	if (m_flushThread.Joinable() && !m_flushRunning.load(std::memory_order_acquire))
+	{
+		WaitForFlush();
+	}
+
 	if (m_framesUntilFlush > 0 && --m_framesUntilFlush == 0)
 	{
-		Flush();
+		if (m_flushThread.Joinable())
+		{
+			// still writing the last flush, try again next frame
+			m_framesUntilFlush = 1;
+		}
+		else
+		{
+			StartFlush();
+		}
 	}
 }
 
 void FolderMemoryCard::Flush()
 {
+	WaitForFlush();
+	BeginFlush();
+	{
+		std::unique_lock lock(m_flushMutex);
+		FlushPending();
+	}
+	EndFlush();
+}
+
+void FolderMemoryCard::StartFlush()
+{
+	WaitForFlush();
 	if (m_cache.empty())
 	{
 		return;
 	}
 
+	BeginFlush();
+	m_flushSnapshot = m_flushCache;
+	m_flushRunning.store(true, std::memory_order_release);
+	if (!m_flushThread.Start([this]() {
+			Threading::SetNameOfCurrentThread("Folder Memcard Flush");
+			{
+				std::unique_lock lock(m_flushMutex);
+				FlushPending();
+			}
+			m_flushRunning.store(false, std::memory_order_release);
+		}))
+	{
+		Console.Error("FolderMcd: Failed to start flush thread for slot %u, flushing on the CPU thread.", m_slot);
+		m_flushRunning.store(false, std::memory_order_release);
+		{
+			std::unique_lock lock(m_flushMutex);
+			FlushPending();
+		}
+		EndFlush();
+	}
+}
+
+void FolderMemoryCard::WaitForFlush()
+{
+	if (!m_flushThread.Joinable())
+	{
+		return;
+	}
+
+	m_flushThread.Join();
+	EndFlush();
+}
+
+void FolderMemoryCard::BeginFlush()
+{
+	m_flushCache = std::move(m_cache);
+	m_cache.clear();
+	m_flushOldDataCache = std::move(m_oldDataCache);
+	m_oldDataCache.clear();
+}
+
+void FolderMemoryCard::EndFlush()
+{
+	// an aborted flush leaves its pages behind to be retried with the next one
+	// pages written again since are newer, but their old data is still the one from before the aborted flush
+	for (const auto& it : m_flushCache)
+	{
+		m_cache.emplace(it.first, it.second);
+	}
+	for (const auto& it : m_flushOldDataCache)
+	{
+		m_oldDataCache.insert_or_assign(it.first, it.second);
+	}
+
+	m_flushCache.clear();
+	m_flushOldDataCache.clear();
+	m_flushSnapshot.clear();
+}
+
+void FolderMemoryCard::FlushPending()
+{
+	if (m_flushCache.empty())
+	{
+		return;
+	}
+
 #ifdef DEBUG_WRITE_FOLDER_CARD_IN_MEMORY_TO_FILE_ON_CHANGE
 	WriteToFile(m_folderName.GetFullPath().RemoveLast() + L"-debug_" + wxDateTime::Now().Format(L"%Y-%m-%d-%H-%M-%S") + L"_pre-flush.ps2");
 #endif
@@ -1080,6 +1215,18 @@ void FolderMemoryCard::Flush()
 	Console.WriteLn("FolderMcd: Writing data for slot %u to file system...", m_slot);
 	Common::Timer timeFlushStart;
 
+	WriteJournal();
+	ScopedGuard deleteJournal([this]() {
+		if (m_performFileWrites)
+		{
+			const std::string journalFileName(Path::Combine(m_folderName, "_pcsx2_journal"));
+			if (FileSystem::FileExists(journalFileName.c_str()))
+			{
+				FileSystem::DeleteFilePath(journalFileName.c_str());
+			}
+		}
+	});
+
 	// Keep a copy of the old file entries so we can figure out which files and directories, if any, have been deleted from the memory card.
 	std::vector<MemoryCardFileEntryTreeNode> oldFileEntryTree;
 	if (IsFormatted())
@@ -1131,6 +1278,7 @@ void FolderMemoryCard::Flush()
 
 	// then all directory and file entries
 	FlushFileEntries();
+	m_flushAllMetadata = false;
 
 	// Now we have the new file system, compare it to the old one and "delete" any files that were in it before but aren't anymore.
 	FlushDeletedFilesAndRemoveUnchangedDataFromCache(oldFileEntryTree);
@@ -1143,7 +1291,7 @@ void FolderMemoryCard::Flush()
 
 	m_lastAccessedFile.FlushAll();
 	m_lastAccessedFile.ClearMetadataWriteState();
-	m_oldDataCache.clear();
+	m_flushOldDataCache.clear();
 
 	Console.WriteLn("FolderMcd: Done! Took %.2f ms.", timeFlushStart.GetTimeMilliseconds());
 
@@ -1154,11 +1302,11 @@ void FolderMemoryCard::Flush()
 
 bool FolderMemoryCard::FlushPage(const u32 page)
 {
-	auto it = m_cache.find(page);
-	if (it != m_cache.end())
+	auto it = m_flushCache.find(page);
+	if (it != m_flushCache.end())
 	{
 		WriteWithoutCache(&it->second.raw[0], page * PageSizeRaw, PageSize);
-		m_cache.erase(it);
+		m_flushCache.erase(it);
 		return true;
 	}
 	return false;
@@ -1205,22 +1353,139 @@ void FolderMemoryCard::FlushSuperBlock()
 	}
 }
 
+void FolderMemoryCard::WriteJournal()
+{
+	if (!m_performFileWrites)
+	{
+		return;
+	}
+
+	// Only the pages of the files written to since the last flush change on the host, the rest of the card can still be read
+	// from there afterwards. The system and file entry pages are journaled whole, as the folder may be laid out differently
+	// when it's loaded again.
+	const std::string journalFileName(Path::Combine(m_folderName, "_pcsx2_journal"));
+	const std::string tempFileName(journalFileName + ".tmp");
+	if (FileSystem::FileExists(journalFileName.c_str()))
+	{
+		// left over from an interrupted flush that couldn't be replayed, it'd be stale after this one
+		Console.Warning("FolderMcd: Keeping journal of slot %u which wasn't replayed as _pcsx2_journal.bak.", m_slot);
+		FileSystem::RenamePath(journalFileName.c_str(), (journalFileName + ".bak").c_str());
+	}
+
+	auto journalFile = FileSystem::OpenManagedCFile(tempFileName.c_str(), "wb");
+	if (!journalFile)
+	{
+		Console.Warning("FolderMcd: Failed to create journal for slot %u, flushing without it.", m_slot);
+		return;
+	}
+
+	const u32 pageCount = GetSizeInClusters() * 2;
+	const FolderMemoryCardJournalHeader header = {FolderMemoryCardJournalHeader::MAGIC, FolderMemoryCardJournalHeader::VERSION,
+		pageCount, m_filteringEnabled, static_cast<u32>(m_filteringString.size())};
+	bool written = std::fwrite(&header, sizeof(header), 1, journalFile.get()) == 1 &&
+				   (m_filteringString.empty() || std::fwrite(m_filteringString.data(), m_filteringString.size(), 1, journalFile.get()) == 1);
+	for (u32 page = 0; written && page < pageCount; ++page)
+	{
+		auto it = m_flushCache.find(page);
+		const u8* data = (it != m_flushCache.end()) ? &it->second.raw[0] : GetSystemBlockPointer(page * PageSizeRaw);
+		if (data != nullptr)
+		{
+			written = std::fwrite(&page, sizeof(page), 1, journalFile.get()) == 1 && std::fwrite(data, PageSize, 1, journalFile.get()) == 1;
+		}
+	}
+	written = written && std::fflush(journalFile.get()) == 0;
+	journalFile.reset();
+
+	if (!written || !FileSystem::RenamePath(tempFileName.c_str(), journalFileName.c_str()))
+	{
+		Console.Warning("FolderMcd: Failed to write journal for slot %u, flushing without it.", m_slot);
+		FileSystem::DeleteFilePath(tempFileName.c_str());
+	}
+}
+
+void FolderMemoryCard::ReplayJournal()
+{
+	const std::string journalFileName(Path::Combine(m_folderName, "_pcsx2_journal"));
+	if (!m_performFileWrites || !FileSystem::FileExists(journalFileName.c_str()))
+	{
+		return;
+	}
+
+	const auto keepJournal = [&journalFileName](const char* reason) {
+		Console.Warning("FolderMcd: Not replaying %s, %s. Keeping it as _pcsx2_journal.bak.", journalFileName.c_str(), reason);
+		FileSystem::RenamePath(journalFileName.c_str(), (journalFileName + ".bak").c_str());
+	};
+
+	constexpr size_t recordSize = sizeof(u32) + PageSize;
+	const std::optional<std::vector<u8>> journal = FileSystem::ReadBinaryFile(journalFileName.c_str());
+	FolderMemoryCardJournalHeader header;
+	if (!journal.has_value() || journal->size() < sizeof(header))
+	{
+		keepJournal("it couldn't be read");
+		return;
+	}
+
+	std::memcpy(&header, journal->data(), sizeof(header));
+	const size_t recordsStart = sizeof(header) + header.filterLength;
+	if (header.magic != FolderMemoryCardJournalHeader::MAGIC || header.version != FolderMemoryCardJournalHeader::VERSION ||
+		journal->size() < recordsStart || (journal->size() - recordsStart) % recordSize != 0)
+	{
+		keepJournal("it is corrupted");
+		return;
+	}
+
+	// with a different filter, the saves which aren't loaded now would be deleted from the host
+	// leave it for the next time the card is opened with the same filter, WriteJournal() moves it away before it goes stale
+	const std::string_view filter(reinterpret_cast<const char*>(journal->data() + sizeof(header)), header.filterLength);
+	if ((header.filteringEnabled != 0) != m_filteringEnabled || filter != m_filteringString)
+	{
+		Console.Warning("FolderMcd: Not replaying %s yet, it was written with different filter settings.", journalFileName.c_str());
+		return;
+	}
+
+	const u32 pageCount = GetSizeInClusters() * 2;
+	if (header.pageCount != pageCount)
+	{
+		keepJournal("it was written for a different card size");
+		return;
+	}
+
+	Console.Warning("FolderMcd: Last flush of slot %u was interrupted, replaying its journal.", m_slot);
+	for (size_t offset = recordsStart; offset < journal->size(); offset += recordSize)
+	{
+		u32 page;
+		std::memcpy(&page, journal->data() + offset, sizeof(page));
+		if (page < pageCount)
+		{
+			Save(journal->data() + offset + sizeof(page), page * PageSizeRaw, PageSize);
+		}
+	}
+
+	// the pages are in the cache now, and the flush journals them again
+	FileSystem::DeleteFilePath(journalFileName.c_str());
+	Flush();
+}
+
 void FolderMemoryCard::FlushFileEntries()
 {
 	// Flush all file entry data from the cache into m_fileEntryDict.
 	const u32 rootDirCluster = m_superBlock.data.rootdir_cluster;
-	FlushCluster(rootDirCluster + m_superBlock.data.alloc_offset);
+	const bool rootChanged = FlushCluster(rootDirCluster + m_superBlock.data.alloc_offset);
 	MemoryCardFileEntryCluster* rootEntries = &m_fileEntryDict[rootDirCluster];
 	if (rootEntries->entries[0].IsValid() && rootEntries->entries[0].IsUsed())
 	{
-		FlushFileEntries(rootDirCluster, rootEntries->entries[0].entry.data.length);
+		FlushFileEntries(rootDirCluster, rootEntries->entries[0].entry.data.length, {}, nullptr, rootChanged);
 	}
 }
 
-void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainingFiles, const std::string& dirPath, MemoryCardFileMetadataReference* parent)
+void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainingFiles, const std::string& dirPath, MemoryCardFileMetadataReference* parent, bool clusterWasFlushed, bool dirChanged)
 {
 	// flush the current cluster
-	FlushCluster(dirCluster + m_superBlock.data.alloc_offset);
+	// entries in a cluster that wasn't written to are unchanged, so their index and metadata files on the host are still up to date
+	const bool clusterFlushed = FlushCluster(dirCluster + m_superBlock.data.alloc_offset) || clusterWasFlushed || m_flushAllMetadata;
+	// unless the directory's file count changed, then entries written to a later cluster before an earlier flush may be new
+	const bool entriesChanged = clusterFlushed || dirChanged;
+	const bool writeMetadata = m_performFileWrites && entriesChanged;
 
 	// if either of the current entries is a subdir, flush that too
 	MemoryCardFileEntryCluster* entries = &m_fileEntryDict[dirCluster];
@@ -1239,7 +1504,7 @@ void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainin
 					bool filenameCleaned = FileAccessHelper::CleanMemcardFilename(cleanName);
 					const std::string subDirPath(Path::Combine(dirPath, cleanName));
 
-					if (m_performFileWrites)
+					if (writeMetadata)
 					{
 						// if this directory has nonstandard metadata, write that to the file system
 						const std::string fullSubDirPath(Path::Combine(m_folderName, subDirPath));
@@ -1316,7 +1581,7 @@ void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainin
 
 					MemoryCardFileMetadataReference* dirRef = AddDirEntryToMetadataQuickAccess(entry, parent);
 
-					FlushFileEntries(entry->entry.data.cluster, entry->entry.data.length, subDirPath, dirRef);
+					FlushFileEntries(entry->entry.data.cluster, entry->entry.data.length, subDirPath, dirRef, false, clusterFlushed);
 				}
 			}
 			else if (entry->IsFile())
@@ -1326,7 +1591,7 @@ void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainin
 				if (entry->entry.data.length == 0)
 				{
 					// empty files need to be explicitly created, as there will be no data cluster referencing it later
-					if (m_performFileWrites)
+					if (writeMetadata)
 					{
 						char cleanName[sizeof(entry->entry.data.name)];
 						memcpy(cleanName, (const char*)entry->entry.data.name, sizeof(cleanName));
@@ -1346,7 +1611,7 @@ void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainin
 					}
 				}
 
-				if (m_performFileWrites)
+				if (writeMetadata)
 				{
 					FileAccessHelper::WriteIndex(m_folderName, entry, parent);
 				}
@@ -1358,7 +1623,7 @@ void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainin
 	const u32 nextCluster = m_fat.data[0][0][dirCluster];
 	if (nextCluster != (LastDataCluster | DataClusterInUseMask))
 	{
-		FlushFileEntries(nextCluster & NextDataClusterMask, remainingFiles - 2, dirPath, parent);
+		FlushFileEntries(nextCluster & NextDataClusterMask, remainingFiles - 2, dirPath, parent, false, entriesChanged);
 	}
 }
 
@@ -1434,20 +1699,20 @@ void FolderMemoryCard::RemoveUnchangedDataFromCache(const MemoryCardFileEntry* c
 		for (int i = 0; i < 2; ++i)
 		{
 			const u32 page = (cluster + alloc_offset) * 2 + i;
-			auto newIt = m_cache.find(page);
-			if (newIt == m_cache.end())
+			auto newIt = m_flushCache.find(page);
+			if (newIt == m_flushCache.end())
 			{
 				continue;
 			}
-			auto oldIt = m_oldDataCache.find(page);
-			if (oldIt == m_oldDataCache.end())
+			auto oldIt = m_flushOldDataCache.find(page);
+			if (oldIt == m_flushOldDataCache.end())
 			{
 				continue;
 			}
 
 			if (memcmp(&oldIt->second.raw[0], &newIt->second.raw[0], PageSize) == 0)
 			{
-				m_cache.erase(newIt);
+				m_flushCache.erase(newIt);
 			}
 		}
 
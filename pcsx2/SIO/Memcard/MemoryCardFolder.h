@@ -3,12 +3,15 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include "Config.h"
+#include "common/Threading.h"
 
 //#define DEBUG_WRITE_FOLDER_CARD_IN_MEMORY_TO_FILE_ON_CHANGE
 
@@ -281,11 +284,27 @@ protected:
 	// used to reduce the amount of disk I/O by not re-writing unchanged data that just happened to be
 	// touched in memory due to how actual physical memory cards have to erase and rewrite in blocks
 	std::map<u32, MemoryCardPage> m_oldDataCache;
+
+	// m_cache and m_oldDataCache as they were when the running flush started, owned by the flush thread until it's done
+	// pages that couldn't be flushed are merged back into m_cache afterwards
+	std::map<u32, MemoryCardPage> m_flushCache;
+	std::map<u32, MemoryCardPage> m_flushOldDataCache;
+	// copy of m_flushCache that Read() and Save() use on the CPU thread while the flush thread works on the original,
+	// so pages which are being flushed never have to be read back from the file system
+	std::map<u32, MemoryCardPage> m_flushSnapshot;
+	// held by the flush thread while it flushes, everything the flush touches apart from m_flushCache and
+	// m_flushOldDataCache (superblock, FAT, file entries, open host files) must only be accessed with it held
+	mutable std::mutex m_flushMutex;
+	Threading::Thread m_flushThread;
+	std::atomic_bool m_flushRunning;
 	// if > 0, the amount of frames until data is flushed to the file system
 	// reset to FramesAfterWriteUntilFlush on each write
 	int m_framesUntilFlush;
 	// used to figure out if contents were changed for savestate-related purposes, see GetCRC()
 	u64 m_timeLastWritten;
+	// if set, the next flush rewrites the host metadata of all files and directories, not just changed ones
+	// set on open so missing or outdated index files get fixed up once
+	bool m_flushAllMetadata;
 
 	// remembers and keeps the last accessed file open for further access
 	FileAccessHelper m_lastAccessedFile;
@@ -307,7 +326,7 @@ protected:
 
 public:
 	FolderMemoryCard();
-	virtual ~FolderMemoryCard() = default;
+	virtual ~FolderMemoryCard();
 
 	void Lock();
 	void Unlock();
@@ -466,9 +485,32 @@ protected:
 	bool WriteToFile(const u8* src, u32 adr, u32 dataLength);
 
 
-	// flush the whole cache to the internal data and/or host file system
+	// flush the whole cache to the internal data and/or host file system, waits for any running flush first
 	void Flush();
 
+	// hand the cache over to the flush thread and return without waiting for it to be written
+	// falls back to Flush() if the thread can't be started
+	void StartFlush();
+
+	// wait for a flush started by StartFlush() to finish, and merge pages it couldn't write back into the cache
+	void WaitForFlush();
+
+	// moves the cache into m_flushCache and m_flushOldDataCache for FlushPending()
+	void BeginFlush();
+
+	// merges what's left in m_flushCache back into the cache and drops the snapshot
+	void EndFlush();
+
+	// flushes m_flushCache, call with m_flushMutex held
+	void FlushPending();
+
+	// writes every page of m_flushCache and all system and file entry pages to _pcsx2_journal before they're flushed,
+	// so an interrupted flush can be replayed on top of the card that's loaded from the folder the next time
+	void WriteJournal();
+
+	// replays _pcsx2_journal if the last flush was interrupted, call after loading the memory card data
+	void ReplayJournal();
+
 	// flush a single page of the cache to the internal data and/or host file system
 	bool FlushPage(const u32 page);
 
@@ -485,7 +527,10 @@ protected:
 	void FlushFileEntries();
 
 	// flush a directory's file entries and all its subdirectories to the internal data
-	void FlushFileEntries(const u32 dirCluster, const u32 remainingFiles, const std::string& dirPath = {}, MemoryCardFileMetadataReference* parent = nullptr);
+	// host metadata is only rewritten for entries in clusters that were written to since the last flush,
+	// set clusterWasFlushed if the caller already flushed dirCluster and it had been written to,
+	// and dirChanged if the cluster holding the directory's file count was, which applies to its whole cluster chain
+	void FlushFileEntries(const u32 dirCluster, const u32 remainingFiles, const std::string& dirPath = {}, MemoryCardFileMetadataReference* parent = nullptr, bool clusterWasFlushed = false, bool dirChanged = false);
 
 	// "delete" (prepend '_pcsx2_deleted_' to) any files that exist in oldFileEntries but no longer exist in m_fileEntryDict
 	// also calls RemoveUnchangedDataFromCache() since both operate on comparing with the old file entires
@@ -497,7 +542,7 @@ protected:
 	// - dirPath: Path to the current directory relative to the root of the memcard. Must be identical for both entries.
 	void FlushDeletedFilesAndRemoveUnchangedDataFromCache(const std::vector<MemoryCardFileEntryTreeNode>& oldFileEntries, const u32 newCluster, const u32 newFileCount, const std::string& dirPath);
 
-	// try and remove unchanged data from m_cache
+	// try and remove unchanged data from m_flushCache
 	// oldEntry and newEntry should be equivalent entries found by FindEquivalent()
 	void RemoveUnchangedDataFromCache(const MemoryCardFileEntry* const oldEntry, const MemoryCardFileEntry* const newEntry);
 
@@ -6,6 +6,7 @@
 #include "SPU2/defs.h"
 #include "SPU2/spu2.h"
 #include "SPU2/interpolate_table.h"
+#include "SPU2/VoiceBatch.h"
 
 #include "common/Assertions.h"
 
@@ -420,7 +421,7 @@ static __forceinline StereoOut32 MixVoice(uint coreidx, uint voiceidx)
 	return voiceOut;
 }
 
-static __forceinline void MixCoreVoices(VoiceMixSet& dest, const uint coreidx)
+void MixCoreVoicesSerial(VoiceMixSet& dest, const uint coreidx)
 {
 	V_Core& thiscore(Cores[coreidx]);
 
@@ -437,6 +438,97 @@ static __forceinline void MixCoreVoices(VoiceMixSet& dest, const uint coreidx)
 	}
 }
 
+// The batched mixer writes voice 1 and 3 output back to memory after every voice has decoded,
+// where MixVoice() does it before the following voices decode. That only makes a difference
+// when one of those voices is reading from the dynamic area, which is where the output goes.
+bool CanMixCoreVoicesBatched(const V_Core& thiscore)
+{
+	for (uint voiceidx = 2; voiceidx < V_Core::NumVoices; ++voiceidx)
+	{
+		if ((thiscore.Voices[voiceidx].NextA & 0xFFFF8) < SPU2_DYN_MEMLINE)
+			return false;
+	}
+
+	return true;
+}
+
+void MixCoreVoicesBatched(VoiceMixSet& dest, const uint coreidx)
+{
+	V_Core& thiscore(Cores[coreidx]);
+	alignas(32) static V_VoiceBatch batch;
+
+	// Everything up to the envelope, a voice at a time, in the same order as MixVoice().
+	for (uint voiceidx = 0; voiceidx < V_Core::NumVoices; ++voiceidx)
+	{
+		V_Voice& vc(thiscore.Voices[voiceidx]);
+
+		vc.Volume.Update();
+		DecodeSamples(coreidx, voiceidx);
+
+		const int phase = (vc.SP & 0x0ff0) >> 4;
+		for (uint tap = 0; tap < 4; tap++)
+		{
+			batch.Samples[tap][voiceidx] = vc.DecodeFifo[(vc.DecPosRead + tap) % 32];
+			batch.Interp[tap][voiceidx] = interpTable[phase][tap];
+		}
+
+		if (vc.ADSR.Phase > V_ADSR::PHASE_STOPPED)
+		{
+			CalculateADSR(thiscore, voiceidx);
+			batch.ActiveMask[voiceidx] = -1;
+			batch.Envelope[voiceidx] = vc.ADSR.Value;
+		}
+		else
+		{
+			batch.ActiveMask[voiceidx] = 0;
+			batch.Envelope[voiceidx] = 0;
+		}
+
+		batch.NoiseMask[voiceidx] = vc.Noise ? -1 : 0;
+		batch.VolumeL[voiceidx] = vc.Volume.Left.Value;
+		batch.VolumeR[voiceidx] = vc.Volume.Right.Value;
+		batch.DryL[voiceidx] = thiscore.VoiceGates[voiceidx].DryL;
+		batch.DryR[voiceidx] = thiscore.VoiceGates[voiceidx].DryR;
+		batch.WetL[voiceidx] = thiscore.VoiceGates[voiceidx].WetL;
+		batch.WetR[voiceidx] = thiscore.VoiceGates[voiceidx].WetR;
+	}
+
+	MixVoiceBatch(batch, GetNoiseValues(thiscore), dest);
+
+	// Pitch modulation needs the previous voice's output, so this has to wait for the batch.
+	for (uint voiceidx = 0; voiceidx < V_Core::NumVoices; ++voiceidx)
+	{
+		V_Voice& vc(thiscore.Voices[voiceidx]);
+		const s32 Value = batch.Out[voiceidx];
+
+		if (batch.ActiveMask[voiceidx])
+		{
+			vc.OutX = Value;
+
+			if (IsDevBuild)
+				DebugCores[coreidx].Voices[voiceidx].displayPeak = std::max(DebugCores[coreidx].Voices[voiceidx].displayPeak, (s32)vc.OutX);
+		}
+
+		UpdatePitch(coreidx, voiceidx);
+
+		ConsumeSamples(thiscore, voiceidx);
+
+		// Write-back of raw voice data (post ADSR applied)
+		if (voiceidx == 1)
+			spu2M_WriteFast(((0 == coreidx) ? 0x400 : 0xc00) + OutPos, Value);
+		else if (voiceidx == 3)
+			spu2M_WriteFast(((0 == coreidx) ? 0x600 : 0xe00) + OutPos, Value);
+	}
+}
+
+static __forceinline void MixCoreVoices(VoiceMixSet& dest, const uint coreidx)
+{
+	if (CanMixCoreVoicesBatched(Cores[coreidx]))
+		MixCoreVoicesBatched(dest, coreidx);
+	else
+		MixCoreVoicesSerial(dest, coreidx);
+}
+
 static __forceinline StereoOut32 MixCore(const uint coreidx, const VoiceMixSet& inVoices, const StereoOut32& Input, const StereoOut32& Ext)
 {
 	V_Core& thiscore(Cores[coreidx]);
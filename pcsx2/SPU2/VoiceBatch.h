@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "GS/GSVector.h"
+#include "SPU2/defs.h"
+
+// Per-voice inputs and outputs of the vectorised part of the voice mixer, in structure-of-arrays
+// form with one lane per voice. Everything which branches or has side effects per voice (ADPCM
+// decoding, ADSR, IRQs) is still done a voice at a time, and fills this in. Interpolation, the
+// envelope, volume, and mixing into the output are then done for all voices of a core at once.
+struct alignas(32) V_VoiceBatch
+{
+	static constexpr uint NumVoices = V_Core::NumVoices;
+
+	s32 Samples[4][NumVoices]; // Decoded samples under the interpolation window
+	s32 Interp[4][NumVoices];  // Interpolation coefficients for the current phase
+	s32 NoiseMask[NumVoices];  // All bits set for voices which output noise
+	s32 ActiveMask[NumVoices]; // All bits set for voices which aren't stopped
+	s32 Envelope[NumVoices];   // ADSR level
+	s32 VolumeL[NumVoices];
+	s32 VolumeR[NumVoices];
+	s32 DryL[NumVoices];       // Voice gates, see V_VoiceGates
+	s32 DryR[NumVoices];
+	s32 WetL[NumVoices];
+	s32 WetR[NumVoices];
+
+	s32 Out[NumVoices];        // Voice output after the envelope, zero for stopped voices
+};
+
+MULTI_ISA_UNSHARED_START
+
+template <typename V>
+static __forceinline void MixVoiceBatchLanes(V_VoiceBatch& batch, uint i, const V& noise, V (&acc)[4])
+{
+	// Each tap is shifted separately, like the hardware does.
+	V value = V::template load<true>(&batch.Samples[0][i]).mul32l(V::template load<true>(&batch.Interp[0][i])).template sra32<15>();
+	for (uint tap = 1; tap < 4; tap++)
+	{
+		const V s = V::template load<true>(&batch.Samples[tap][i]);
+		const V c = V::template load<true>(&batch.Interp[tap][i]);
+		value = value.add32(s.mul32l(c).template sra32<15>());
+	}
+
+	const V noise_mask = V::template load<true>(&batch.NoiseMask[i]);
+	value = (value.andnot(noise_mask) | (noise & noise_mask)) & V::template load<true>(&batch.ActiveMask[i]);
+	value = value.mul32l(V::template load<true>(&batch.Envelope[i])).template sra32<15>();
+	V::template store<true>(&batch.Out[i], value);
+
+	const V left = value.mul32l(V::template load<true>(&batch.VolumeL[i])).template sra32<15>();
+	const V right = value.mul32l(V::template load<true>(&batch.VolumeR[i])).template sra32<15>();
+	acc[0] = acc[0].add32(left & V::template load<true>(&batch.DryL[i]));
+	acc[1] = acc[1].add32(right & V::template load<true>(&batch.DryR[i]));
+	acc[2] = acc[2].add32(left & V::template load<true>(&batch.WetL[i]));
+	acc[3] = acc[3].add32(right & V::template load<true>(&batch.WetR[i]));
+}
+
+template <typename V>
+static __forceinline void MixVoiceBatchImpl(V_VoiceBatch& batch, s32 noise, VoiceMixSet& dest)
+{
+	constexpr uint lanes = sizeof(V) / sizeof(s32);
+	static_assert((V_VoiceBatch::NumVoices % lanes) == 0);
+
+	const V vnoise(noise);
+	V acc[4] = {V::zero(), V::zero(), V::zero(), V::zero()};
+	for (uint i = 0; i < V_VoiceBatch::NumVoices; i += lanes)
+		MixVoiceBatchLanes(batch, i, vnoise, acc);
+
+	alignas(32) s32 sums[4][lanes];
+	for (uint i = 0; i < 4; i++)
+		V::template store<true>(sums[i], acc[i]);
+
+	for (uint lane = 0; lane < lanes; lane++)
+	{
+		dest.Dry.Left += sums[0][lane];
+		dest.Dry.Right += sums[1][lane];
+		dest.Wet.Left += sums[2][lane];
+		dest.Wet.Right += sums[3][lane];
+	}
+}
+
+/// Interpolates, applies the envelope and volume, and mixes all voices in the batch into dest.
+/// Matches MixVoice() bit for bit, noise is the core's current noise level.
+static __forceinline void MixVoiceBatch(V_VoiceBatch& batch, s32 noise, VoiceMixSet& dest)
+{
+#if _M_SSE >= 0x501
+	MixVoiceBatchImpl<GSVector8i>(batch, noise, dest);
+#else
+	MixVoiceBatchImpl<GSVector4i>(batch, noise, dest);
+#endif
+}
+
+// The two ways Mixer.cpp mixes one sample of a core's voices, which have to give the same output and leave the
+// same voice state behind. The batched one is only used when CanMixCoreVoicesBatched() allows it.
+void MixCoreVoicesSerial(VoiceMixSet& dest, const uint coreidx);
+bool CanMixCoreVoicesBatched(const V_Core& thiscore);
+void MixCoreVoicesBatched(VoiceMixSet& dest, const uint coreidx);
+
+MULTI_ISA_UNSHARED_END
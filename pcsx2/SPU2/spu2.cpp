@@ -13,6 +13,11 @@
 #include "VMManager.h"
 
 #include "common/Error.h"
+#include "common/Threading.h"
+#include "common/boost_spsc_queue.hpp"
+
+#include <atomic>
+#include <thread>
 
 const StereoOut32 StereoOut32::Empty(0, 0);
 
@@ -22,6 +27,11 @@ namespace SPU2
 	static void UpdateSampleRate();
 	static float GetNominalRate();
 	static void InternalReset(bool psxmode);
+
+	static void StartOutputThread();
+	static void StopOutputThread();
+	static void SyncOutputThread();
+	static void OutputThreadEntry();
 } // namespace SPU2
 
 u64 lClocks = 0;
@@ -36,6 +46,15 @@ static u32 s_current_chunk_pos;
 static u32 s_standard_volume = 0;
 static u32 s_fast_forward_volume = 0;
 
+// Time stretching and expansion are done on a separate thread, so the emulation thread only has to
+// queue up the mixed chunks. Anything else which touches the stream's stretcher syncs with it first.
+using OutputChunk = std::array<float, AudioStream::CHUNK_SIZE * 2>;
+static constexpr u32 OUTPUT_QUEUE_CHUNKS = 64; // ~85ms at 48KHz
+static ringbuffer_base<OutputChunk, OUTPUT_QUEUE_CHUNKS> s_output_queue;
+static Threading::WorkSema s_output_sema;
+static Threading::Thread s_output_thread;
+static std::atomic_bool s_output_thread_exit{false};
+
 float DCFilterIn[2], DCFilterOut[2];
 
 u32 SPU2::GetConsoleSampleRate()
@@ -114,6 +133,7 @@ void SPU2::CreateOutputStream()
 		SPU2::SaveOutputVolume();
 
 	const u32 sample_rate = GetConsoleSampleRate();
+	StopOutputThread();
 	s_output_stream.reset();
 
 	Error error;
@@ -131,6 +151,57 @@ void SPU2::CreateOutputStream()
 	SPU2::UpdateOutputVolume();
 	s_output_stream->SetNominalRate(GetNominalRate());
 	s_output_stream->SetPaused(VMManager::GetState() == VMState::Paused);
+	StartOutputThread();
+}
+
+void SPU2::StartOutputThread()
+{
+	// Without stretching or expansion, writing is just a copy into the stream's buffer.
+	if (!s_output_stream || (!s_output_stream->IsStretchEnabled() && !s_output_stream->IsExpansionEnabled()))
+		return;
+
+	s_output_thread_exit.store(false, std::memory_order_relaxed);
+	s_output_thread.Start(&SPU2::OutputThreadEntry);
+}
+
+void SPU2::StopOutputThread()
+{
+	if (!s_output_thread.Joinable())
+		return;
+
+	// Thread writes out anything which is still queued before exiting.
+	s_output_thread_exit.store(true, std::memory_order_release);
+	s_output_sema.NotifyOfWork();
+	s_output_thread.Join();
+}
+
+void SPU2::SyncOutputThread()
+{
+	if (s_output_thread.Joinable())
+		s_output_sema.WaitForEmpty();
+}
+
+void SPU2::OutputThreadEntry()
+{
+	Threading::SetNameOfCurrentThread("SPU2 Output");
+
+	OutputChunk chunk;
+	for (;;)
+	{
+		s_output_sema.WaitForWork();
+
+		while (s_output_queue.pop(chunk))
+			s_output_stream->WriteChunk(chunk.data());
+
+		if (s_output_thread_exit.load(std::memory_order_acquire))
+		{
+			// Chunks pushed between the last pop and the exit request would otherwise be left in the queue,
+			// and played by the next thread, possibly on a stream with a different sample rate.
+			while (s_output_queue.pop(chunk))
+				s_output_stream->WriteChunk(chunk.data());
+			break;
+		}
+	}
 }
 
 void SPU2::UpdateSampleRate()
@@ -255,6 +326,8 @@ void SPU2::OnTargetSpeedChanged()
 	if (!s_output_stream)
 		return;
 
+	SyncOutputThread();
+
 	if (!s_output_stream->IsStretchEnabled())
 	{
 		s_output_stream->EmptyBuffer();
@@ -308,6 +381,7 @@ void SPU2::Close()
 {
 	FileLog("[%10d] SPU2 Close\n", Cycles);
 
+	StopOutputThread();
 	s_output_stream.reset();
 
 #ifdef PCSX2_DEVBUILD
@@ -359,7 +433,9 @@ void SPU2::CheckForConfigChanges(const Pcsx2Config& old_config)
 	}
 	else if (opts.IsTimeStretchEnabled() != old_opts.IsTimeStretchEnabled())
 	{
+		StopOutputThread();
 		s_output_stream->SetStretchEnabled(opts.IsTimeStretchEnabled());
+		StartOutputThread();
 	}
 
 #ifdef PCSX2_DEVBUILD
@@ -523,7 +599,16 @@ __forceinline void spu2Output(StereoOut32 out)
 	{
 		s_current_chunk_pos = 0;
 
-		s_output_stream->WriteChunk(s_current_chunk.data());
+		if (s_output_thread.Joinable())
+		{
+			while (!s_output_queue.push(s_current_chunk))
+				std::this_thread::yield();
+			s_output_sema.NotifyOfWork();
+		}
+		else
+		{
+			s_output_stream->WriteChunk(s_current_chunk.data());
+		}
 
 		if (SPU2::IsAudioCaptureActive()) [[unlikely]]
 			GSCapture::DeliverAudioPacket(s_current_chunk.data());
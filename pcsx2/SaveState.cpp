@@ -36,18 +36,26 @@
 #include "common/Path.h"
 #include "common/ScopedGuard.h"
 #include "common/StringUtil.h"
+#include "common/Threading.h"
 #include "common/ZipHelpers.h"
 
 #include "IconsFontAwesome.h"
 #include "fmt/format.h"
 
+#include <atomic>
 #include <csetjmp>
 #include <png.h>
+#include <thread>
+#include <zlib.h>
+#include <zstd.h>
 
 using namespace R5900;
 
 static tlbs s_tlb_backup[std::size(tlb)];
 
+// Set while saving/loading in-memory states, which happens far too often to log every component.
+static bool s_quiet_freeze = false;
+
 static void PreLoadPrep()
 {
 	// ensure everything is in sync before we start overwriting stuff.
@@ -173,7 +181,7 @@ bool SaveStateBase::FreezeBios()
 bool SaveStateBase::FreezeInternals(Error* error)
 {
 	// Print this until the MTVU problem in gifPathFreeze is taken care of (rama)
-	if (THREAD_VU1)
+	if (THREAD_VU1 && !s_quiet_freeze)
 		Console.Warning("MTVU speedhack is enabled, saved states may not be stable");
 
 	if (!vmFreeze())
@@ -366,7 +374,8 @@ static bool SysState_ComponentFreezeIn(zip_file_t* zf, SysState_Component comp)
 	if (comp.freeze(FreezeAction::Size, &fP) != 0)
 		fP.size = 0;
 
-	Console.WriteLn("  Loading %s", comp.name);
+	if (!s_quiet_freeze)
+		Console.WriteLn("  Loading %s", comp.name);
 
 	std::unique_ptr<u8[]> data;
 	if (fP.size > 0)
@@ -390,6 +399,29 @@ static bool SysState_ComponentFreezeIn(zip_file_t* zf, SysState_Component comp)
 	return true;
 }
 
+static bool SysState_ComponentFreezeIn(std::span<const u8> data, SysState_Component comp)
+{
+	freezeData fP = { 0, nullptr };
+	if (comp.freeze(FreezeAction::Size, &fP) != 0)
+		fP.size = 0;
+
+	if (data.size() < static_cast<size_t>(fP.size))
+	{
+		Console.Error(fmt::format("* {}: Save data is truncated", comp.name));
+		return false;
+	}
+
+	// Load doesn't modify the buffer.
+	fP.data = fP.size > 0 ? const_cast<u8*>(data.data()) : nullptr;
+	if (comp.freeze(FreezeAction::Load, &fP) != 0)
+	{
+		Console.Error(fmt::format("* {}: Failed to load freeze data", comp.name));
+		return false;
+	}
+
+	return true;
+}
+
 static bool SysState_ComponentFreezeOut(SaveStateBase& writer, SysState_Component comp)
 {
 	freezeData fP = {};
@@ -405,7 +437,8 @@ static bool SysState_ComponentFreezeOut(SaveStateBase& writer, SysState_Componen
 	const int size = fP.size;
 	writer.PrepBlock(size);
 
-	Console.WriteLn("  Saving %s", comp.name);
+	if (!s_quiet_freeze)
+		Console.WriteLn("  Saving %s", comp.name);
 
 	fP.data = writer.GetBlockPtr();
 	if (comp.freeze(FreezeAction::Save, &fP) != 0)
@@ -418,6 +451,14 @@ static bool SysState_ComponentFreezeOut(SaveStateBase& writer, SysState_Componen
 	return true;
 }
 
+static bool SysState_ComponentFreezeInNew(std::span<const u8> data, const char* name, bool(*do_state_func)(StateWrapper&))
+{
+	StateWrapper::ReadOnlyMemoryStream stream(data.empty() ? nullptr : data.data(), data.size());
+	StateWrapper sw(&stream, StateWrapper::Mode::Read, g_SaveVersion);
+
+	return do_state_func(sw);
+}
+
 static bool SysState_ComponentFreezeInNew(zip_file_t* zf, const char* name, bool(*do_state_func)(StateWrapper&))
 {
 	// TODO: We could decompress on the fly here for a little bit more speed.
@@ -429,10 +470,7 @@ static bool SysState_ComponentFreezeInNew(zip_file_t* zf, const char* name, bool
 			data = std::move(optdata.value());
 	}
 
-	StateWrapper::ReadOnlyMemoryStream stream(data.empty() ? nullptr : data.data(), data.size());
-	StateWrapper sw(&stream, StateWrapper::Mode::Read, g_SaveVersion);
-
-	return do_state_func(sw);
+	return SysState_ComponentFreezeInNew(std::span<const u8>(data), name, do_state_func);
 }
 
 static bool SysState_ComponentFreezeOutNew(SaveStateBase& writer, const char* name, u32 reserve, bool (*do_state_func)(StateWrapper&))
@@ -467,6 +505,7 @@ public:
 
 	virtual const char* GetFilename() const = 0;
 	virtual bool FreezeIn(zip_file_t* zf) const = 0;
+	virtual bool FreezeIn(std::span<const u8> data) const = 0;
 	virtual bool FreezeOut(SaveStateBase& writer) const = 0;
 	virtual bool IsRequired() const = 0;
 };
@@ -479,6 +518,7 @@ protected:
 
 public:
 	virtual bool FreezeIn(zip_file_t* zf) const;
+	virtual bool FreezeIn(std::span<const u8> data) const;
 	virtual bool FreezeOut(SaveStateBase& writer) const;
 	virtual bool IsRequired() const { return true; }
 
@@ -500,6 +540,19 @@ bool MemorySavestateEntry::FreezeIn(zip_file_t* zf) const
 	return true;
 }
 
+bool MemorySavestateEntry::FreezeIn(std::span<const u8> data) const
+{
+	const u32 expectedSize = GetDataSize();
+	if (data.size() != expectedSize)
+	{
+		Console.WriteLn(Color_Yellow, " '%s' is incomplete (expected 0x%x bytes, loading only 0x%x bytes)",
+			GetFilename(), expectedSize, static_cast<u32>(data.size()));
+	}
+
+	std::memcpy(GetDataPtr(), data.data(), std::min<size_t>(data.size(), expectedSize));
+	return true;
+}
+
 bool MemorySavestateEntry::FreezeOut(SaveStateBase& writer) const
 {
 	writer.FreezeMem(GetDataPtr(), GetDataSize());
@@ -528,6 +581,8 @@ public:
 	{
 		return MemorySavestateEntry::FreezeIn(zf);
 	}
+
+	using MemorySavestateEntry::FreezeIn;
 };
 
 class SavestateEntry_IopMemory final : public MemorySavestateEntry
@@ -617,6 +672,7 @@ public:
 
 	const char* GetFilename() const override { return "SPU2.bin"; }
 	bool FreezeIn(zip_file_t* zf) const override { return SysState_ComponentFreezeIn(zf, SPU2_); }
+	bool FreezeIn(std::span<const u8> data) const override { return SysState_ComponentFreezeIn(data, SPU2_); }
 	bool FreezeOut(SaveStateBase& writer) const override { return SysState_ComponentFreezeOut(writer, SPU2_); }
 	bool IsRequired() const override { return true; }
 };
@@ -628,6 +684,7 @@ public:
 
 	const char* GetFilename() const override { return "USB.bin"; }
 	bool FreezeIn(zip_file_t* zf) const override { return SysState_ComponentFreezeInNew(zf, "USB", &USB::DoState); }
+	bool FreezeIn(std::span<const u8> data) const override { return SysState_ComponentFreezeInNew(data, "USB", &USB::DoState); }
 	bool FreezeOut(SaveStateBase& writer) const override { return SysState_ComponentFreezeOutNew(writer, "USB", 16 * 1024, &USB::DoState); }
 	bool IsRequired() const override { return false; }
 };
@@ -639,6 +696,7 @@ public:
 
 	const char* GetFilename() const override { return "PAD.bin"; }
 	bool FreezeIn(zip_file_t* zf) const override { return SysState_ComponentFreezeInNew(zf, "PAD", &Pad::Freeze); }
+	bool FreezeIn(std::span<const u8> data) const override { return SysState_ComponentFreezeInNew(data, "PAD", &Pad::Freeze); }
 	bool FreezeOut(SaveStateBase& writer) const override { return SysState_ComponentFreezeOutNew(writer, "PAD", 16 * 1024, &Pad::Freeze); }
 	bool IsRequired() const override { return true; }
 };
@@ -650,6 +708,7 @@ public:
 
 	const char* GetFilename() const { return "GS.bin"; }
 	bool FreezeIn(zip_file_t* zf) const { return SysState_ComponentFreezeIn(zf, GS); }
+	bool FreezeIn(std::span<const u8> data) const { return SysState_ComponentFreezeIn(data, GS); }
 	bool FreezeOut(SaveStateBase& writer) const { return SysState_ComponentFreezeOut(writer, GS); }
 	bool IsRequired() const { return true; }
 };
@@ -676,6 +735,14 @@ class SaveStateEntry_Achievements final : public BaseSavestateEntry
 		return true;
 	}
 
+	bool FreezeIn(std::span<const u8> data) const override
+	{
+		if (Achievements::IsActive())
+			Achievements::LoadState(data);
+
+		return true;
+	}
+
 	bool FreezeOut(SaveStateBase& writer) const override
 	{
 		if (!Achievements::IsActive())
@@ -755,6 +822,99 @@ std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error)
 	return destlist;
 }
 
+bool SaveState_SaveToBuffer(std::vector<u8>& buffer, Error* error)
+{
+	memSavingState saveme(buffer);
+	s_quiet_freeze = true;
+	ScopedGuard quiet_guard([]() { s_quiet_freeze = false; });
+
+	if (!saveme.FreezeBios())
+	{
+		Error::SetString(error, "FreezeBios() failed");
+		return false;
+	}
+
+	if (!saveme.FreezeInternals(error))
+	{
+		if (!error->IsValid())
+			Error::SetString(error, "FreezeInternals() failed");
+
+		return false;
+	}
+
+	// Each entry is prefixed with its size, since not all of them are fixed size.
+	for (const std::unique_ptr<BaseSavestateEntry>& entry : SavestateEntries)
+	{
+		if (dynamic_cast<const SavestateEntry_EmotionMemory*>(entry.get()))
+			continue;
+
+		const int size_pos = saveme.GetCurrentPos();
+		u32 size = 0;
+		saveme.Freeze(size);
+
+		const int startpos = saveme.GetCurrentPos();
+		if (!entry->FreezeOut(saveme))
+		{
+			Error::SetString(error, fmt::format("FreezeOut() failed for {}.", entry->GetFilename()));
+			return false;
+		}
+
+		size = static_cast<u32>(saveme.GetCurrentPos() - startpos);
+		std::memcpy(&buffer[size_pos], &size, sizeof(size));
+	}
+
+	// Buffer may be reused from a previous, larger state.
+	buffer.resize(saveme.GetCurrentPos());
+	return true;
+}
+
+bool SaveState_LoadFromBuffer(const std::vector<u8>& buffer, std::span<const u8> ee_memory, Error* error)
+{
+	if (ee_memory.size() != Ps2MemSize::ExposedRam)
+	{
+		Error::SetString(error, "EE memory size does not match current configuration.");
+		return false;
+	}
+
+	s_quiet_freeze = true;
+	ScopedGuard quiet_guard([]() { s_quiet_freeze = false; });
+
+	PreLoadPrep();
+
+	memLoadingState loadme(buffer);
+	if (!loadme.FreezeBios() || !loadme.FreezeInternals(error))
+	{
+		if (!error->IsValid())
+			Error::SetString(error, "Save state corruption in internal structures.");
+
+		VMManager::Reset();
+		return false;
+	}
+
+	std::memcpy(eeMem->Main, ee_memory.data(), ee_memory.size());
+
+	for (const std::unique_ptr<BaseSavestateEntry>& entry : SavestateEntries)
+	{
+		if (dynamic_cast<const SavestateEntry_EmotionMemory*>(entry.get()))
+			continue;
+
+		u32 size = 0;
+		loadme.Freeze(size);
+		if (!loadme.IsOkay() || static_cast<size_t>(loadme.GetCurrentPos()) + size > buffer.size() ||
+			!entry->FreezeIn(std::span<const u8>(buffer.data() + loadme.GetCurrentPos(), size)))
+		{
+			Error::SetString(error, fmt::format("Save state corruption in {}.", entry->GetFilename()));
+			VMManager::Reset();
+			return false;
+		}
+
+		loadme.CommitBlock(static_cast<int>(size));
+	}
+
+	PostLoadPrep();
+	return true;
+}
+
 std::unique_ptr<SaveStateScreenshotData> SaveState_SaveScreenshot()
 {
 	static constexpr u32 SCREENSHOT_WIDTH = 640;
@@ -924,6 +1084,286 @@ static bool SaveState_ReadScreenshot(zip_t* zf, u32* out_width, u32* out_height,
 // --------------------------------------------------------------------------------------
 //  CompressThread_VmState
 // --------------------------------------------------------------------------------------
+// --------------------------------------------------------------------------------------
+//  Parallel entry compression
+// --------------------------------------------------------------------------------------
+// Zstandard entries are written as a series of independent frames, so that both compression
+// and decompression can be split across threads. Concatenated frames are part of the zstd
+// format, so libzip (and therefore older builds) read these entries like any other.
+
+static constexpr size_t SAVESTATE_CHUNK_SIZE = 4 * _1mb;
+
+// Higher levels need considerably more memory per context, so use fewer workers.
+static constexpr u32 SAVESTATE_MAX_WORKERS = 8;
+static constexpr u32 SAVESTATE_MAX_WORKERS_HIGH_LEVEL = 4;
+static constexpr int SAVESTATE_HIGH_LEVEL = 19;
+
+namespace
+{
+	struct PrecompressedEntry
+	{
+		std::vector<u8> data;
+		u64 uncompressed_size = 0;
+		u32 crc = 0;
+		size_t read_pos = 0;
+		zip_error_t error;
+	};
+
+	struct ChunkJob
+	{
+		u32 entry;
+		const u8* src;
+		size_t src_size;
+		u8* dst; // only used for decompression
+		size_t dst_size;
+		std::vector<u8> output; // only used for compression
+		u32 crc;
+		bool success;
+	};
+} // namespace
+
+template <typename T>
+static void SaveState_RunWorkers(size_t num_jobs, u32 max_workers, const T& worker)
+{
+	const u32 num_workers = static_cast<u32>(std::clamp<size_t>(
+		std::min<size_t>(num_jobs, std::thread::hardware_concurrency()), 1, max_workers));
+
+	std::vector<std::thread> threads;
+	threads.reserve(num_workers - 1);
+	for (u32 i = 1; i < num_workers; i++)
+	{
+		threads.emplace_back([&worker]() {
+			Threading::SetNameOfCurrentThread("Savestate Worker");
+			worker();
+		});
+	}
+
+	worker();
+
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+static bool SaveState_CompressEntries(ArchiveEntryList* srclist, int level, std::vector<std::unique_ptr<PrecompressedEntry>>& entries)
+{
+	const uint listlen = srclist->GetLength();
+	entries.resize(listlen);
+
+	std::vector<ChunkJob> jobs;
+	for (uint i = 0; i < listlen; i++)
+	{
+		const ArchiveEntry& entry = (*srclist)[i];
+		if (!entry.GetDataSize())
+			continue;
+
+		const u8* src = srclist->GetPtr(entry.GetDataIndex());
+		for (size_t offset = 0; offset < entry.GetDataSize(); offset += SAVESTATE_CHUNK_SIZE)
+		{
+			jobs.push_back(ChunkJob{i, src + offset, std::min(SAVESTATE_CHUNK_SIZE, entry.GetDataSize() - offset),
+				nullptr, 0, {}, 0, false});
+		}
+	}
+
+	std::atomic<size_t> next_job{0};
+	SaveState_RunWorkers(jobs.size(), (level >= SAVESTATE_HIGH_LEVEL) ? SAVESTATE_MAX_WORKERS_HIGH_LEVEL : SAVESTATE_MAX_WORKERS, [&]() {
+		ZSTD_CCtx* cctx = ZSTD_createCCtx();
+		if (cctx)
+			ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level);
+
+		for (size_t i = next_job.fetch_add(1, std::memory_order_relaxed); i < jobs.size();
+			 i = next_job.fetch_add(1, std::memory_order_relaxed))
+		{
+			ChunkJob& job = jobs[i];
+			if (!cctx)
+				continue;
+
+			job.output.resize(ZSTD_compressBound(job.src_size));
+			const size_t size = ZSTD_compress2(cctx, job.output.data(), job.output.size(), job.src, job.src_size);
+			job.success = !ZSTD_isError(size);
+			job.output.resize(job.success ? size : 0);
+			job.crc = crc32(0, job.src, static_cast<uInt>(job.src_size));
+		}
+
+		ZSTD_freeCCtx(cctx);
+	});
+
+	for (ChunkJob& job : jobs)
+	{
+		if (!job.success)
+		{
+			Console.Error(fmt::format("Failed to compress save state entry {}", (*srclist)[job.entry].GetFilename()));
+			return false;
+		}
+
+		std::unique_ptr<PrecompressedEntry>& entry = entries[job.entry];
+		if (!entry)
+		{
+			entry = std::make_unique<PrecompressedEntry>();
+			entry->data = std::move(job.output);
+			entry->crc = job.crc;
+		}
+		else
+		{
+			entry->data.insert(entry->data.end(), job.output.begin(), job.output.end());
+			entry->crc = crc32_combine(entry->crc, job.crc, static_cast<z_off_t>(job.src_size));
+		}
+
+		entry->uncompressed_size += job.src_size;
+	}
+
+	return true;
+}
+
+// Hands already-compressed data to libzip, which copies it as-is when the reported method matches.
+static zip_int64_t SaveState_PrecompressedSourceCallback(void* userdata, void* data, zip_uint64_t len, zip_source_cmd_t cmd)
+{
+	PrecompressedEntry* entry = static_cast<PrecompressedEntry*>(userdata);
+	switch (cmd)
+	{
+		case ZIP_SOURCE_OPEN:
+			entry->read_pos = 0;
+			return 0;
+
+		case ZIP_SOURCE_READ:
+		{
+			const size_t count = std::min<size_t>(len, entry->data.size() - entry->read_pos);
+			std::memcpy(data, entry->data.data() + entry->read_pos, count);
+			entry->read_pos += count;
+			return static_cast<zip_int64_t>(count);
+		}
+
+		case ZIP_SOURCE_CLOSE:
+			return 0;
+
+		case ZIP_SOURCE_STAT:
+		{
+			if (len < sizeof(zip_stat_t))
+			{
+				zip_error_set(&entry->error, ZIP_ER_INVAL, 0);
+				return -1;
+			}
+
+			zip_stat_t* st = static_cast<zip_stat_t*>(data);
+			zip_stat_init(st);
+			st->valid = ZIP_STAT_SIZE | ZIP_STAT_COMP_SIZE | ZIP_STAT_COMP_METHOD | ZIP_STAT_CRC | ZIP_STAT_ENCRYPTION_METHOD;
+			st->size = entry->uncompressed_size;
+			st->comp_size = entry->data.size();
+			st->comp_method = ZIP_CM_ZSTD;
+			st->crc = entry->crc;
+			st->encryption_method = ZIP_EM_NONE;
+			return sizeof(zip_stat_t);
+		}
+
+		case ZIP_SOURCE_ERROR:
+			return zip_error_to_data(&entry->error, data, len);
+
+		case ZIP_SOURCE_FREE:
+			zip_error_fini(&entry->error);
+			delete entry;
+			return 0;
+
+		case ZIP_SOURCE_SUPPORTS:
+			return zip_source_make_command_bitmap(ZIP_SOURCE_OPEN, ZIP_SOURCE_READ, ZIP_SOURCE_CLOSE, ZIP_SOURCE_STAT,
+				ZIP_SOURCE_ERROR, ZIP_SOURCE_FREE, ZIP_SOURCE_SUPPORTS, -1);
+
+		default:
+			zip_error_set(&entry->error, ZIP_ER_OPNOTSUPP, 0);
+			return -1;
+	}
+}
+
+// Reads and decompresses all zstd entries in parallel. Entries using other methods are left
+// empty, and should be read through libzip as usual.
+static bool SaveState_DecompressEntries(zip_t* zf, std::span<const s64> indices, std::vector<std::optional<std::vector<u8>>>& out)
+{
+	out.clear();
+	out.resize(indices.size());
+
+	std::vector<std::vector<u8>> raw(indices.size());
+	std::vector<u32> expected_crc(indices.size());
+	std::vector<ChunkJob> jobs;
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		zip_stat_t zst;
+		if (indices[i] < 0 || zip_stat_index(zf, indices[i], 0, &zst) != 0 ||
+			(zst.valid & (ZIP_STAT_COMP_METHOD | ZIP_STAT_SIZE | ZIP_STAT_COMP_SIZE | ZIP_STAT_CRC)) !=
+				(ZIP_STAT_COMP_METHOD | ZIP_STAT_SIZE | ZIP_STAT_COMP_SIZE | ZIP_STAT_CRC) ||
+			zst.comp_method != ZIP_CM_ZSTD)
+		{
+			continue;
+		}
+
+		auto zff = zip_fopen_index_managed(zf, indices[i], ZIP_FL_COMPRESSED);
+		raw[i].resize(zst.comp_size);
+		if (!zff || zip_fread(zff.get(), raw[i].data(), raw[i].size()) != static_cast<zip_int64_t>(raw[i].size()))
+			return false;
+
+		out[i].emplace(zst.size);
+		expected_crc[i] = zst.crc;
+
+		// Split on frame boundaries. States written by libzip directly are a single frame, and
+		// frames without a content size can't be placed in the output, so those use one job.
+		const size_t first_job = jobs.size();
+		size_t src_pos = 0;
+		size_t dst_pos = 0;
+		while (src_pos < raw[i].size())
+		{
+			const size_t frame_size = ZSTD_findFrameCompressedSize(&raw[i][src_pos], raw[i].size() - src_pos);
+			const unsigned long long content_size = ZSTD_getFrameContentSize(&raw[i][src_pos], raw[i].size() - src_pos);
+			if (ZSTD_isError(frame_size) || content_size == ZSTD_CONTENTSIZE_UNKNOWN ||
+				content_size == ZSTD_CONTENTSIZE_ERROR || content_size > zst.size - dst_pos)
+			{
+				jobs.resize(first_job);
+				jobs.push_back(ChunkJob{static_cast<u32>(i), raw[i].data(), raw[i].size(), out[i]->data(),
+					out[i]->size(), {}, 0, false});
+				break;
+			}
+
+			jobs.push_back(ChunkJob{static_cast<u32>(i), &raw[i][src_pos], frame_size, out[i]->data() + dst_pos,
+				static_cast<size_t>(content_size), {}, 0, false});
+			src_pos += frame_size;
+			dst_pos += static_cast<size_t>(content_size);
+		}
+	}
+
+	std::atomic<size_t> next_job{0};
+	SaveState_RunWorkers(jobs.size(), SAVESTATE_MAX_WORKERS, [&]() {
+		ZSTD_DCtx* dctx = ZSTD_createDCtx();
+		for (size_t i = next_job.fetch_add(1, std::memory_order_relaxed); i < jobs.size();
+			 i = next_job.fetch_add(1, std::memory_order_relaxed))
+		{
+			ChunkJob& job = jobs[i];
+			if (!dctx)
+				continue;
+
+			const size_t size = ZSTD_decompressDCtx(dctx, job.dst, job.dst_size, job.src, job.src_size);
+			job.success = (size == job.dst_size);
+			job.crc = crc32(0, job.dst, static_cast<uInt>(job.dst_size));
+		}
+
+		ZSTD_freeDCtx(dctx);
+	});
+
+	std::vector<u32> crc(indices.size());
+	std::vector<bool> first(indices.size(), true);
+	for (const ChunkJob& job : jobs)
+	{
+		if (!job.success)
+			return false;
+
+		crc[job.entry] = first[job.entry] ? job.crc : crc32_combine(crc[job.entry], job.crc, static_cast<z_off_t>(job.dst_size));
+		first[job.entry] = false;
+	}
+
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		if (out[i].has_value() && !out[i]->empty() && crc[i] != expected_crc[i])
+			return false;
+	}
+
+	return true;
+}
+
 static bool SaveState_AddToZip(zip_t* zf, ArchiveEntryList* srclist, SaveStateScreenshotData* screenshot)
 {
 	u32 compression = ZIP_CM_DEFAULT;
@@ -999,6 +1439,10 @@ static bool SaveState_AddToZip(zip_t* zf, ArchiveEntryList* srclist, SaveStateSc
 		zip_set_file_compression(zf, fi, ZIP_CM_STORE, 0);
 	}
 
+	std::vector<std::unique_ptr<PrecompressedEntry>> precompressed;
+	if (compression == ZIP_CM_ZSTD && !SaveState_CompressEntries(srclist, static_cast<int>(compression_level), precompressed))
+		return false;
+
 	const uint listlen = srclist->GetLength();
 	for (uint i = 0; i < listlen; ++i)
 	{
@@ -1006,7 +1450,23 @@ static bool SaveState_AddToZip(zip_t* zf, ArchiveEntryList* srclist, SaveStateSc
 		if (!entry.GetDataSize())
 			continue;
 
-		zip_source_t* const zs = zip_source_buffer(zf, srclist->GetPtr(entry.GetDataIndex()), entry.GetDataSize(), 0);
+		zip_source_t* zs;
+		if (!precompressed.empty())
+		{
+			// Ownership passes to the source once it's created.
+			PrecompressedEntry* pe = precompressed[i].get();
+			zip_error_init(&pe->error);
+			zs = zip_source_function(zf, SaveState_PrecompressedSourceCallback, pe);
+			if (zs)
+				precompressed[i].release();
+			else
+				zip_error_fini(&pe->error);
+		}
+		else
+		{
+			zs = zip_source_buffer(zf, srclist->GetPtr(entry.GetDataIndex()), entry.GetDataSize(), 0);
+		}
+
 		if (!zs)
 			return false;
 
@@ -1137,20 +1597,28 @@ static zip_int64_t CheckFileExistsInState(zip_t* zf, const char* name, bool requ
 	return index;
 }
 
-static bool LoadInternalStructuresState(zip_t* zf, s64 index, Error* error)
+static bool LoadInternalStructuresState(zip_t* zf, s64 index, std::optional<std::vector<u8>>& decompressed, Error* error)
 {
-	zip_stat_t zst;
-	if (zip_stat_index(zf, index, 0, &zst) != 0 || zst.size > std::numeric_limits<int>::max())
-		return false;
+	std::vector<u8> buffer;
+	if (decompressed.has_value())
+	{
+		buffer = std::move(decompressed.value());
+	}
+	else
+	{
+		zip_stat_t zst;
+		if (zip_stat_index(zf, index, 0, &zst) != 0 || zst.size > std::numeric_limits<int>::max())
+			return false;
 
-	// Load all the internal data
-	auto zff = zip_fopen_index_managed(zf, index, 0);
-	if (!zff)
-		return false;
+		// Load all the internal data
+		auto zff = zip_fopen_index_managed(zf, index, 0);
+		if (!zff)
+			return false;
 
-	std::vector<u8> buffer(zst.size);
-	if (zip_fread(zff.get(), buffer.data(), buffer.size()) != static_cast<zip_int64_t>(buffer.size()))
-		return false;
+		buffer.resize(zst.size);
+		if (zip_fread(zff.get(), buffer.data(), buffer.size()) != static_cast<zip_int64_t>(buffer.size()))
+			return false;
+	}
 
 	memLoadingState state(buffer);
 	if (!state.FreezeBios())
@@ -1203,9 +1671,21 @@ bool SaveState_UnzipFromDisk(const std::string& filename, Error* error)
 		return false;
 	}
 
+	// Internal structures go last, so the entry indices line up with SavestateEntries.
+	s64 decompress_indices[std::size(SavestateEntries) + 1];
+	std::copy(std::begin(entryIndices), std::end(entryIndices), decompress_indices);
+	decompress_indices[std::size(SavestateEntries)] = internal_index;
+
+	std::vector<std::optional<std::vector<u8>>> decompressed;
+	if (!SaveState_DecompressEntries(zf.get(), decompress_indices, decompressed))
+	{
+		Error::SetString(error, "Failed to decompress save state.");
+		return false;
+	}
+
 	PreLoadPrep();
 
-	if (!LoadInternalStructuresState(zf.get(), internal_index, error))
+	if (!LoadInternalStructuresState(zf.get(), internal_index, decompressed.back(), error))
 	{
 		if (!error->IsValid())
 			Error::SetString(error, "Save state corruption in internal structures.");
@@ -1222,6 +1702,20 @@ bool SaveState_UnzipFromDisk(const std::string& filename, Error* error)
 			continue;
 		}
 
+		if (decompressed[i].has_value())
+		{
+			if (!SavestateEntries[i]->FreezeIn(std::span<const u8>(decompressed[i].value())))
+			{
+				Error::SetString(error, fmt::format("Save state corruption in {}.", SavestateEntries[i]->GetFilename()));
+				VMManager::Reset();
+				return false;
+			}
+
+			// Don't hold onto memory we've already loaded.
+			decompressed[i].reset();
+			continue;
+		}
+
 		auto zff = zip_fopen_index_managed(zf.get(), entryIndices[i], 0);
 		if (!zff || !SavestateEntries[i]->FreezeIn(zff.get()))
 		{
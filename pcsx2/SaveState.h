@@ -6,6 +6,7 @@
 #include <deque>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -60,6 +61,11 @@ extern bool SaveState_ZipToDisk(
 extern bool SaveState_ReadScreenshot(const std::string& filename, u32* out_width, u32* out_height, std::vector<u32>* out_pixels);
 extern bool SaveState_UnzipFromDisk(const std::string& filename, Error* error);
 
+// Uncompressed in-memory states, used for rewind. EE main memory is not included in the buffer,
+// the caller is expected to track it separately (see mmap_CollectDirtyPages()).
+extern bool SaveState_SaveToBuffer(std::vector<u8>& buffer, Error* error);
+extern bool SaveState_LoadFromBuffer(const std::vector<u8>& buffer, std::span<const u8> ee_memory, Error* error);
+
 // --------------------------------------------------------------------------------------
 //  SaveStateBase class
 // --------------------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 #include "Counters.h"
 #include "DEV9/DEV9.h"
 #include "DebugTools/DebugInterface.h"
+#include "DebugTools/SamplingProfiler.h"
 #include "DebugTools/SymbolImporter.h"
 #include "Elfheader.h"
 #include "FW.h"
@@ -29,6 +30,7 @@
 #include "PerformanceMetrics.h"
 #include "R3000A.h"
 #include "R5900.h"
+#include "Rewind.h"
 #include "Recording/InputRecording.h"
 #include "Recording/InputRecordingControls.h"
 #include "SIO/Memcard/MemoryCardFile.h"
@@ -142,6 +144,7 @@ namespace VMManager
 	static void SetHardwareDependentDefaultSettings(SettingsInterface& si);
 	static void EnsureCPUInfoInitialized();
 	static void SetEmuThreadAffinities();
+	static void StopSamplingProfiler();
 
 	static void InitializeDiscordPresence();
 	static void ShutdownDiscordPresence();
@@ -379,6 +382,7 @@ bool VMManager::Internal::CPUThreadInitialize()
 {
 	Threading::SetNameOfCurrentThread("CPU Thread");
 	PerformanceMetrics::SetCPUThread(Threading::ThreadHandle::GetForCallingThread());
+	SamplingProfiler::RegisterCurrentThread("CPU Thread");
 
 	// On Win32, we have a bunch of things which use COM (e.g. SDL, XAudio2, etc).
 	// We need to initialize COM first, before anything else does, because otherwise they might
@@ -445,6 +449,7 @@ void VMManager::Internal::CPUThreadShutdown()
 	WaitForSaveStateFlush();
 
 	PerformanceMetrics::SetCPUThread(Threading::ThreadHandle());
+	SamplingProfiler::UnregisterCurrentThread();
 
 	USBshutdown();
 
@@ -1632,6 +1637,9 @@ VMBootResult VMManager::Initialize(const VMBootParameters& boot_params, Error* e
 
 	SetEmuThreadAffinities();
 
+	if (EmuConfig.Profiler.Enabled)
+		SamplingProfiler::Start();
+
 	// do we want to load state?
 	if (!GSDumpReplayer::IsReplayingDump() && !state_to_load.empty())
 	{
@@ -1675,6 +1683,9 @@ void VMManager::Shutdown(bool save_resume_state)
 	if (g_InputRecording.isActive())
 		g_InputRecording.stop();
 
+	StopSamplingProfiler();
+	Rewind::Reset();
+
 	SaveSessionTime(s_disc_serial);
 	s_elf_override = {};
 	ClearELFInfo();
@@ -1799,6 +1810,7 @@ void VMManager::Reset()
 	SysMemory::Reset();
 	cpuReset();
 	hwReset();
+	Rewind::Reset();
 
 	if (g_InputRecording.isActive())
 	{
@@ -1905,6 +1917,8 @@ bool VMManager::DoLoadState(const char* filename, Error* error)
 		return false;
 
 	Host::OnSaveStateLoaded(filename, true);
+	Rewind::Reset();
+
 	if (g_InputRecording.isActive())
 	{
 		g_InputRecording.handleLoadingSavestate();
@@ -1959,7 +1973,6 @@ void VMManager::DoSaveState(const char* filename, s32 slot_for_message, bool zip
 			std::move(elist), std::move(screenshot), filename, slot_for_message, std::move(error_callback));
 	}
 
-	Host::OnSaveStateSaved(filename);
 	MemcardBusy::CheckSaveStateDependency();
 	return;
 }
@@ -1977,6 +1990,9 @@ void VMManager::ZipSaveState(std::unique_ptr<ArchiveEntryList> elist,
 		return;
 	}
 
+	// Compression may have happened on a background thread, only tell the host once the file exists.
+	Host::OnSaveStateSaved(filename);
+
 	if (slot_for_message >= 0 && VMManager::HasValidVM())
 	{
 		Host::AddIconOSDMessage(fmt::format("SaveStateSlot{}", slot_for_message), ICON_FA_FLOPPY_DISK,
@@ -2926,6 +2942,9 @@ void VMManager::Internal::VSyncOnCPUThread()
 
 	Achievements::FrameUpdate();
 
+	if (EmuConfig.Savestate.RewindEnabled)
+		Rewind::FrameUpdate();
+
 	PollDiscordPresence();
 }
 
@@ -3105,6 +3124,21 @@ void VMManager::CheckForMiscConfigChanges(const Pcsx2Config& old_config)
 			ShutdownDiscordPresence();
 	}
 
+	if (HasValidVM() && EmuConfig.Profiler.Enabled != old_config.Profiler.Enabled)
+	{
+		if (EmuConfig.Profiler.Enabled)
+			SamplingProfiler::Start();
+		else
+			StopSamplingProfiler();
+	}
+
+	if (HasValidVM() && (EmuConfig.Savestate.RewindEnabled != old_config.Savestate.RewindEnabled ||
+							EmuConfig.Savestate.RewindFrequency != old_config.Savestate.RewindFrequency ||
+							EmuConfig.Savestate.RewindBufferSize != old_config.Savestate.RewindBufferSize))
+	{
+		Rewind::Reset();
+	}
+
 	if (HasValidVM() && (EmuConfig.EnableThreadPinning != old_config.EnableThreadPinning ||
 							(s_thread_affinities_set && EmuConfig.Speedhacks.vuThread != old_config.Speedhacks.vuThread)))
 	{
@@ -3767,6 +3801,28 @@ void VMManager::ReloadPINE()
 		PINEServer::Initialize(EmuConfig.PINESlot);
 }
 
+void VMManager::StopSamplingProfiler()
+{
+	if (!SamplingProfiler::IsActive())
+		return;
+
+	SamplingProfiler::Stop();
+
+	std::string base_name;
+	{
+		std::unique_lock lock(s_info_mutex);
+		base_name = Path::SanitizeFileName(s_disc_serial.empty() ? std::string("profile") : fmt::format("profile_{}", s_disc_serial));
+	}
+
+	Error error;
+	const std::string report_path = Path::Combine(EmuFolders::Logs, base_name + ".txt");
+	const std::string folded_path = Path::Combine(EmuFolders::Logs, base_name + ".folded");
+	if (!SamplingProfiler::WriteReport(report_path, 100, &error) || !SamplingProfiler::WriteFoldedStacks(folded_path, &error))
+		Console.Error(fmt::format("Failed to write sampling profile: {}", error.GetDescription()));
+	else
+		Console.WriteLn(fmt::format("Sampling profile written to {}", report_path));
+}
+
 void VMManager::InitializeDiscordPresence()
 {
 	if (s_discord_presence_active)
@@ -1107,6 +1107,13 @@ void vtlb_AddLoadStoreInfo(uptr code_address, u32 code_size, u32 guest_pc, u32 g
 	s_fastmem_backpatch_info.emplace(code_address, info);
 }
 
+void vtlb_RemoveLoadStoreInfo(uptr code_start, uptr code_end)
+{
+	std::erase_if(s_fastmem_backpatch_info, [code_start, code_end](const auto& it) {
+		return (it.first >= code_start && it.first < code_end);
+	});
+}
+
 bool vtlb_BackpatchLoadStore(uptr code_address, uptr fault_address)
 {
 	uptr fastmem_start = (uptr)vtlbdata.fastmem_base;
@@ -1420,6 +1427,14 @@ struct vtlb_PageProtectionInfo
 
 alignas(16) static vtlb_PageProtectionInfo m_PageProtectInfo[Ps2MemSize::TotalRam >> __pageshift];
 
+// Dirty page tracking, used by rewind to find out which pages of main memory changed since
+// the last snapshot. Tracked pages are write protected, the first write to a page marks it
+// dirty and drops the protection again (unless the page also holds recompiled code, in which
+// case the usual block clearing path takes care of it).
+static bool s_dirty_tracking = false;
+static bool s_page_tracked[Ps2MemSize::TotalRam >> __pageshift];
+static bool s_page_dirty[Ps2MemSize::TotalRam >> __pageshift];
+
 
 // returns:
 //  ProtMode_NotRequired - unchecked block (resides in ROM, thus is integrity is constant)
@@ -1490,6 +1505,93 @@ static __fi void mmap_ClearCpuBlock(uint offset)
 	Cpu->Clear(m_PageProtectInfo[rampage].ReverseRamMap, __pagesize);
 }
 
+// Returns true if the fault was only caused by dirty page tracking, and the write can proceed.
+static __fi bool mmap_HandleTrackedPageWrite(uptr offset)
+{
+	const uptr rampage = offset >> __pageshift;
+	if (!s_dirty_tracking || !s_page_tracked[rampage])
+		return false;
+
+	s_page_tracked[rampage] = false;
+	s_page_dirty[rampage] = true;
+
+	// Code pages still need their blocks cleared, which also unprotects the page.
+	if (m_PageProtectInfo[rampage].Mode == ProtMode_Write)
+		return false;
+
+	HostSys::MemProtect(&eeMem->Main[rampage << __pageshift], __pagesize, PageAccess_ReadWrite());
+	vtlb_UpdateFastmemProtection(rampage << __pageshift, __pagesize, PageAccess_ReadWrite());
+	return true;
+}
+
+static void mmap_ProtectTrackedPages(u32 first_page, u32 count)
+{
+	std::fill_n(&s_page_tracked[first_page], count, true);
+	HostSys::MemProtect(&eeMem->Main[first_page << __pageshift], count << __pageshift, PageAccess_ReadOnly());
+	vtlb_UpdateFastmemProtection(first_page << __pageshift, count << __pageshift, PageAccess_ReadOnly());
+}
+
+void mmap_SetDirtyPageTracking(bool enabled)
+{
+	pxAssert(eeMem);
+
+	const u32 num_pages = Ps2MemSize::ExposedRam >> __pageshift;
+	std::memset(s_page_dirty, 0, sizeof(s_page_dirty));
+	s_dirty_tracking = enabled;
+
+	if (enabled)
+	{
+		mmap_ProtectTrackedPages(0, num_pages);
+		return;
+	}
+
+	// Drop protection from everything which isn't protected for the recompiler.
+	for (u32 i = 0; i < num_pages; i++)
+	{
+		if (!s_page_tracked[i])
+			continue;
+
+		s_page_tracked[i] = false;
+		if (m_PageProtectInfo[i].Mode != ProtMode_Write)
+		{
+			HostSys::MemProtect(&eeMem->Main[i << __pageshift], __pagesize, PageAccess_ReadWrite());
+			vtlb_UpdateFastmemProtection(i << __pageshift, __pagesize, PageAccess_ReadWrite());
+		}
+	}
+}
+
+bool mmap_IsDirtyPageTrackingEnabled()
+{
+	return s_dirty_tracking;
+}
+
+void mmap_CollectDirtyPages(std::vector<u32>& pages)
+{
+	pxAssert(eeMem && s_dirty_tracking);
+
+	pages.clear();
+
+	const u32 num_pages = Ps2MemSize::ExposedRam >> __pageshift;
+	for (u32 i = 0; i < num_pages;)
+	{
+		if (!s_page_dirty[i])
+		{
+			i++;
+			continue;
+		}
+
+		// Re-protect contiguous runs in one go, games tend to dirty large linear regions.
+		const u32 first = i;
+		for (; i < num_pages && s_page_dirty[i]; i++)
+		{
+			s_page_dirty[i] = false;
+			pages.push_back(i);
+		}
+
+		mmap_ProtectTrackedPages(first, i - first);
+	}
+}
+
 PageFaultHandler::HandlerResult PageFaultHandler::HandlePageFault(void* exception_pc, void* fault_address, bool is_write)
 {
 	pxAssert(eeMem);
@@ -1502,6 +1604,9 @@ PageFaultHandler::HandlerResult PageFaultHandler::HandlePageFault(void* exceptio
 
 		uptr ptr = (uptr)PSM(vaddr);
 		uptr offset = (ptr - (uptr)eeMem->Main);
+		if (ptr && offset < Ps2MemSize::ExposedRam && mmap_HandleTrackedPageWrite(offset))
+			return HandlerResult::ContinueExecution;
+
 		if (ptr && m_PageProtectInfo[offset >> __pageshift].Mode == ProtMode_Write)
 		{
 			// fprintf(stderr, "Not backpatching code write at %08X\n", vaddr);
@@ -1524,6 +1629,9 @@ PageFaultHandler::HandlerResult PageFaultHandler::HandlePageFault(void* exceptio
 		if (offset >= Ps2MemSize::ExposedRam)
 			return HandlerResult::ExecuteNextHandler;
 
+		if (mmap_HandleTrackedPageWrite(offset))
+			return HandlerResult::ContinueExecution;
+
 		mmap_ClearCpuBlock(offset);
 		return HandlerResult::ContinueExecution;
 	}
@@ -1540,4 +1648,11 @@ void mmap_ResetBlockTracking()
 	if (eeMem)
 		HostSys::MemProtect(eeMem->Main, Ps2MemSize::ExposedRam, PageAccess_ReadWrite());
 	vtlb_UpdateFastmemProtection(0, Ps2MemSize::ExposedRam, PageAccess_ReadWrite());
+
+	// Protection was just dropped from every page, so we can no longer tell what changed.
+	if (s_dirty_tracking)
+	{
+		std::memset(s_page_tracked, 0, sizeof(s_page_tracked));
+		std::memset(s_page_dirty, 1, Ps2MemSize::ExposedRam >> __pageshift);
+	}
 }
@@ -8,6 +8,8 @@
 #include "common/HostSys.h"
 #include "common/SingleRegisterTypes.h"
 
+#include <vector>
+
 static const uptr VTLB_AllocUpperBounds = _1gb * 2;
 
 // Specialized function pointers for each read type
@@ -77,6 +79,7 @@ extern void vtlb_UpdateFastmemProtection(u32 paddr, u32 size, PageProtectionMode
 extern bool vtlb_BackpatchLoadStore(uptr code_address, uptr fault_address);
 
 extern void vtlb_ClearLoadStoreInfo();
+extern void vtlb_RemoveLoadStoreInfo(uptr code_start, uptr code_end);
 extern void vtlb_AddLoadStoreInfo(uptr code_address, u32 code_size, u32 guest_pc, u32 gpr_bitmask, u32 fpr_bitmask, u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr);
 extern void vtlb_DynBackpatchLoadStore(uptr code_address, u32 code_size, u32 guest_pc, u32 guest_addr, u32 gpr_bitmask, u32 fpr_bitmask, u8 address_register, u8 data_register, u8 size_in_bits, bool is_signed, bool is_load, bool is_fpr);
 extern bool vtlb_IsFaultingPC(u32 guest_pc);
@@ -232,6 +235,12 @@ extern vtlb_ProtectionMode mmap_GetRamPageInfo(u32 paddr);
 extern void mmap_MarkCountedRamPage(u32 paddr);
 extern void mmap_ResetBlockTracking();
 
+// Dirty page tracking for main memory. Enabling (or re-enabling) tracking marks every page clean.
+extern void mmap_SetDirtyPageTracking(bool enabled);
+extern bool mmap_IsDirtyPageTrackingEnabled();
+// Returns the indices of pages written since the last call, and starts tracking them again.
+extern void mmap_CollectDirtyPages(std::vector<u32>& pages);
+
 // --------------------------------------------------------------------------------------
 //  Goemon game fix
 // --------------------------------------------------------------------------------------
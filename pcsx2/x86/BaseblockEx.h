@@ -217,6 +217,35 @@ public:
 		blocks.erase(first, last + 1);
 	}
 
+	/// Removes every block whose code starts within [code_start, code_end), so the space can be reused.
+	/// Jumps into the evicted blocks are sent back to the recompiler, and links from the evicted code are
+	/// forgotten, since the memory they point to is about to be overwritten. Calls evicted(block) for each.
+	template <typename T>
+	void EvictCode(uptr code_start, uptr code_end, const T& evicted)
+	{
+		u32 kept = 0;
+		for (u32 idx = 0; idx < blocks.size(); idx++)
+		{
+			const BASEBLOCKEX& block = blocks[idx];
+			if (block.fnptr >= code_start && block.fnptr < code_end)
+			{
+				std::pair<linkiter_t, linkiter_t> range = links.equal_range(block.startpc);
+				for (linkiter_t i = range.first; i != range.second; ++i)
+					*(u32*)i->second = recompiler - (i->second + 4);
+
+				evicted(block);
+				continue;
+			}
+
+			if (kept != idx)
+				blocks[kept] = block;
+			kept++;
+		}
+
+		blocks.erase(kept, blocks.size());
+		std::erase_if(links, [code_start, code_end](const auto& it) { return (it.second >= code_start && it.second < code_end); });
+	}
+
 	void Link(u32 pc, s32* jumpptr);
 
 	__fi void Reset()
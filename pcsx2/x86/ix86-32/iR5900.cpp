@@ -19,8 +19,11 @@
 
 #include "common/AlignedMalloc.h"
 #include "common/FastJmp.h"
+#include "common/FileSystem.h"
 #include "common/HeapArray.h"
+#include "common/Path.h"
 #include "common/Perf.h"
+#include "common/Timer.h"
 
 // Only for MOVQ workaround.
 #include "common/emitter/internal.h"
@@ -38,6 +41,12 @@
 #include <zlib.h>
 #endif
 
+#define XXH_STATIC_LINKING_ONLY 1
+#define XXH_INLINE_ALL 1
+#include "xxhash.h"
+
+#include <unordered_map>
+
 using namespace x86Emitter;
 using namespace R5900;
 
@@ -82,8 +91,20 @@ static BASEBLOCK* recROM1 = nullptr; // also here
 static BASEBLOCK* recROM2 = nullptr; // also here
 
 static BaseBlocks recBlocks;
+
+// Block code is allocated from a ring. When the write pointer catches up with older code, the oldest
+// region is evicted (unlinking its blocks) rather than resetting the whole cache, so code which is
+// still hot only needs to be recompiled as it's hit again. Backpatch thunks live in their own area
+// at the end, since they have to outlive the region they were allocated in.
+static constexpr u32 EVICTION_REGION_SIZE = _1mb * 4;
+static constexpr u32 MAX_BLOCK_CODE_SIZE = _64kb;
+static constexpr u32 THUNK_AREA_SIZE = _1mb * 2;
+
 static u8* recPtr = nullptr;
 static u8* recPtrEnd = nullptr;
+static u8* recCodeStart = nullptr; // first byte after the dispatchers
+static u8* recEvictPtr = nullptr; // end of the free space after recPtr
+static u8* recThunkPtr = nullptr;
 EEINST* s_pInstCache = nullptr;
 static u32 s_nInstCacheSize = 0;
 
@@ -588,7 +609,7 @@ static void recReserveRAM()
 static void recReserve()
 {
 	recPtr = SysMemory::GetEERec();
-	recPtrEnd = SysMemory::GetEERecEnd() - _64kb;
+	recPtrEnd = SysMemory::GetEERecEnd() - THUNK_AREA_SIZE;
 	recReserveRAM();
 
 	pxAssertRel(!s_pInstCache, "InstCache not allocated");
@@ -602,10 +623,171 @@ alignas(16) static u16 manual_page[Ps2MemSize::TotalRam >> 12];
 alignas(16) static u8 manual_counter[Ps2MemSize::TotalRam >> 12];
 
 ////////////////////////////////////////////////////
+// Block profile, blocks compiled by a game are remembered per game, and compiled ahead of time
+// when it next reaches its entry point, instead of stuttering through them as they're first hit.
+
+namespace
+{
+	struct BlockProfileHeader
+	{
+		static constexpr u32 MAGIC = 0x50424545; // EEBP
+		static constexpr u32 VERSION = 1;
+
+		u32 magic;
+		u32 version;
+		u32 num_blocks;
+	};
+
+	struct BlockProfileEntry
+	{
+		u32 size; // in instructions
+		u64 hash; // of the guest code when it was compiled
+	};
+
+	struct BlockProfile
+	{
+		std::string serial;
+		u32 crc = 0;
+		std::unordered_map<u32, BlockProfileEntry> blocks;
+		bool dirty = false;
+	};
+} // namespace
+
+static BlockProfile s_block_profile;
+
+// Anything below is the kernel and EELOAD, which aren't worth keeping per game.
+static constexpr u32 BLOCK_PROFILE_START = 0x100000;
+
+// Leave the other half of the code buffer for blocks which weren't in the profile.
+static constexpr u32 BLOCK_PROFILE_MAX_CODE_FRACTION = 2;
+
+static std::string recGetBlockProfilePath(const BlockProfile& profile)
+{
+	return Path::Combine(EmuFolders::Cache,
+		fmt::format("ee_blocks_{}_{:08X}.bin", Path::SanitizeFileName(profile.serial), profile.crc));
+}
+
+static bool recIsBlockProfileRange(u32 startpc, u32 size)
+{
+	return (HWADDR(startpc) >= BLOCK_PROFILE_START && (HWADDR(startpc) + size * 4) <= Ps2MemSize::ExposedRam);
+}
+
+static void recSaveBlockProfile()
+{
+	if (!s_block_profile.dirty)
+		return;
+
+	s_block_profile.dirty = false;
+
+	std::vector<u8> data(sizeof(BlockProfileHeader) + s_block_profile.blocks.size() * (sizeof(u32) * 2 + sizeof(u64)));
+	u8* ptr = data.data();
+	const auto write = [&ptr](const void* src, size_t size) {
+		std::memcpy(ptr, src, size);
+		ptr += size;
+	};
+
+	const BlockProfileHeader header = {BlockProfileHeader::MAGIC, BlockProfileHeader::VERSION,
+		static_cast<u32>(s_block_profile.blocks.size())};
+	write(&header, sizeof(header));
+	for (const auto& [startpc, entry] : s_block_profile.blocks)
+	{
+		write(&startpc, sizeof(startpc));
+		write(&entry.size, sizeof(entry.size));
+		write(&entry.hash, sizeof(entry.hash));
+	}
+
+	const std::string path = recGetBlockProfilePath(s_block_profile);
+	if (!FileSystem::WriteBinaryFile(path.c_str(), data.data(), data.size()))
+		Console.Error("(EE) Failed to write block profile to '%s'.", path.c_str());
+}
+
+static void recRecordBlockProfile(u32 startpc, u32 size)
+{
+	if (s_block_profile.crc == 0 || !recIsBlockProfileRange(startpc, size))
+		return;
+
+	const u64 hash = XXH3_64bits(PSM(startpc), size * 4);
+	BlockProfileEntry& entry = s_block_profile.blocks[startpc];
+	if (entry.size != size || entry.hash != hash)
+	{
+		entry = {size, hash};
+		s_block_profile.dirty = true;
+	}
+}
+
+static void recLoadBlockProfile(u32 entry_pc)
+{
+	std::string serial = VMManager::GetDiscSerial();
+	const u32 crc = VMManager::GetCurrentCRC();
+	if (crc == 0 || (s_block_profile.crc == crc && s_block_profile.serial == serial))
+		return;
+
+	recSaveBlockProfile();
+	s_block_profile = {};
+	s_block_profile.serial = std::move(serial);
+	s_block_profile.crc = crc;
+
+	const std::string path = recGetBlockProfilePath(s_block_profile);
+	std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(path.c_str());
+	if (!data.has_value())
+		return;
+
+	BlockProfileHeader header = {};
+	if (data->size() >= sizeof(header))
+		std::memcpy(&header, data->data(), sizeof(header));
+	if (header.magic != BlockProfileHeader::MAGIC || header.version != BlockProfileHeader::VERSION ||
+		data->size() != (sizeof(header) + header.num_blocks * (sizeof(u32) * 2 + sizeof(u64))))
+	{
+		Console.Warning("(EE) Ignoring invalid block profile '%s'.", path.c_str());
+		return;
+	}
+
+	std::vector<std::pair<u32, BlockProfileEntry>> blocks(header.num_blocks);
+	const u8* ptr = data->data() + sizeof(header);
+	for (auto& [startpc, entry] : blocks)
+	{
+		std::memcpy(&startpc, ptr, sizeof(startpc));
+		std::memcpy(&entry.size, ptr + sizeof(u32), sizeof(entry.size));
+		std::memcpy(&entry.hash, ptr + sizeof(u32) * 2, sizeof(entry.hash));
+		ptr += sizeof(u32) * 2 + sizeof(u64);
+	}
+
+	// Compile in address order, so neighbouring blocks end up next to each other.
+	std::sort(blocks.begin(), blocks.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+	Common::Timer timer;
+	const size_t code_limit = static_cast<size_t>(recPtrEnd - recCodeStart) / BLOCK_PROFILE_MAX_CODE_FRACTION;
+	size_t code_used = 0;
+	u32 compiled = 0;
+	for (const auto& [startpc, entry] : blocks)
+	{
+		s_block_profile.blocks.emplace(startpc, entry);
+
+		// Skip anything which has been overwritten since, and the entry point, which our caller is compiling.
+		if (code_used >= code_limit || startpc == entry_pc || entry.size == 0 || !recIsBlockProfileRange(startpc, entry.size) ||
+			PC_GETBLOCK(startpc)->GetFnptr() != reinterpret_cast<uptr>(JITCompile) ||
+			XXH3_64bits(PSM(startpc), entry.size * 4) != entry.hash)
+		{
+			continue;
+		}
+
+		recRecompile(startpc);
+		code_used += s_pCurBlockEx->x86size;
+		compiled++;
+	}
+
+	Console.WriteLn("(EE) Compiled %u of %zu profiled blocks in %.2f ms.", compiled, blocks.size(), timer.GetTimeMilliseconds());
+}
+
 static void recResetRaw()
 {
 	Console.WriteLn(Color_StrongBlack, "EE/iR5900 Recompiler Reset");
 
+	// Profile is kept across resets while the same game is running, otherwise it's done.
+	recSaveBlockProfile();
+	if (s_block_profile.crc != VMManager::GetCurrentCRC() || s_block_profile.serial != VMManager::GetDiscSerial())
+		s_block_profile = {};
+
 	if (CHECK_EXTRAMEM != extraRam)
 	{
 		recReserveRAM();
@@ -619,6 +801,9 @@ static void recResetRaw()
 	_DynGen_Dispatchers();
 	vtlb_DynGenDispatchers();
 	recPtr = xGetPtr();
+	recCodeStart = recPtr;
+	recEvictPtr = recPtrEnd;
+	recThunkPtr = recPtrEnd;
 
 	ClearRecLUT(recLutReserve_RAM.data(),
 		Ps2MemSize::ExposedRam + Ps2MemSize::Rom + Ps2MemSize::Rom1 + Ps2MemSize::Rom2);
@@ -645,6 +830,9 @@ static void recResetRaw()
 
 void recShutdown()
 {
+	recSaveBlockProfile();
+	s_block_profile = {};
+
 	recRAMCopy.deallocate();
 	recLutReserve_RAM.deallocate();
 
@@ -657,6 +845,9 @@ void recShutdown()
 
 	recPtr = nullptr;
 	recPtrEnd = nullptr;
+	recCodeStart = nullptr;
+	recEvictPtr = nullptr;
+	recThunkPtr = nullptr;
 }
 
 void recStep()
@@ -877,16 +1068,17 @@ void SetBranchImm(u32 imm)
 
 u8* recBeginThunk()
 {
-	// if recPtr reached the mem limit reset whole mem
-	if (recPtr >= recPtrEnd)
+	// Thunks are created from the fault handler, so we can't evict here.
+	// If the thunk area is full, reset whole mem on the next compile.
+	if (recThunkPtr >= SysMemory::GetEERecEnd() - _64kb)
 		eeRecNeedsReset = true;
 
 	xSetTextPtr(R5900_TEXTPTR);
-	xSetPtr(recPtr);
-	recPtr = xGetAlignedCallTarget();
+	xSetPtr(recThunkPtr);
+	recThunkPtr = xGetAlignedCallTarget();
 
-	x86Ptr = recPtr;
-	return recPtr;
+	x86Ptr = recThunkPtr;
+	return recThunkPtr;
 }
 
 u8* recEndThunk()
@@ -894,10 +1086,44 @@ u8* recEndThunk()
 	u8* block_end = x86Ptr;
 
 	pxAssert(block_end < SysMemory::GetEERecEnd());
-	recPtr = block_end;
+	recThunkPtr = block_end;
 	return block_end;
 }
 
+static void recEvictCode(u8* start, u8* end)
+{
+	u32 count = 0;
+	recBlocks.EvictCode(reinterpret_cast<uptr>(start), reinterpret_cast<uptr>(end), [&count](const BASEBLOCKEX& block) {
+		// Only reset the lookup if it still points at this block, recClear() may have already done so.
+		BASEBLOCK* pblock = PC_GETBLOCK(block.startpc);
+		if (pblock->GetFnptr() == block.fnptr)
+			pblock->SetFnptr((uptr)JITCompile);
+		count++;
+	});
+
+	vtlb_RemoveLoadStoreInfo(reinterpret_cast<uptr>(start), reinterpret_cast<uptr>(end));
+
+	DevCon.WriteLn("(EE) Evicted %u blocks from %p-%p", count, start, end);
+}
+
+// Makes sure there's enough room after recPtr for the largest block, evicting the oldest code if needed.
+static void recMakeCodeSpace()
+{
+	while (static_cast<size_t>(recEvictPtr - recPtr) < MAX_BLOCK_CODE_SIZE)
+	{
+		// Everything after us has been evicted, so wrap around to the oldest code.
+		if (recEvictPtr == recPtrEnd)
+		{
+			recPtr = recCodeStart;
+			recEvictPtr = recCodeStart;
+		}
+
+		u8* const evict_end = std::min(recEvictPtr + EVICTION_REGION_SIZE, recPtrEnd);
+		recEvictCode(recEvictPtr, evict_end);
+		recEvictPtr = evict_end;
+	}
+}
+
 bool TrySwapDelaySlot(u32 rs, u32 rt, u32 rd, bool allow_loadstore)
 {
 #if 1
@@ -2163,11 +2389,8 @@ static void recRecompile(const u32 startpc)
 
 	pxAssert(startpc);
 
-	// if recPtr reached the mem limit reset whole mem
-	if (recPtr >= recPtrEnd)
-		eeRecNeedsReset = true;
-
-	if (HWADDR(startpc) == VMManager::Internal::GetCurrentELFEntryPoint())
+	const bool is_entry_point = (HWADDR(startpc) == VMManager::Internal::GetCurrentELFEntryPoint());
+	if (is_entry_point)
 		VMManager::Internal::EntryPointCompilingOnCPUThread();
 
 	if (eeRecNeedsReset)
@@ -2176,6 +2399,11 @@ static void recRecompile(const u32 startpc)
 		recResetRaw();
 	}
 
+	if (is_entry_point && EmuConfig.Cpu.Recompiler.EnableEEBlockProfile)
+		recLoadBlockProfile(startpc);
+
+	recMakeCodeSpace();
+
 	xSetTextPtr(R5900_TEXTPTR);
 	xSetPtr(recPtr);
 	recPtr = xGetAlignedCallTarget();
@@ -2632,6 +2860,7 @@ StartRecomp:
 
 	pxAssert((pc - startpc) >> 2 <= 0xffff);
 	s_pCurBlockEx->size = (pc - startpc) >> 2;
+	recRecordBlockProfile(startpc, s_pCurBlockEx->size);
 
 	if (HWADDR(pc) <= Ps2MemSize::ExposedRam)
 	{
@@ -2705,7 +2934,7 @@ StartRecomp:
 		}
 	}
 
-	pxAssert(xGetPtr() < SysMemory::GetEERecEnd());
+	pxAssert(xGetPtr() <= recEvictPtr);
 
 	s_pCurBlockEx->x86size = static_cast<u32>(xGetPtr() - recPtr);
 
@@ -2,15 +2,27 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "microVU.h"
+#include "VMManager.h"
 
 #include "common/AlignedMalloc.h"
+#include "common/FileSystem.h"
+#include "common/Path.h"
 #include "common/Perf.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
+
+#define XXH_STATIC_LINKING_ONLY 1
+#define XXH_INLINE_ALL 1
+#include "xxhash.h"
+
+#include <bit>
 
 //------------------------------------------------------------------
 // Micro VU - Main Functions
 //------------------------------------------------------------------
 
+static void mVUsaveProfile(microVU& mVU);
+
 // Only run this once per VU! ;)
 void mVUinit(microVU& mVU, uint vuIndex)
 {
@@ -54,6 +66,21 @@ void mVUreset(microVU& mVU, bool resetReserve)
 	memset(&mVU.prog.lpState, 0, sizeof(mVU.prog.lpState));
 	mVU.profiler.Reset(mVU.index);
 
+	// Program Index
+	mVUprintSearchStats(mVU);
+	mVU.progIndex.progs.clear();
+	mVUmarkBlocksDirty(mVU, 0, mVU.microMemSize);
+
+	// Profile is kept across resets while the same game is running, otherwise it's done
+	mVUsaveProfile(mVU);
+	if (!EmuConfig.Cpu.Recompiler.EnableVUProgramProfile || mVU.progProfile.crc != VMManager::GetCurrentCRC() ||
+		mVU.progProfile.serial != VMManager::GetDiscSerial())
+	{
+		mVU.progProfile = {};
+	}
+	mVU.progProfile.pending.clear();
+	mVU.progProfile.pendingProg = nullptr;
+
 	// Program Variables
 	mVU.prog.cleared  =  1;
 	mVU.prog.isSame   = -1;
@@ -85,6 +112,11 @@ void mVUreset(microVU& mVU, bool resetReserve)
 // Free Allocated Resources
 void mVUclose(microVU& mVU)
 {
+	mVUprintSearchStats(mVU);
+	mVU.progIndex.progs.clear();
+	mVUsaveProfile(mVU);
+	mVU.progProfile = {};
+
 	// Delete Programs and Block Managers
 	for (u32 i = 0; i < (mVU.progSize / 2); i++)
 	{
@@ -101,6 +133,8 @@ void mVUclose(microVU& mVU)
 // Clears Block Data in specified range
 __fi void mVUclear(mV, u32 addr, u32 size)
 {
+	mVUmarkBlocksDirty(mVU, addr, size);
+
 	if (!mVU.prog.cleared)
 	{
 		mVU.prog.cleared = 1; // Next execution searches/creates a new microprogram
@@ -212,6 +246,246 @@ void mVUprintUniqueRatio(microVU& mVU)
 	DevCon.WriteLn("%d / %d [%3.1f%%]", v.size(), total, 100. - (double)v.size() / (double)total * 100.);
 }
 
+// Flags blocks of micro memory for rehashing, called before the memory is written
+__fi void mVUmarkBlocksDirty(microVU& mVU, u32 addr, u32 size)
+{
+	if (!size || addr >= mVU.microMemSize)
+		return;
+
+	const u32 first = addr / microProgIndex::BlockSize;
+	const u32 last  = (std::min(addr + size, mVU.microMemSize) - 1) / microProgIndex::BlockSize;
+	for (u32 i = first; i <= last; i++)
+		mVU.progIndex.dirty[i / 64] |= 1ULL << (i % 64);
+}
+
+// Rehashes dirty blocks, and returns the index key for the current micro memory and start PC
+__fi u64 mVUgetProgKey(microVU& mVU, u32 startPC)
+{
+	microProgIndex& index = mVU.progIndex;
+	const u32 numWords = std::max(mVU.microMemSize / microProgIndex::BlockSize / 64, 1u);
+	for (u32 word = 0; word < numWords; word++)
+	{
+		for (u64 bits = index.dirty[word]; bits != 0; bits &= bits - 1)
+		{
+			const u32 block = word * 64 + std::countr_zero(bits);
+			const u64 hash = XXH3_64bits_withSeed(mVU.regs().Micro + block * microProgIndex::BlockSize,
+				microProgIndex::BlockSize, block);
+			index.memHash ^= index.blockHash[block] ^ hash;
+			index.blockHash[block] = hash;
+		}
+		index.dirty[word] = 0;
+	}
+
+	return index.memHash ^ (static_cast<u64>(startPC) * 0x9E3779B97F4A7C15ULL);
+}
+
+__fi void mVUaddToIndex(microVU& mVU, u64 key, microProgram* prog)
+{
+	if (mVU.progIndex.progs.size() >= microProgIndex::MaxEntries)
+		mVU.progIndex.progs.clear();
+	mVU.progIndex.progs[key] = prog;
+}
+
+void mVUprintSearchStats(microVU& mVU)
+{
+	microProgIndex& index = mVU.progIndex;
+	if (index.searches)
+	{
+		DevCon.WriteLn(mVU.index ? Color_Orange : Color_Magenta,
+			"microVU%d: Program searches = %llu [Quick=%llu] [Index=%llu] [List=%llu] [Miss=%llu]",
+			mVU.index, index.searches, index.quickHits, index.indexHits, index.listHits, index.misses);
+	}
+	index.searches = index.quickHits = index.indexHits = index.listHits = index.misses = 0;
+}
+
+//------------------------------------------------------------------
+// Micro VU - Program Profile
+//------------------------------------------------------------------
+
+namespace
+{
+	struct ProgProfileHeader
+	{
+		static constexpr u32 MAGIC = 0x50505556; // VUPP
+		static constexpr u32 VERSION = 1;
+
+		u32 magic;
+		u32 version;
+		u32 num_blocks;
+	};
+} // namespace
+
+static constexpr size_t PROG_PROFILE_ENTRY_SIZE = sizeof(u64) + sizeof(u32) + sizeof(microRegInfo);
+
+// Leave the other half of the program cache for blocks which weren't in the profile
+static constexpr u32 PROG_PROFILE_MAX_CODE_FRACTION = 2;
+
+// Profiled blocks compiled per program search, so a new program doesn't have to wait for all of them
+static constexpr u32 PROG_PROFILE_BLOCKS_PER_SEARCH = 8;
+
+static std::string mVUgetProfilePath(microVU& mVU)
+{
+	return Path::Combine(EmuFolders::Cache, fmt::format("vu{}_progs_{}_{:08X}.bin", mVU.index,
+		Path::SanitizeFileName(mVU.progProfile.serial), mVU.progProfile.crc));
+}
+
+static void mVUsaveProfile(microVU& mVU)
+{
+	microProgProfile& profile = mVU.progProfile;
+	if (!profile.dirty)
+		return;
+
+	profile.dirty = false;
+
+	u32 num_blocks = 0;
+	for (const auto& it : profile.progs)
+		num_blocks += static_cast<u32>(it.second.size());
+
+	std::vector<u8> data(sizeof(ProgProfileHeader) + num_blocks * PROG_PROFILE_ENTRY_SIZE);
+	u8* ptr = data.data();
+	const auto write = [&ptr](const void* src, size_t size) {
+		std::memcpy(ptr, src, size);
+		ptr += size;
+	};
+
+	const ProgProfileHeader header = {ProgProfileHeader::MAGIC, ProgProfileHeader::VERSION, num_blocks};
+	write(&header, sizeof(header));
+	for (const auto& [key, blocks] : profile.progs)
+	{
+		for (const auto& it : blocks)
+		{
+			write(&key, sizeof(key));
+			write(&it.second.startPC, sizeof(it.second.startPC));
+			write(&it.second.state, sizeof(it.second.state));
+		}
+	}
+
+	const std::string path = mVUgetProfilePath(mVU);
+	if (!FileSystem::WriteBinaryFile(path.c_str(), data.data(), data.size()))
+		Console.Error("microVU%d: Failed to write program profile to '%s'.", mVU.index, path.c_str());
+}
+
+// Makes sure the profile belongs to the running game, returns false if there's no profile to use
+static bool mVUupdateProfile(microVU& mVU)
+{
+	microProgProfile& profile = mVU.progProfile;
+	const u32 crc = VMManager::GetCurrentCRC();
+	if (!EmuConfig.Cpu.Recompiler.EnableVUProgramProfile || crc == 0)
+		return false;
+	if (profile.crc == crc)
+		return true;
+
+	mVUsaveProfile(mVU);
+	profile = {};
+	profile.serial = VMManager::GetDiscSerial();
+	profile.crc = crc;
+
+	const std::string path = mVUgetProfilePath(mVU);
+	std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(path.c_str());
+	if (!data.has_value())
+		return true;
+
+	ProgProfileHeader header = {};
+	if (data->size() >= sizeof(header))
+		std::memcpy(&header, data->data(), sizeof(header));
+	if (header.magic != ProgProfileHeader::MAGIC || header.version != ProgProfileHeader::VERSION ||
+		data->size() != (sizeof(header) + header.num_blocks * PROG_PROFILE_ENTRY_SIZE))
+	{
+		Console.Warning("microVU%d: Ignoring invalid program profile '%s'.", mVU.index, path.c_str());
+		return true;
+	}
+
+	const u8* ptr = data->data() + sizeof(header);
+	for (u32 i = 0; i < header.num_blocks; i++, ptr += PROG_PROFILE_ENTRY_SIZE)
+	{
+		u64 key;
+		microProgProfile::Block block;
+		std::memcpy(&key, ptr, sizeof(key));
+		std::memcpy(&block.startPC, ptr + sizeof(u64), sizeof(block.startPC));
+		std::memcpy(&block.state, ptr + sizeof(u64) + sizeof(u32), sizeof(block.state));
+		if ((block.startPC & 7) || block.startPC >= mVU.microMemSize)
+			continue;
+
+		const u64 block_key = XXH3_64bits_withSeed(&block.state, sizeof(block.state), block.startPC);
+		profile.progs[key].emplace(block_key, block);
+	}
+
+	DevCon.WriteLn(mVU.index ? Color_Orange : Color_Magenta, "microVU%d: Loaded %u profiled blocks for %zu programs.",
+		mVU.index, header.num_blocks, profile.progs.size());
+	return true;
+}
+
+// Called before a block is compiled for the current program
+void mVUrecordProfileBlock(microVU& mVU, u32 startPC, uptr pState)
+{
+	microProgProfile& profile = mVU.progProfile;
+	if (profile.crc == 0 || !mVU.prog.cur)
+		return;
+
+	const microRegInfo& state = *reinterpret_cast<const microRegInfo*>(pState);
+	const u64 block_key = XXH3_64bits_withSeed(&state, sizeof(state), startPC);
+	if (profile.progs[mVU.prog.cur->key].try_emplace(block_key, microProgProfile::Block{startPC, state}).second)
+		profile.dirty = true;
+}
+
+// Queues the blocks a new program compiled in previous sessions, for mVUprecompileProfile()
+static void mVUqueueProfile(microVU& mVU, u64 key)
+{
+	microProgProfile& profile = mVU.progProfile;
+	profile.pending.clear();
+	profile.pendingProg = nullptr;
+
+	const auto it = profile.progs.find(key);
+	if (it == profile.progs.end())
+		return;
+
+	// Compiling records new blocks in the profile, so work from a copy.
+	// Compile in address order, so neighbouring blocks end up next to each other. Blocks are taken from the back.
+	profile.pending.reserve(it->second.size());
+	for (const auto& block : it->second)
+		profile.pending.push_back(block.second);
+	std::sort(profile.pending.begin(), profile.pending.end(), [](const auto& lhs, const auto& rhs) { return lhs.startPC > rhs.startPC; });
+
+	profile.pendingProg = mVU.prog.cur;
+	profile.pendingTotal = static_cast<u32>(profile.pending.size());
+	profile.pendingCompiled = 0;
+}
+
+// Compiles a few of the queued profiled blocks while their program is the current one
+static void mVUprecompileProfile(microVU& mVU)
+{
+	microProgProfile& profile = mVU.progProfile;
+	if (profile.pending.empty() || profile.pendingProg != mVU.prog.cur)
+		return;
+
+	// Compiling overwrites the pipeline state the program starts from
+	const microRegInfo lpState = mVU.prog.lpState;
+	const u8* const code_limit = mVU.prog.x86start + (mVU.prog.x86end - mVU.prog.x86start) / PROG_PROFILE_MAX_CODE_FRACTION;
+
+	for (u32 i = 0; i < PROG_PROFILE_BLOCKS_PER_SEARCH && !profile.pending.empty(); i++)
+	{
+		const u8* const ptr = xGetPtr();
+		if (ptr >= code_limit)
+		{
+			profile.pending.clear();
+			break;
+		}
+
+		const microProgProfile::Block block = profile.pending.back();
+		profile.pending.pop_back();
+		mVUblockFetch(mVU, block.startPC, reinterpret_cast<uptr>(&block.state));
+		profile.pendingCompiled += (xGetPtr() != ptr);
+	}
+
+	mVU.prog.lpState = lpState;
+	if (profile.pending.empty())
+	{
+		DevCon.WriteLn(mVU.index ? Color_Orange : Color_Magenta, "microVU%d: Compiled %u of %u profiled blocks for program %d.",
+			mVU.index, profile.pendingCompiled, profile.pendingTotal, mVU.prog.cur->idx);
+		profile.pendingProg = nullptr;
+	}
+}
+
 // Compare Cached microProgram to mVU.regs().Micro
 __fi bool mVUcmpProg(microVU& mVU, microProgram& prog)
 {
@@ -249,32 +523,62 @@ _mVUt __fi void* mVUsearchProg(u32 startPC, uptr pState)
 
 	if (!quick.prog) // If null, we need to search for new program
 	{
-		for (auto it = list->begin(); it != list->end(); ++it)
-		{
-			bool b = mVUcmpProg(mVU, *it[0]);
+		mVU.progIndex.searches++;
 
-			if (b)
+		// Programs which were seen with exactly this micro memory before can be found directly
+		const u64 key = mVUgetProgKey(mVU, mVU.regs().start_pc / 8);
+		microProgram* found = nullptr;
+		auto indexed = mVU.progIndex.progs.find(key);
+		if (indexed != mVU.progIndex.progs.end() && mVUcmpProg(mVU, *indexed->second))
+		{
+			found = indexed->second;
+			mVU.progIndex.indexHits++;
+		}
+		else
+		{
+			for (auto it = list->begin(); it != list->end(); ++it)
 			{
-				quick.block = it[0]->block[startPC / 8];
-				quick.prog  = it[0];
-				list->erase(it);
-				list->push_front(quick.prog);
-
-				// Sanity check, in case for some reason the program compilation aborted half way through (JALR for example)
-				if (quick.block == nullptr)
+				if (mVUcmpProg(mVU, *it[0]))
 				{
-					void* entryPoint = mVUblockFetch(mVU, startPC, pState);
-					return entryPoint;
+					found = it[0];
+					list->erase(it);
+					list->push_front(found);
+					mVUaddToIndex(mVU, key, found);
+					mVU.progIndex.listHits++;
+					break;
 				}
-				return mVUentryGet(mVU, quick.block, startPC, pState);
 			}
 		}
 
+		if (found)
+		{
+			mVUprecompileProfile(mVU);
+			quick.block = found->block[startPC / 8];
+			quick.prog  = found;
+
+			// Sanity check, in case for some reason the program compilation aborted half way through (JALR for example)
+			if (quick.block == nullptr)
+			{
+				void* entryPoint = mVUblockFetch(mVU, startPC, pState);
+				return entryPoint;
+			}
+			return mVUentryGet(mVU, quick.block, startPC, pState);
+		}
+
 		// If cleared and program not found, make a new program instance
+		mVU.progIndex.misses++;
 		mVU.prog.cleared = 0;
 		mVU.prog.isSame  = 1;
 		mVU.prog.cur     = mVUcreateProg(mVU, mVU.regs().start_pc/8);
+		mVU.prog.cur->key = key;
+		mVUaddToIndex(mVU, key, mVU.prog.cur);
+		const bool profiled = mVUupdateProfile(mVU);
 		void* entryPoint = mVUblockFetch(mVU,  startPC, pState);
+		if (profiled)
+		{
+			mVUqueueProfile(mVU, key);
+			mVUprecompileProfile(mVU);
+		}
 		quick.block      = mVU.prog.cur->block[startPC/8];
 		quick.prog       = mVU.prog.cur;
 		list->push_front(mVU.prog.cur);
@@ -283,8 +587,10 @@ _mVUt __fi void* mVUsearchProg(u32 startPC, uptr pState)
 	}
 
 	// If list.quick, then we've already found and recompiled the program ;)
+	mVU.progIndex.quickHits++;
 	mVU.prog.isSame = -1;
 	mVU.prog.cur = quick.prog;
+	mVUprecompileProfile(mVU);
 	// Because the VU's can now run in sections and not whole programs at once
 	// we need to set the current block so it gets the right program back
 	quick.block = mVU.prog.cur->block[startPC / 8];
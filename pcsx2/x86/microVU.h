@@ -9,6 +9,7 @@
 #include <deque>
 #include <algorithm>
 #include <memory>
+#include <unordered_map>
 #include "Common.h"
 #include "VU.h"
 #include "MTVU.h"
@@ -50,6 +51,7 @@ struct microProgram
 	std::deque<microRange>* ranges;          // The ranges of the microProgram that have already been recompiled
 	u32 startPC; // Start PC of this program
 	int idx;     // Program index
+	u64 key;     // Index key of the micro memory this program was created from
 };
 
 typedef std::deque<microProgram*> microProgramList;
@@ -76,6 +78,49 @@ struct microProgManager
 	microRegInfo       lpState;            // Pipeline state from where program left off (useful for continuing execution)
 };
 
+// Index of programs by the contents of micro memory. Uploads mark the blocks they touch as dirty,
+// and only those blocks are rehashed at the next search, so the memory hash is cheap to keep up
+// to date. A program found through the index is still compared in full before it is used.
+struct microProgIndex
+{
+	static constexpr u32 BlockSize = 64;
+	static constexpr u32 NumBlocks = 0x4000 / BlockSize;
+	static constexpr u32 MaxEntries = 0x10000;
+
+	u64 blockHash[NumBlocks];    // Hash of each block of micro memory
+	u64 dirty[NumBlocks / 64];   // Bitmap of blocks which need rehashing
+	u64 memHash;                 // Combined hash of all blocks
+	std::unordered_map<u64, microProgram*> progs; // (memHash, startPC) -> Program which matched
+
+	// Search statistics, reported and cleared on reset
+	u64 searches;  // Searches for a new program (i.e. quick reference was not valid)
+	u64 quickHits; // Executions which used the quick reference
+	u64 indexHits; // Searches resolved through the hash index
+	u64 listHits;  // Searches resolved by comparing against the program list
+	u64 misses;    // Searches which had to create a new program
+};
+
+// Blocks compiled for each program, kept per game. When a game creates a program from the same
+// micro memory in a later session, the blocks are compiled together up front, instead of one at
+// a time as execution reaches them.
+struct microProgProfile
+{
+	struct Block
+	{
+		u32 startPC;
+		microRegInfo state; // Pipeline state the block was compiled for
+	};
+
+	std::unordered_map<u64, std::unordered_map<u64, Block>> progs; // Program key -> (block key -> block)
+	std::vector<Block> pending;     // Profiled blocks of pendingProg which still need compiling, last one first
+	microProgram* pendingProg;      // Program which was last created with a profile
+	u32 pendingTotal;               // Number of profiled blocks pendingProg started with
+	u32 pendingCompiled;            // Number of those which still needed compiling when their turn came
+	std::string serial;
+	u32 crc;
+	bool dirty;
+};
+
 static const uint mVUcacheSafeZone =  3; // Safe-Zone for program recompilation (in megabytes)
 
 struct microVU
@@ -96,6 +141,8 @@ struct microVU
 	u32 cacheSize;    // VU Cache Size
 
 	microProgManager               prog;     // Micro Program Data
+	microProgIndex                 progIndex;// Micro Program Hash Index
+	microProgProfile               progProfile; // Per-game Micro Program Block Profile
 	microProfiler                  profiler; // Opcode Profiler
 	std::unique_ptr<microRegAlloc> regAlloc; // Reg Alloc Class
 	std::FILE*                     logFile;  // Log File Pointer
@@ -295,6 +342,9 @@ mVUop(mVUopL);
 // Private Functions
 extern void mVUcacheProg(microVU& mVU, microProgram& prog);
 extern void mVUdeleteProg(microVU& mVU, microProgram*& prog);
+extern void mVUmarkBlocksDirty(microVU& mVU, u32 addr, u32 size);
+extern void mVUprintSearchStats(microVU& mVU);
+extern void mVUrecordProfileBlock(microVU& mVU, u32 startPC, uptr pState);
 _mVUt extern void* mVUsearchProg(u32 startPC, uptr pState);
 extern void* mVUexecuteVU0(u32 startPC, u32 cycles);
 extern void* mVUexecuteVU1(u32 startPC, u32 cycles);
@@ -1019,8 +1019,9 @@ __fi void* mVUentryGet(microVU& mVU, microBlockManager* block, u32 startPC, uptr
 	microBlock* pBlock = block->search(mVU, (microRegInfo*)pState);
 	if (pBlock)
 		return pBlock->x86ptrStart;
-	else
-		return mVUcompile(mVU, startPC, pState);
+
+	mVUrecordProfileBlock(mVU, startPC, pState);
+	return mVUcompile(mVU, startPC, pState);
 }
 
 // Search for Existing Compiled Block (if found, return x86ptr; else, compile and return x86ptr)
@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "pcsx2/GS/Renderers/SW/GSRasterizer.h"
+#include "tests/ctest/core/MultiISATest.h"
+
+#include <memory>
+
+MULTI_ISA_UNSHARED_START
+
+// Rasterizers are created per tile, with two tiles per thread, so 99 threads (the most the UI allows) need
+// up to 198 tiles. There can't be more tiles than bands of scanlines though.
+static constexpr int MAX_TEST_TILES = 99 * 2;
+
+static void CheckScanlines(const GSRasterizer& r, int tile, int tiles)
+{
+	const int th = r.GetThreadHeight();
+	for (int band = 0; band < (2048 >> th); band++)
+	{
+		// First and last row of the band.
+		for (const int top : {band << th, ((band + 1) << th) - 1})
+		{
+			ASSERT_EQ(r.IsOneOfMyScanlines(top), (band % tiles) == tile) << "top " << top;
+
+			// The next band this tile owns, which may be past the last band of the screen.
+			const int next = r.FindMyNextScanline(top);
+			const int next_band = next >> th;
+			ASSERT_GE(next, top) << "top " << top;
+			ASSERT_LT(next_band - band, tiles) << "top " << top;
+			ASSERT_EQ(next_band % tiles, tile) << "top " << top;
+			if (next_band == band)
+				ASSERT_EQ(next, top) << "top " << top;
+			else
+				ASSERT_EQ(next, next_band << th) << "top " << top;
+		}
+	}
+}
+
+MULTI_ISA_TEST(GSRasterizer, ScanlineOwnership)
+{
+	SKIP_IF_UNSUPPORTED();
+
+	for (int tiles = 1; tiles <= MAX_TEST_TILES; tiles++)
+	{
+		std::unique_ptr<GSRasterizer> r = std::make_unique<GSRasterizer>(nullptr, 0, tiles);
+		if (tiles > (2048 >> r->GetThreadHeight()))
+			break;
+
+		for (int tile = 0; tile < tiles; tile++)
+		{
+			SCOPED_TRACE(testing::Message() << "tiles " << tiles << " tile " << tile);
+			r->SetTile(tile);
+			CheckScanlines(*r, tile, tiles);
+			if (testing::Test::HasFatalFailure())
+				return;
+		}
+	}
+}
+
+MULTI_ISA_UNSHARED_END
@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "pcsx2/IPU/IPU_IDCT.h"
+#include "tests/ctest/core/MultiISATest.h"
+#include <random>
+
+MULTI_ISA_UNSHARED_START
+
+// The scalar mpeg2dec IDCT, which the vectorised version has to match exactly.
+static void ReferenceButterfly(int& t0, int& t1, int w0, int w1, int d0, int d1)
+{
+	int tmp = w0 * (d0 + d1);
+	t0 = tmp + (w1 - w0) * d1;
+	t1 = tmp - (w1 + w0) * d0;
+}
+
+static void ReferenceIDCT(s16* block)
+{
+	constexpr int W1 = 2841, W2 = 2676, W3 = 2408, W5 = 1609, W6 = 1108, W7 = 565;
+
+	for (int i = 0; i < 8; i++)
+	{
+		s16* const rblock = block + 8 * i;
+		const int d0 = (rblock[0] << 11) + 128;
+		const int d2 = rblock[2] << 11;
+		int t0 = d0 + d2;
+		int t1 = d0 - d2;
+		int t2, t3;
+		ReferenceButterfly(t2, t3, W6, W2, rblock[3], rblock[1]);
+		const int a0 = t0 + t2, a1 = t1 + t3, a2 = t1 - t3, a3 = t0 - t2;
+
+		ReferenceButterfly(t0, t1, W7, W1, rblock[7], rblock[4]);
+		ReferenceButterfly(t2, t3, W3, W5, rblock[5], rblock[6]);
+		const int b0 = t0 + t2, b3 = t1 + t3;
+		t0 -= t2;
+		t1 -= t3;
+		const int b1 = ((t0 + t1) * 181) >> 8;
+		const int b2 = ((t0 - t1) * 181) >> 8;
+
+		rblock[0] = (a0 + b0) >> 8;
+		rblock[1] = (a1 + b1) >> 8;
+		rblock[2] = (a2 + b2) >> 8;
+		rblock[3] = (a3 + b3) >> 8;
+		rblock[4] = (a3 - b3) >> 8;
+		rblock[5] = (a2 - b2) >> 8;
+		rblock[6] = (a1 - b1) >> 8;
+		rblock[7] = (a0 - b0) >> 8;
+	}
+
+	for (int i = 0; i < 8; i++)
+	{
+		s16* const cblock = block + i;
+		const int d0 = (cblock[8 * 0] << 11) + 65536;
+		const int d2 = cblock[8 * 2] << 11;
+		int t0 = d0 + d2;
+		int t1 = d0 - d2;
+		int t2, t3;
+		ReferenceButterfly(t2, t3, W6, W2, cblock[8 * 3], cblock[8 * 1]);
+		const int a0 = t0 + t2, a1 = t1 + t3, a2 = t1 - t3, a3 = t0 - t2;
+
+		ReferenceButterfly(t0, t1, W7, W1, cblock[8 * 7], cblock[8 * 4]);
+		ReferenceButterfly(t2, t3, W3, W5, cblock[8 * 5], cblock[8 * 6]);
+		const int b0 = t0 + t2, b3 = t1 + t3;
+		t0 = (t0 - t2) >> 8;
+		t1 = (t1 - t3) >> 8;
+		const int b1 = (t0 + t1) * 181;
+		const int b2 = (t0 - t1) * 181;
+
+		cblock[8 * 0] = (a0 + b0) >> 17;
+		cblock[8 * 1] = (a1 + b1) >> 17;
+		cblock[8 * 2] = (a2 + b2) >> 17;
+		cblock[8 * 3] = (a3 + b3) >> 17;
+		cblock[8 * 4] = (a3 - b3) >> 17;
+		cblock[8 * 5] = (a2 - b2) >> 17;
+		cblock[8 * 6] = (a1 - b1) >> 17;
+		cblock[8 * 7] = (a0 - b0) >> 17;
+	}
+}
+
+static void RunIDCTTest(int min_coeff, int max_coeff, int max_nonzero)
+{
+	std::mt19937 rng(static_cast<unsigned>(max_coeff * 64 + max_nonzero));
+	std::uniform_int_distribution<int> coeff(min_coeff, max_coeff);
+	std::uniform_int_distribution<int> position(0, 63);
+	std::uniform_int_distribution<int> count(1, max_nonzero);
+
+	for (int iter = 0; iter < 20000; iter++)
+	{
+		alignas(16) s16 expected[64] = {};
+		for (int i = count(rng); i > 0; i--)
+			expected[position(rng)] = static_cast<s16>(coeff(rng));
+
+		alignas(16) s16 actual[64];
+		std::memcpy(actual, expected, sizeof(actual));
+
+		ReferenceIDCT(expected);
+		IDCT_Block(actual);
+
+		for (int i = 0; i < 64; i++)
+			ASSERT_EQ(actual[i], expected[i]) << "coefficient " << i << " iteration " << iter;
+	}
+}
+
+MULTI_ISA_TEST(IPUIDCT, SparseBlocksMatchReference)
+{
+	SKIP_IF_UNSUPPORTED();
+	RunIDCTTest(-2048, 2047, 4);
+}
+
+MULTI_ISA_TEST(IPUIDCT, DenseBlocksMatchReference)
+{
+	SKIP_IF_UNSUPPORTED();
+	RunIDCTTest(-2048, 2047, 64);
+}
+
+MULTI_ISA_TEST(IPUIDCT, FullRangeBlocksMatchReference)
+{
+	SKIP_IF_UNSUPPORTED();
+	RunIDCTTest(-32768, 32767, 64);
+}
+
+MULTI_ISA_UNSHARED_END
@@ -0,0 +1,389 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "pcsx2/SPU2/VoiceBatch.h"
+#include "pcsx2/SPU2/interpolate_table.h"
+#include "tests/ctest/core/MultiISATest.h"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+MULTI_ISA_UNSHARED_START
+
+// Per-voice mixing as done by MixVoice() and MixCoreVoices(), which the batch has to match exactly.
+static void MixVoicesReference(const V_VoiceBatch& batch, s32 noise, s32* out, VoiceMixSet& dest)
+{
+	for (uint i = 0; i < V_VoiceBatch::NumVoices; i++)
+	{
+		s32 value = 0;
+		if (batch.ActiveMask[i])
+		{
+			if (batch.NoiseMask[i])
+			{
+				value = noise;
+			}
+			else
+			{
+				for (uint tap = 0; tap < 4; tap++)
+					value += (batch.Interp[tap][i] * batch.Samples[tap][i]) >> 15;
+			}
+
+			value = (batch.Envelope[i] * value) >> 15;
+		}
+
+		out[i] = value;
+
+		const s32 left = (batch.VolumeL[i] * value) >> 15;
+		const s32 right = (batch.VolumeR[i] * value) >> 15;
+		dest.Dry.Left += left & batch.DryL[i];
+		dest.Dry.Right += right & batch.DryR[i];
+		dest.Wet.Left += left & batch.WetL[i];
+		dest.Wet.Right += right & batch.WetR[i];
+	}
+}
+
+static void FillBatch(V_VoiceBatch& batch, std::mt19937& rng, bool extremes)
+{
+	std::uniform_int_distribution<s32> sample(-0x8000, 0x7fff);
+	std::uniform_int_distribution<s32> level(0, 0x7fff);
+	std::uniform_int_distribution<s32> volume(-0x8000, 0x7fff);
+	std::uniform_int_distribution<int> phase(0, 255);
+	std::uniform_int_distribution<int> coin(0, 3);
+
+	for (uint i = 0; i < V_VoiceBatch::NumVoices; i++)
+	{
+		const int p = phase(rng);
+		for (uint tap = 0; tap < 4; tap++)
+		{
+			batch.Samples[tap][i] = extremes ? ((coin(rng) & 1) ? 0x7fff : -0x8000) : sample(rng);
+			batch.Interp[tap][i] = interpTable[p][tap];
+		}
+
+		batch.NoiseMask[i] = (coin(rng) == 0) ? -1 : 0;
+		batch.ActiveMask[i] = (coin(rng) != 0) ? -1 : 0;
+		batch.Envelope[i] = extremes ? 0x7fff : level(rng);
+		batch.VolumeL[i] = extremes ? -0x8000 : volume(rng);
+		batch.VolumeR[i] = extremes ? 0x7fff : volume(rng);
+		batch.DryL[i] = (coin(rng) & 1) ? -1 : 0;
+		batch.DryR[i] = (coin(rng) & 1) ? -1 : 0;
+		batch.WetL[i] = (coin(rng) & 1) ? -1 : 0;
+		batch.WetR[i] = (coin(rng) & 1) ? -1 : 0;
+	}
+}
+
+static void RunMixerTest(bool extremes)
+{
+	std::mt19937 rng(extremes ? 4321 : 1234);
+	std::uniform_int_distribution<s32> noise(-0x8000, 0x7fff);
+
+	for (int iter = 0; iter < 10000; iter++)
+	{
+		alignas(32) V_VoiceBatch batch;
+		FillBatch(batch, rng, extremes);
+		const s32 noise_value = noise(rng);
+
+		s32 expected_out[V_VoiceBatch::NumVoices];
+		VoiceMixSet expected(StereoOut32(0, 0), StereoOut32(0, 0));
+		MixVoicesReference(batch, noise_value, expected_out, expected);
+
+		VoiceMixSet actual(StereoOut32(0, 0), StereoOut32(0, 0));
+		MixVoiceBatch(batch, noise_value, actual);
+
+		for (uint i = 0; i < V_VoiceBatch::NumVoices; i++)
+			ASSERT_EQ(batch.Out[i], expected_out[i]) << "voice " << i << " iteration " << iter;
+
+		ASSERT_EQ(actual.Dry.Left, expected.Dry.Left) << "iteration " << iter;
+		ASSERT_EQ(actual.Dry.Right, expected.Dry.Right) << "iteration " << iter;
+		ASSERT_EQ(actual.Wet.Left, expected.Wet.Left) << "iteration " << iter;
+		ASSERT_EQ(actual.Wet.Right, expected.Wet.Right) << "iteration " << iter;
+	}
+}
+
+MULTI_ISA_TEST(SPU2Mixer, VoiceBatchMatchesReference)
+{
+	SKIP_IF_UNSUPPORTED();
+	RunMixerTest(false);
+}
+
+MULTI_ISA_TEST(SPU2Mixer, VoiceBatchMatchesReferenceAtExtremes)
+{
+	SKIP_IF_UNSUPPORTED();
+	RunMixerTest(true);
+}
+
+// Voices only read from the bottom of SPU2 RAM, so only that much has to be saved and restored between the two paths.
+static constexpr u32 CORE_TEST_MEM_WORDS = 0x8000;
+static constexpr u32 CORE_TEST_SAMPLES = 2000;
+
+struct MixerCoreState
+{
+	V_Core core;
+	std::vector<s16> mem;
+	std::vector<PcmCacheEntry> cache;
+
+	void Save(uint coreidx)
+	{
+		core = Cores[coreidx];
+		mem.assign(_spu2mem, _spu2mem + CORE_TEST_MEM_WORDS);
+		cache.assign(pcm_cache_data, pcm_cache_data + CORE_TEST_MEM_WORDS / pcm_WordsPerBlock);
+	}
+
+	void Restore(uint coreidx) const
+	{
+		Cores[coreidx] = core;
+		std::copy(mem.begin(), mem.end(), _spu2mem);
+		std::copy(cache.begin(), cache.end(), pcm_cache_data);
+	}
+};
+
+static void FillSPU2Memory(std::mt19937& rng)
+{
+	std::uniform_int_distribution<int> word(-0x8000, 0x7fff);
+	std::uniform_int_distribution<int> filter(0, 4);
+	std::uniform_int_distribution<int> shift(0, 12);
+	std::uniform_int_distribution<int> flags(0, 31);
+
+	for (u32 i = 0; i < CORE_TEST_MEM_WORDS; i++)
+	{
+		// Mostly plain blocks, with the occasional loop start, loop end and stop.
+		if ((i % pcm_WordsPerBlock) == 0)
+		{
+			const int f = flags(rng);
+			const int loop_flags = (f < 4) ? f * 2 + 1 : (f < 8) ? 4 : 0;
+			_spu2mem[i] = static_cast<s16>((loop_flags << 8) | (filter(rng) << 4) | shift(rng));
+		}
+		else
+		{
+			_spu2mem[i] = static_cast<s16>(word(rng));
+		}
+	}
+
+	std::memset(pcm_cache_data, 0, sizeof(pcm_cache_data));
+}
+
+static void RandomizeVoice(V_Core& core, uint voiceidx, std::mt19937& rng)
+{
+	std::uniform_int_distribution<int> coin(0, 7);
+	std::uniform_int_distribution<int> sample(-0x8000, 0x7fff);
+	std::uniform_int_distribution<u32> bits;
+	std::uniform_int_distribution<u32> block(SPU2_DYN_MEMLINE / pcm_WordsPerBlock, (CORE_TEST_MEM_WORDS - 0x1000) / pcm_WordsPerBlock);
+	std::uniform_int_distribution<u32> capture_block(0, 0x200 / pcm_WordsPerBlock - 1);
+
+	V_Voice& vc = core.Voices[voiceidx];
+	vc.Volume.Left.Reg_VOL = static_cast<u16>(bits(rng));
+	vc.Volume.Left.Counter = bits(rng) & 0xffff;
+	vc.Volume.Left.Value = sample(rng);
+	vc.Volume.Right.Reg_VOL = static_cast<u16>(bits(rng));
+	vc.Volume.Right.Counter = bits(rng) & 0xffff;
+	vc.Volume.Right.Value = sample(rng);
+
+	vc.ADSR.reg32 = bits(rng);
+	vc.ADSR.UpdateCache();
+	vc.ADSR.Phase = static_cast<u8>(bits(rng) % V_ADSR::ADSR_PHASES);
+	vc.ADSR.Value = (vc.ADSR.Phase == V_ADSR::PHASE_STOPPED) ? 0 : static_cast<s32>(bits(rng) & 0x7fff);
+	vc.ADSR.Counter = bits(rng) & 0xffff;
+
+	// Now and then, read from the voice 1 and 3 capture buffers, in the dynamic area. Only voices 0 and 1 can do
+	// that without the core falling back to the serial path, so those do it more often.
+	static constexpr u32 capture_buffers[] = {0x400, 0x600, 0xc00, 0xe00};
+	vc.Pitch = static_cast<u16>(bits(rng) & 0x3fff);
+	vc.LoopStartA = block(rng) * pcm_WordsPerBlock;
+	vc.StartA = vc.LoopStartA;
+	const bool dyn = (voiceidx < 2) ? (coin(rng) < 2) : ((bits(rng) % 256) == 0);
+	const u32 start = dyn ? (capture_buffers[bits(rng) % 4] + capture_block(rng) * pcm_WordsPerBlock) : (block(rng) * pcm_WordsPerBlock);
+	vc.NextA = start + 1 + (bits(rng) % 7);
+	vc.Prev1 = sample(rng);
+	vc.Prev2 = sample(rng);
+	vc.Modulated = (coin(rng) < 2);
+	vc.Noise = (coin(rng) == 0);
+	vc.LoopMode = static_cast<s8>(coin(rng) & 1);
+	vc.LoopFlags = 0;
+	vc.SP = static_cast<s32>(bits(rng) & 0x3fff);
+	vc.OutX = sample(rng);
+	vc.SBuffer = nullptr;
+	for (s32& value : vc.DecodeFifo)
+		value = sample(rng);
+	vc.DecPosRead = bits(rng);
+	vc.DecPosWrite = vc.DecPosRead + (bits(rng) % 16);
+
+	core.VoiceGates[voiceidx].DryL = (coin(rng) & 1) ? -1 : 0;
+	core.VoiceGates[voiceidx].DryR = (coin(rng) & 1) ? -1 : 0;
+	core.VoiceGates[voiceidx].WetL = (coin(rng) & 1) ? -1 : 0;
+	core.VoiceGates[voiceidx].WetR = (coin(rng) & 1) ? -1 : 0;
+}
+
+static void CompareVoiceMix(const VoiceMixSet& expected, const VoiceMixSet& actual)
+{
+	EXPECT_EQ(actual.Dry.Left, expected.Dry.Left);
+	EXPECT_EQ(actual.Dry.Right, expected.Dry.Right);
+	EXPECT_EQ(actual.Wet.Left, expected.Wet.Left);
+	EXPECT_EQ(actual.Wet.Right, expected.Wet.Right);
+}
+
+static void CompareCoreState(const MixerCoreState& expected, const MixerCoreState& actual)
+{
+	EXPECT_EQ(actual.core.Regs.ENDX, expected.core.Regs.ENDX);
+
+	for (uint i = 0; i < V_Core::NumVoices; i++)
+	{
+		SCOPED_TRACE(testing::Message() << "voice " << i);
+		const V_Voice& e = expected.core.Voices[i];
+		const V_Voice& a = actual.core.Voices[i];
+		EXPECT_EQ(a.Volume.Left.Value, e.Volume.Left.Value);
+		EXPECT_EQ(a.Volume.Left.Counter, e.Volume.Left.Counter);
+		EXPECT_EQ(a.Volume.Right.Value, e.Volume.Right.Value);
+		EXPECT_EQ(a.Volume.Right.Counter, e.Volume.Right.Counter);
+		EXPECT_EQ(a.ADSR.Value, e.ADSR.Value);
+		EXPECT_EQ(a.ADSR.Counter, e.ADSR.Counter);
+		EXPECT_EQ(a.ADSR.Phase, e.ADSR.Phase);
+		EXPECT_EQ(a.LoopStartA, e.LoopStartA);
+		EXPECT_EQ(a.NextA, e.NextA);
+		EXPECT_EQ(a.Prev1, e.Prev1);
+		EXPECT_EQ(a.Prev2, e.Prev2);
+		EXPECT_EQ(a.LoopFlags, e.LoopFlags);
+		EXPECT_EQ(a.SP, e.SP);
+		EXPECT_EQ(a.OutX, e.OutX);
+		EXPECT_EQ(a.SBuffer, e.SBuffer);
+		EXPECT_EQ(a.DecPosWrite, e.DecPosWrite);
+		EXPECT_EQ(a.DecPosRead, e.DecPosRead);
+		EXPECT_TRUE(std::equal(std::begin(a.DecodeFifo), std::end(a.DecodeFifo), std::begin(e.DecodeFifo)));
+	}
+
+	// Includes the voice 1 and 3 capture buffers.
+	EXPECT_TRUE(expected.mem == actual.mem);
+}
+
+static void RunCoreVoicesTest(uint coreidx, u32 seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> respawn(0, 63);
+
+	FillSPU2Memory(rng);
+
+	// IRQs go through the IOP, which isn't running.
+	for (uint i = 0; i < 2; i++)
+	{
+		Cores[i].IRQEnable = false;
+		Cores[i].Regs.ENDX = 0;
+	}
+
+	V_Core& core = Cores[coreidx];
+	core.NoiseOut = std::uniform_int_distribution<u32>()(rng);
+	for (uint i = 0; i < V_Core::NumVoices; i++)
+		RandomizeVoice(core, i, rng);
+
+	u32 batched_samples = 0;
+	u32 serial_samples = 0;
+	MixerCoreState before, serial, batched;
+	for (u32 sample = 0; sample < CORE_TEST_SAMPLES; sample++)
+	{
+		SCOPED_TRACE(testing::Message() << "sample " << sample);
+
+		OutPos = static_cast<u16>(sample & 0x1ff);
+		core.NoiseOut = (core.NoiseOut << 1) | (sample & 1);
+
+		// Keep some voices playing, since the random blocks stop them now and then.
+		for (uint i = 0; i < V_Core::NumVoices; i++)
+		{
+			if (respawn(rng) == 0)
+				RandomizeVoice(core, i, rng);
+		}
+
+		if (!CanMixCoreVoicesBatched(core))
+		{
+			VoiceMixSet out(StereoOut32(0, 0), StereoOut32(0, 0));
+			MixCoreVoicesSerial(out, coreidx);
+			serial_samples++;
+			continue;
+		}
+
+		before.Save(coreidx);
+
+		VoiceMixSet expected(StereoOut32(0, 0), StereoOut32(0, 0));
+		MixCoreVoicesSerial(expected, coreidx);
+		serial.Save(coreidx);
+
+		before.Restore(coreidx);
+		VoiceMixSet actual(StereoOut32(0, 0), StereoOut32(0, 0));
+		MixCoreVoicesBatched(actual, coreidx);
+		batched.Save(coreidx);
+		batched_samples++;
+
+		CompareVoiceMix(expected, actual);
+		CompareCoreState(serial, batched);
+		if (testing::Test::HasFailure())
+			return;
+	}
+
+	// Both the batched path and the fallback should have been exercised.
+	EXPECT_GT(batched_samples, CORE_TEST_SAMPLES / 4);
+	EXPECT_GT(serial_samples, 0u);
+}
+
+MULTI_ISA_TEST(SPU2Mixer, CoreFallsBackWhenReadingCaptureBuffer)
+{
+	SKIP_IF_UNSUPPORTED();
+
+	std::mt19937 rng(3333);
+	FillSPU2Memory(rng);
+
+	V_Core& core = Cores[0];
+	core.IRQEnable = false;
+	Cores[1].IRQEnable = false;
+	for (uint i = 0; i < V_Core::NumVoices; i++)
+	{
+		RandomizeVoice(core, i, rng);
+		core.Voices[i].NextA = SPU2_DYN_MEMLINE + 1;
+	}
+
+	// Voice 1 outputs noise, which gets written to 0x400 + OutPos, the samples voice 2 is about to decode.
+	// The serial path decodes the new value, the batched path would decode the old one.
+	OutPos = 0x11;
+	core.NoiseOut = 0x1234;
+	_spu2mem[0x410] = 0;
+	_spu2mem[0x400 + OutPos] = 0;
+
+	V_Voice& writer = core.Voices[1];
+	writer.Noise = true;
+	writer.ADSR.Phase = V_ADSR::PHASE_SUSTAIN;
+	writer.ADSR.Value = 0x7fff;
+
+	V_Voice& reader = core.Voices[2];
+	reader.NextA = 0x411;
+	reader.SBuffer = nullptr;
+	reader.DecPosWrite = reader.DecPosRead;
+	reader.ADSR.Phase = V_ADSR::PHASE_SUSTAIN;
+
+	ASSERT_FALSE(CanMixCoreVoicesBatched(core));
+
+	MixerCoreState before, serial, batched;
+	before.Save(0);
+
+	VoiceMixSet out(StereoOut32(0, 0), StereoOut32(0, 0));
+	MixCoreVoicesSerial(out, 0);
+	serial.Save(0);
+	ASSERT_NE(serial.mem[0x400 + OutPos], 0);
+
+	before.Restore(0);
+	MixCoreVoicesBatched(out, 0);
+	batched.Save(0);
+
+	const s32* serial_fifo = serial.core.Voices[2].DecodeFifo;
+	const s32* batched_fifo = batched.core.Voices[2].DecodeFifo;
+	EXPECT_FALSE(std::equal(serial_fifo, serial_fifo + 32, batched_fifo));
+}
+
+MULTI_ISA_TEST(SPU2Mixer, BatchedCoreMatchesSerialCore0)
+{
+	SKIP_IF_UNSUPPORTED();
+	RunCoreVoicesTest(0, 1111);
+}
+
+MULTI_ISA_TEST(SPU2Mixer, BatchedCoreMatchesSerialCore1)
+{
+	SKIP_IF_UNSUPPORTED();
+	RunCoreVoicesTest(1, 2222);
+}
+
+MULTI_ISA_UNSHARED_END